@@ -20,13 +20,20 @@ set(sources ${sources}
 	src/event/sink_event.h
 	src/handle/ammo_handle.cpp
 	src/handle/ammo_handle.h
+	src/handle/ammo_index.cpp
+	src/handle/ammo_index.h
 	src/handle/data/ammo_data.h
 	src/handle/data/data_helper.h
+	src/handle/data/page/page_snapshot.h
 	src/handle/data/page/position_draw_setting.h
 	src/handle/data/page/position_setting.h
 	src/handle/data/page/slot_setting.h
+	src/handle/equip_state_handle.cpp
+	src/handle/equip_state_handle.h
 	src/handle/extra_data_holder.cpp
 	src/handle/extra_data_holder.h
+	src/handle/item_count_handle.cpp
+	src/handle/item_count_handle.h
 	src/handle/key_position_handle.cpp
 	src/handle/key_position_handle.h
 	src/handle/name_handle.cpp
@@ -42,31 +49,53 @@ set(sources ${sources}
 	src/main.cpp
 	src/papyrus/papyrus.cpp
 	src/papyrus/papyrus.h
+	src/processing/action_queue.cpp
+	src/processing/action_queue.h
+	src/processing/cycle_commit.cpp
+	src/processing/cycle_commit.h
+	src/processing/equip_latency.cpp
+	src/processing/equip_latency.h
 	src/processing/game_menu_setting.cpp
 	src/processing/game_menu_setting.h
 	src/processing/set_setting_data.cpp
 	src/processing/set_setting_data.h
 	src/processing/setting_execute.cpp
 	src/processing/setting_execute.h
+	src/serialization/serialization.cpp
+	src/serialization/serialization.h
 	src/setting/custom_setting.cpp
 	src/setting/custom_setting.h
 	src/setting/file_setting.cpp
 	src/setting/file_setting.h
 	src/setting/mcm_setting.cpp
 	src/setting/mcm_setting.h
+	src/setting/setting_watcher.cpp
+	src/setting/setting_watcher.h
 	src/ui/animation_handler.h
+	src/ui/hud_model.cpp
+	src/ui/hud_model.h
 	src/ui/image_path.h
 	src/ui/key_path.h
 	src/ui/ui_renderer.cpp
 	src/ui/ui_renderer.h
 	src/util/constant.h
-	src/util/data/config_writer_helper.h
+	src/util/form_cache.cpp
+	src/util/form_cache.h
 	src/util/helper.cpp
 	src/util/helper.h
+	src/util/memory_stats.cpp
+	src/util/memory_stats.h
 	src/util/offset.h
+	src/util/page_key.h
 	src/util/player/perk_visitor.cpp
 	src/util/player/perk_visitor.h
 	src/util/player/player.cpp
 	src/util/player/player.h
+	src/util/ring_buffer_sink.cpp
+	src/util/ring_buffer_sink.h
+	src/util/spsc_queue.h
 	src/util/string_util.h
+	src/util/trace_recorder.cpp
+	src/util/trace_recorder.h
+	src/util/triple_buffer.h
 )
@@ -9,10 +9,16 @@ SOURCE_TYPES = (
     ".hxx",
 )
 
+# built as a library of its own, without the PCH
+EXCLUDED_DIRECTORIES = (
+    os.path.join("src", "core"),
+)
+
 def make_cmake(a_directories, p_name, p_first):
     tmp = []
     for directory in a_directories:
         for root, dirs, files in os.walk(directory):
+            dirs[:] = [d for d in dirs if os.path.join(root, d) not in EXCLUDED_DIRECTORIES]
             for file in files:
                 if file.endswith(SOURCE_TYPES):
                     path = os.path.join(root, file)
@@ -12,6 +12,7 @@
 #include <SimpleIni.h>
 #include <algorithm>
 #include <cctype>
+#include <condition_variable>
 #include <d3d11.h>
 #include <dxgi.h>
 #include <imgui.h>
@@ -19,6 +20,7 @@
 #include <imgui_impl_win32.h>
 #include <imgui_internal.h>
 #include <locale>
+#include <thread>
 #include <windows.h>
 #include <winuser.h>
 
@@ -38,4 +40,25 @@ namespace stl {
 
 #define EXTERN_C extern "C"
 
+//trace and debug are all over the input and equip paths. the arguments are only evaluated if the line gets written,
+//with HUD_DISABLE_DEBUG_LOG they are not compiled in at all but still checked, so no variable ends up unused
+#ifdef HUD_DISABLE_DEBUG_LOG
+#define HUD_LOG_IF(a_level, a_log, ...) \
+    do {                                \
+        if constexpr (false) {          \
+            a_log(__VA_ARGS__);         \
+        }                               \
+    } while (false)
+#else
+#define HUD_LOG_IF(a_level, a_log, ...)                          \
+    do {                                                         \
+        if (spdlog::default_logger_raw()->should_log(a_level)) { \
+            a_log(__VA_ARGS__);                                  \
+        }                                                        \
+    } while (false)
+#endif
+
+#define LOG_TRACE(...) HUD_LOG_IF(spdlog::level::trace, logger::trace, __VA_ARGS__)
+#define LOG_DEBUG(...) HUD_LOG_IF(spdlog::level::debug, logger::debug, __VA_ARGS__)
+
 #include "Version.h"
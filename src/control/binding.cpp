@@ -1,6 +1,7 @@
 #include "binding.h"
 #include "control/common.h"
 #include "setting/mcm_setting.h"
+#include "util/trace_recorder.h"
 
 namespace control {
 
@@ -16,7 +17,6 @@ namespace control {
     uint32_t binding::get_bottom_action() const { return key_bottom_action_; }
     uint32_t binding::get_left_action() const { return key_left_action_; }
     uint32_t binding::get_bottom_execute_or_toggle_action() const { return key_bottom_execute_or_toggle_; }
-    uint32_t binding::get_top_execute() const { return key_top_execute_; }
     uint32_t binding::get_hide_show() const { return key_hide_show_; }
     uint32_t binding::get_edit_key() const { return key_edit_key_; }
     uint32_t binding::get_edit_key_left_or_overwrite() const { return key_edit_left_or_overwrite_; }
@@ -32,42 +32,92 @@ namespace control {
         key_edit_key_ = config::mcm_setting::get_edit_key();
         key_edit_left_or_overwrite_ = config::mcm_setting::get_left_or_overwrite_edit_key();
         key_remove_key_ = config::mcm_setting::get_remove_key();
+
+        elden_ = config::mcm_setting::get_elden_demon_souls();
+        bottom_execute_key_combo_only_ = config::mcm_setting::get_bottom_execute_key_combo_only();
+        keys_configured_ = common::is_key_valid(key_top_action_) && common::is_key_valid(key_right_action_) &&
+                           common::is_key_valid(key_bottom_action_) && common::is_key_valid(key_left_action_) &&
+                           common::is_key_valid(key_bottom_execute_or_toggle_);
+
+        set_top_execute();
+    }
+
+    void binding::set_top_execute() {
+        keys_top_execute_.fill(common::k_invalid);
+        const auto* control_map = RE::ControlMap::GetSingleton();
+        const auto* user_events = RE::UserEvents::GetSingleton();
+        if (control_map && user_events) {
+            constexpr std::array devices = { RE::INPUT_DEVICE::kKeyboard,
+                RE::INPUT_DEVICE::kMouse,
+                RE::INPUT_DEVICE::kGamepad };
+            for (auto i = 0; i < static_cast<int>(devices.size()); ++i) {
+                if (const auto key = control_map->GetMappedKey(user_events->shout, devices[i]);
+                    key != RE::ControlMap::kInvalid) {
+                    keys_top_execute_[i] = common::get_key_id(devices[i], key);
+                }
+            }
+        }
+        build_dispatch();
+    }
+
+    const binding::key_dispatch& binding::get_dispatch(const uint32_t a_key) const {
+        return dispatch_.get(a_key);
+    }
+
+    bool binding::is_position_button(const uint32_t a_key) const {
+        return get_dispatch(a_key).roles & key_role::position_button;
     }
 
-    void binding::set_top_execute(uint32_t a_key) { key_top_execute_ = a_key; }
+    bool binding::keys_configured() const { return keys_configured_; }
 
-    bool binding::is_position_button(uint32_t a_key) const {
-        if (a_key == key_top_action_ || a_key == key_right_action_ || a_key == key_bottom_action_ ||
-            a_key == key_left_action_) {
-            return true;
+    void binding::trace_dispatch() const {
+        const auto* recorder = util::trace_recorder::get_singleton();
+        if (!recorder->is_active()) {
+            return;
+        }
+        for (uint32_t key = 0; key < common::k_total; ++key) {
+            if (const auto& dispatch = dispatch_.get(key); dispatch.roles != key_role::none) {
+                recorder->record_binding(key, dispatch.roles, dispatch.position);
+            }
         }
-        return false;
     }
 
-    bool binding::keys_configured() const {
-        if (!control::common::is_key_valid(key_top_action_) || !control::common::is_key_valid(key_right_action_) ||
-            !control::common::is_key_valid(key_bottom_action_) || !control::common::is_key_valid(key_left_action_) ||
-            !control::common::is_key_valid(key_bottom_execute_or_toggle_)) {
-            return false;
+    bool binding::get_elden() const { return elden_; }
+
+    bool binding::get_bottom_execute_key_combo_only() const { return bottom_execute_key_combo_only_; }
+
+    void binding::build_dispatch() {
+        dispatch_.clear();
+        dispatch_.add(key_top_action_, key_role::position_button | key_role::scroll, position_type::top);
+        dispatch_.add(key_right_action_, key_role::position_button, position_type::right);
+        dispatch_.add(key_bottom_action_,
+            key_role::position_button | key_role::scroll | key_role::utility,
+            position_type::bottom);
+        dispatch_.add(key_left_action_, key_role::position_button, position_type::left);
+        dispatch_.add(key_bottom_execute_or_toggle_, key_role::toggle);
+        dispatch_.add(key_hide_show_, key_role::hide_show);
+        for (const auto key : keys_top_execute_) {
+            dispatch_.add(key, key_role::top_execute);
         }
-        return true;
+        LOG_TRACE("built key dispatch, elden {}, keys configured {}"sv, elden_, keys_configured_);
+        trace_dispatch();
     }
 
     bool binding::get_is_edit_down() const { return is_edit_down_; }
     void binding::set_is_edit_down(bool a_down) {
-        logger::trace("setting toggle down to {}", a_down);
+        LOG_TRACE("setting toggle down to {}", a_down);
         is_edit_down_ = a_down;
     }
 
     bool binding::get_is_edit_left_down() const { return is_edit_left_down_; }
     void binding::set_is_edit_left_down(bool a_down) {
-        logger::trace("setting left down to {}", a_down);
+        LOG_TRACE("setting left down to {}", a_down);
         is_edit_left_down_ = a_down;
     }
 
     bool binding::get_is_remove_down() const { return is_remove_down_; }
     void binding::set_is_remove_down(bool a_down) {
-        logger::trace("setting remove down to {}", a_down);
+        LOG_TRACE("setting remove down to {}", a_down);
         is_remove_down_ = a_down;
     }
 }  // control
@@ -1,9 +1,16 @@
 #pragma once
 #include "control/common.h"
+#include "core/key_table.h"
+#include "handle/data/page/position_setting.h"
 
 namespace control {
     class binding {
     public:
+        using position_type = handle::position_setting::position_type;
+
+        using key_role = core::key_table::key_role;
+        using key_dispatch = core::key_table::key_dispatch;
+
         [[nodiscard]] static binding* get_singleton();
 
         [[nodiscard]] uint32_t get_top_action() const;
@@ -11,17 +18,24 @@ namespace control {
         [[nodiscard]] uint32_t get_bottom_action() const;
         [[nodiscard]] uint32_t get_left_action() const;
         [[nodiscard]] uint32_t get_bottom_execute_or_toggle_action() const;
-        [[nodiscard]] uint32_t get_top_execute() const;
         [[nodiscard]] uint32_t get_hide_show() const;
         [[nodiscard]] uint32_t get_edit_key() const;
         [[nodiscard]] uint32_t get_edit_key_left_or_overwrite() const;
         [[nodiscard]] uint32_t get_remove_key() const;
 
-        void set_all_keys();  //except top_execute
-        void set_top_execute(uint32_t a_key);
+        void set_all_keys();
+        //the shout key can be changed in the game controls, so it is looked up again on its own
+        void set_top_execute();
 
+        //the normalized key id from common::get_key_id, unknown keys get an entry without roles
+        [[nodiscard]] const key_dispatch& get_dispatch(uint32_t a_key) const;
         [[nodiscard]] bool is_position_button(uint32_t a_key) const;
         [[nodiscard]] bool keys_configured() const;
+        //writes the table into the trace, the replay needs it before the first key
+        void trace_dispatch() const;
+        //mcm values the input handling needs, they only change together with the keys
+        [[nodiscard]] bool get_elden() const;
+        [[nodiscard]] bool get_bottom_execute_key_combo_only() const;
 
         [[nodiscard]] bool get_is_edit_down() const;
         void set_is_edit_down(bool a_down);
@@ -41,16 +55,26 @@ namespace control {
         binding();
         ~binding() = default;
 
+        void build_dispatch();
+
         uint32_t key_top_action_ = control::common::k_invalid;
         uint32_t key_right_action_ = control::common::k_invalid;
         uint32_t key_bottom_action_ = control::common::k_invalid;
         uint32_t key_left_action_ = control::common::k_invalid;
         uint32_t key_bottom_execute_or_toggle_ = control::common::k_invalid;
-        uint32_t key_top_execute_ = control::common::k_invalid;
         uint32_t key_hide_show_ = control::common::k_invalid;
         uint32_t key_edit_key_ = control::common::k_invalid;
         uint32_t key_edit_left_or_overwrite_ = control::common::k_invalid;
         uint32_t key_remove_key_ = control::common::k_invalid;
+        //shout key per device, keyboard, mouse, gamepad
+        std::array<uint32_t, 3> keys_top_execute_ = { control::common::k_invalid,
+            control::common::k_invalid,
+            control::common::k_invalid };
+
+        core::key_table dispatch_;
+        bool keys_configured_ = false;
+        bool elden_ = false;
+        bool bottom_execute_key_combo_only_ = false;
 
         bool is_edit_down_ = false;
         bool is_edit_left_down_ = false;
@@ -1,17 +1,37 @@
 #include "common.h"
 
 namespace control {
+    using gamepad_key = RE::BSWin32GamepadDevice::Key;
+
+    //the core has its own copy of the masks, it is built without CommonLib
+    static constexpr bool is_same_button(const uint32_t a_button, const gamepad_key a_key) {
+        return a_button == static_cast<uint32_t>(a_key);
+    }
+
+    static_assert(is_same_button(core::gamepad_up, gamepad_key::kUp));
+    static_assert(is_same_button(core::gamepad_start, gamepad_key::kStart));
+    static_assert(is_same_button(core::gamepad_right_shoulder, gamepad_key::kRightShoulder));
+    static_assert(is_same_button(core::gamepad_a, gamepad_key::kA));
+    static_assert(is_same_button(core::gamepad_y, gamepad_key::kY));
+    static_assert(is_same_button(core::gamepad_left_trigger, gamepad_key::kLeftTrigger));
+    static_assert(is_same_button(core::gamepad_right_trigger, gamepad_key::kRightTrigger));
+
     void common::get_key_id(const RE::ButtonEvent* a_button, uint32_t& a_key) {
-        switch (a_button->device.get()) {
+        a_key = get_key_id(a_button->device.get(), a_key);
+    }
+
+    uint32_t common::get_key_id(const RE::INPUT_DEVICE a_device, const uint32_t a_key) {
+        return core::get_key_id(get_device(a_device), a_key);
+    }
+
+    core::input_device common::get_device(const RE::INPUT_DEVICE a_device) {
+        switch (a_device) {
             case RE::INPUT_DEVICE::kMouse:
-                a_key += k_mouse_offset;
-                break;
+                return core::input_device::mouse;
             case RE::INPUT_DEVICE::kKeyboard:
-                a_key += k_keyboard_offset;
-                break;
+                return core::input_device::keyboard;
             case RE::INPUT_DEVICE::kGamepad:
-                a_key = get_gamepad_index(static_cast<RE::BSWin32GamepadDevice::Key>(a_key));
-                break;
+                return core::input_device::gamepad;
             case RE::INPUT_DEVICE::kNone:
             case RE::INPUT_DEVICE::kVirtualKeyboard:
             case RE::INPUT_DEVICE::kVRRight:
@@ -19,6 +39,7 @@ namespace control {
             case RE::INPUT_DEVICE::kTotal:
                 break;
         }
+        return core::input_device::other;
     }
 
     bool common::is_key_valid(uint32_t a_key) {
@@ -34,65 +55,4 @@ namespace control {
         }
         return false;
     }
-
-    uint32_t common::get_gamepad_index(const RE::BSWin32GamepadDevice::Key a_key) {
-        using key = RE::BSWin32GamepadDevice::Key;
-
-        uint32_t index;
-        switch (a_key) {
-            case key::kUp:
-                index = 0;
-                break;
-            case key::kDown:
-                index = 1;
-                break;
-            case key::kLeft:
-                index = 2;
-                break;
-            case key::kRight:
-                index = 3;
-                break;
-            case key::kStart:
-                index = 4;
-                break;
-            case key::kBack:
-                index = 5;
-                break;
-            case key::kLeftThumb:
-                index = 6;
-                break;
-            case key::kRightThumb:
-                index = 7;
-                break;
-            case key::kLeftShoulder:
-                index = 8;
-                break;
-            case key::kRightShoulder:
-                index = 9;
-                break;
-            case key::kA:
-                index = 10;
-                break;
-            case key::kB:
-                index = 11;
-                break;
-            case key::kX:
-                index = 12;
-                break;
-            case key::kY:
-                index = 13;
-                break;
-            case key::kLeftTrigger:
-                index = 14;
-                break;
-            case key::kRightTrigger:
-                index = 15;
-                break;
-            default:  // NOLINT(clang-diagnostic-covered-switch-default)
-                index = k_invalid;
-                break;
-        }
-
-        return index != k_invalid ? index + k_gamepad_offset : k_invalid;
-    }
 }  // control
@@ -1,21 +1,25 @@
 #pragma once
+#include "core/key_code.h"
 
 namespace control {
     class common {
     public:
         enum : uint32_t {
-            k_invalid = static_cast<uint32_t>(-1),
-            k_keyboard_offset = 0,
-            k_mouse_offset = 256,
-            k_gamepad_offset = 266
+            k_invalid = core::key_invalid,
+            k_keyboard_offset = core::key_keyboard_offset,
+            k_mouse_offset = core::key_mouse_offset,
+            k_gamepad_offset = core::key_gamepad_offset,
+            //16 gamepad buttons, every valid key id is below
+            k_total = core::key_total
         };
 
         static void get_key_id(const RE::ButtonEvent* a_button, uint32_t& a_key);
+        //same as above, for keys that do not come with an event, like the ones from the control map
+        static uint32_t get_key_id(RE::INPUT_DEVICE a_device, uint32_t a_key);
+        //vr and the virtual keyboard end up as other
+        static core::input_device get_device(RE::INPUT_DEVICE a_device);
 
         static bool is_key_valid(uint32_t a_key);
         static bool is_key_valid_and_matches(uint32_t a_key, uint32_t a_key_to_check);
-
-    private:
-        static uint32_t get_gamepad_index(RE::BSWin32GamepadDevice::Key a_key);
     };
 }  // control
@@ -0,0 +1,89 @@
+#include "ini_file.h"
+#include <algorithm>
+#include <cctype>
+#include <fmt/format.h>
+#include <fstream>
+#include <sstream>
+
+namespace core {
+    constexpr std::string_view utf8_bom = "\xEF\xBB\xBF";
+    constexpr std::string_view whitespace = " \t\r";
+
+    static std::string_view trim(std::string_view a_str) {
+        const auto first = a_str.find_first_not_of(whitespace);
+        if (first == std::string_view::npos) {
+            return {};
+        }
+        const auto last = a_str.find_last_not_of(whitespace);
+        return a_str.substr(first, last - first + 1);
+    }
+
+    bool ini_file::load(const std::filesystem::path& a_path, std::string& a_error) {
+        std::ifstream file(a_path, std::ios::binary);
+        if (!file) {
+            a_error = fmt::format("could not open {}", a_path.string());
+            return false;
+        }
+        std::stringstream content;
+        content << file.rdbuf();
+        parse(content.str());
+        return true;
+    }
+
+    void ini_file::parse(std::string_view a_content) {
+        sections.clear();
+        issues.clear();
+        size = a_content.size();
+        line_count = 0;
+
+        if (a_content.starts_with(utf8_bom)) {
+            a_content.remove_prefix(utf8_bom.size());
+        }
+
+        ini_section* current = nullptr;
+        while (!a_content.empty()) {
+            const auto end = a_content.find('\n');
+            const auto line = trim(a_content.substr(0, end));
+            a_content.remove_prefix(end == std::string_view::npos ? a_content.size() : end + 1);
+            ++line_count;
+
+            if (line.empty() || line.front() == ';' || line.front() == '#') {
+                continue;
+            }
+
+            if (line.front() == '[') {
+                const auto close = line.find(']');
+                if (close == std::string_view::npos) {
+                    issues.push_back({ line_count, "section header without ], line is ignored" });
+                    continue;
+                }
+                current = &sections.emplace_back();
+                current->name = trim(line.substr(1, close - 1));
+                current->line = line_count;
+                continue;
+            }
+
+            const auto equal = line.find('=');
+            if (equal == std::string_view::npos) {
+                issues.push_back({ line_count, "no key = value, line is ignored" });
+                continue;
+            }
+            if (!current) {
+                issues.push_back({ line_count, "value outside of a section, line is ignored" });
+                continue;
+            }
+            current->values.push_back({ std::string(trim(line.substr(0, equal))),
+                std::string(trim(line.substr(equal + 1))),
+                line_count });
+        }
+    }
+
+    bool ini_file::equals(const std::string_view a_left, const std::string_view a_right) {
+        return a_left.size() == a_right.size() && std::equal(a_left.begin(),
+                                                      a_left.end(),
+                                                      a_right.begin(),
+                                                      [](const unsigned char a_l, const unsigned char a_r) {
+                                                          return std::tolower(a_l) == std::tolower(a_r);
+                                                      });
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core {
+    //just what the custom config needs, keeps the file order and the line numbers for the report
+    class ini_file {
+    public:
+        struct ini_value {
+            std::string key;
+            std::string value;
+            uint32_t line = 0;
+        };
+
+        struct ini_section {
+            std::string name;
+            uint32_t line = 0;
+            std::vector<ini_value> values;
+        };
+
+        struct ini_issue {
+            uint32_t line = 0;
+            std::string message;
+        };
+
+        std::vector<ini_section> sections;
+        //lines the plugin would ignore
+        std::vector<ini_issue> issues;
+        uint64_t size = 0;
+        uint32_t line_count = 0;
+
+        bool load(const std::filesystem::path& a_path, std::string& a_error);
+        void parse(std::string_view a_content);
+
+        //names are compared like SimpleIni does it, case does not matter
+        static bool equals(std::string_view a_left, std::string_view a_right);
+    };
+}
@@ -0,0 +1,371 @@
+#include "page_config.h"
+#include <algorithm>
+#include <charconv>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+
+namespace core {
+    //has to stay in line with handle::slot_setting, the plugin headers need CommonLib so they are not included here
+    constexpr uint32_t slot_type_max = 12;
+    constexpr uint32_t slot_type_empty = 8;
+    constexpr uint32_t action_type_max = 2;
+    constexpr uint32_t action_type_un_equip = 2;
+    constexpr uint32_t hand_equip_max = 1;
+    constexpr auto delimiter = '|';
+    constexpr size_t max_listed_pages = 10;
+
+    constexpr auto key_page = "uPage";
+    constexpr auto key_position = "uPosition";
+    constexpr auto key_type = "uType";
+    constexpr auto key_form = "sSelectedItemForm";
+    constexpr auto key_action = "uSlotAction";
+    constexpr auto key_hand = "uHandSelection";
+    constexpr auto key_effect_actor_value = "iEffectActorValue";
+    constexpr auto key_type_left = "uTypeLeft";
+    constexpr auto key_form_left = "sSelectedItemFormLeft";
+    constexpr auto key_action_left = "uSlotActionLeft";
+
+    //SimpleIni takes the default if anything but the number is in there
+    static bool parse_long(const std::string& a_value, long& a_result) {
+        auto first = a_value.data();
+        const auto last = a_value.data() + a_value.size();
+        auto base = 10;
+        if (a_value.starts_with("0x") || a_value.starts_with("0X")) {
+            first += 2;
+            base = 16;
+        }
+        const auto [ptr, error] = std::from_chars(first, last, a_result, base);
+        return error == std::errc() && ptr == last && first != last;
+    }
+
+    static std::string to_lower(const std::string_view a_value) {
+        std::string lower(a_value);
+        std::ranges::transform(lower, lower.begin(), [](const unsigned char a_c) {
+            return static_cast<char>(std::tolower(a_c));
+        });
+        return lower;
+    }
+
+    static std::string get_section_name(const uint32_t a_page, const uint32_t a_position) {
+        return fmt::format("Page{}Position{}", a_page, a_position);
+    }
+
+    void page_config::read(const ini_file& a_file) {
+        entries_.clear();
+        issues_.clear();
+
+        for (const auto& [line, message] : a_file.issues) {
+            add_issue(severity::warning, line, message);
+        }
+
+        //section names do not care about case, same as ini_file::equals
+        std::unordered_map<std::string, size_t> index;
+        index.reserve(a_file.sections.size());
+        entries_.reserve(a_file.sections.size());
+        for (const auto& section : a_file.sections) {
+            const auto [it, inserted] = index.try_emplace(to_lower(section.name), entries_.size());
+            if (inserted) {
+                auto& added = entries_.emplace_back();
+                added.section = section.name;
+                added.line = section.line;
+            } else {
+                add_issue(severity::warning,
+                    section.line,
+                    fmt::format("section {} is already at line {}, they get merged",
+                        section.name,
+                        entries_[it->second].line));
+            }
+
+            auto& entry = entries_[it->second];
+            for (const auto& value : section.values) {
+                read_value(entry, value);
+            }
+
+            for (const auto* key : { key_page, key_position, key_type }) {
+                if (std::ranges::none_of(section.values,
+                        [&](const ini_file::ini_value& a_value) { return ini_file::equals(a_value.key, key); })) {
+                    add_issue(severity::warning,
+                        section.line,
+                        fmt::format("section {} has no {}, the plugin reads 0", section.name, key));
+                }
+            }
+        }
+    }
+
+    void page_config::read_value(page_entry& a_entry, const ini_file::ini_value& a_value) {
+        const auto read_number = [&](auto& a_target) {
+            long number = 0;
+            if (!parse_long(a_value.value, number)) {
+                add_issue(severity::error,
+                    a_value.line,
+                    fmt::format("{} = {} is not a number, the plugin uses the default", a_value.key, a_value.value));
+                return;
+            }
+            if (std::is_unsigned_v<std::remove_reference_t<decltype(a_target)>> && number < 0) {
+                add_issue(severity::error, a_value.line, fmt::format("{} can not be negative", a_value.key));
+            }
+            a_target = static_cast<std::remove_reference_t<decltype(a_target)>>(number);
+        };
+
+        const auto& key = a_value.key;
+        if (ini_file::equals(key, key_page)) {
+            read_number(a_entry.page);
+        } else if (ini_file::equals(key, key_position)) {
+            read_number(a_entry.position);
+        } else if (ini_file::equals(key, key_type)) {
+            read_number(a_entry.type);
+        } else if (ini_file::equals(key, key_form)) {
+            a_entry.form = a_value.value;
+        } else if (ini_file::equals(key, key_action)) {
+            read_number(a_entry.action);
+        } else if (ini_file::equals(key, key_hand)) {
+            read_number(a_entry.hand);
+        } else if (ini_file::equals(key, key_effect_actor_value)) {
+            read_number(a_entry.effect_actor_value);
+        } else if (ini_file::equals(key, key_type_left)) {
+            read_number(a_entry.type_left);
+        } else if (ini_file::equals(key, key_form_left)) {
+            a_entry.form_left = a_value.value;
+        } else if (ini_file::equals(key, key_action_left)) {
+            read_number(a_entry.action_left);
+        } else {
+            add_issue(severity::warning, a_value.line, fmt::format("unknown key {}, the plugin ignores it", key));
+        }
+    }
+
+    void page_config::validate() {
+        for (const auto& entry : entries_) {
+            validate_entry(entry);
+        }
+        validate_pages();
+        std::ranges::stable_sort(issues_, {}, &config_issue::line);
+    }
+
+    void page_config::validate_entry(const page_entry& a_entry) {
+        const auto line = a_entry.line;
+        const auto& section = a_entry.section;
+        if (a_entry.position >= util::page_key_position_count) {
+            add_issue(severity::error,
+                line,
+                fmt::format("{} has position {}, there are just 4", section, a_entry.position));
+        }
+        if (a_entry.type > slot_type_max || a_entry.type_left > slot_type_max) {
+            add_issue(severity::error,
+                line,
+                fmt::format("{} has unknown type {}, left {}", section, a_entry.type, a_entry.type_left));
+        }
+        if (a_entry.action > action_type_max || a_entry.action_left > action_type_max) {
+            add_issue(severity::error,
+                line,
+                fmt::format("{} has unknown action {}, left {}", section, a_entry.action, a_entry.action_left));
+        }
+        if (a_entry.hand > hand_equip_max) {
+            add_issue(severity::error, line, fmt::format("{} has unknown hand selection {}", section, a_entry.hand));
+        }
+        if (a_entry.effect_actor_value < -1) {
+            add_issue(severity::error,
+                line,
+                fmt::format("{} has unknown actor value {}", section, a_entry.effect_actor_value));
+        }
+        for (const auto* form : { &a_entry.form, &a_entry.form_left }) {
+            if (!form->empty() && !is_form_string(*form)) {
+                add_issue(severity::error, line, fmt::format("{} has form {}, expected plugin|id", section, *form));
+            }
+        }
+
+        if (a_entry.type != slot_type_empty && a_entry.form.empty() && a_entry.effect_actor_value == -1 &&
+            a_entry.action != action_type_un_equip) {
+            add_issue(severity::warning,
+                line,
+                fmt::format("{} has type {} but no form, the slot stays empty", section, a_entry.type));
+        }
+        if (a_entry.type == slot_type_empty && !a_entry.form.empty()) {
+            add_issue(severity::warning, line, fmt::format("{} is empty but has form {}", section, a_entry.form));
+        }
+        if (a_entry.position < util::page_key_position_count &&
+            section != get_section_name(a_entry.page, a_entry.position)) {
+            add_issue(severity::warning,
+                line,
+                fmt::format("{} holds page {}, position {}, it gets renamed",
+                    section,
+                    a_entry.page,
+                    a_entry.position));
+        }
+    }
+
+    void page_config::validate_pages() {
+        std::map<util::page_key, const page_entry*> used;
+        std::map<uint32_t, std::set<uint32_t>> pages_per_position;
+        for (const auto& entry : entries_) {
+            if (entry.position >= util::page_key_position_count) {
+                continue;
+            }
+            const auto key = util::make_page_key(entry.page, entry.position);
+            if (const auto [it, inserted] = used.try_emplace(key, &entry); !inserted) {
+                add_issue(severity::warning,
+                    entry.line,
+                    fmt::format("{} uses page {}, position {} like {}, {}",
+                        entry.section,
+                        entry.page,
+                        entry.position,
+                        it->second->section,
+                        mode_ == config_mode::elden ? "both are kept on consecutive pages" : "it replaces that one"));
+                it->second = &entry;
+            }
+            pages_per_position[entry.position].insert(entry.page);
+        }
+
+        //the default mode shows empty pages for the gaps, just elden cycles through what is configured
+        if (mode_ != config_mode::elden) {
+            return;
+        }
+
+        for (const auto& [position, pages] : pages_per_position) {
+            std::vector<uint32_t> missing;
+            auto expected = 0u;
+            for (const auto page : pages) {
+                for (; expected < page; ++expected) {
+                    missing.push_back(expected);
+                }
+                expected = page + 1;
+            }
+            if (missing.size() > max_listed_pages) {
+                add_issue(severity::warning,
+                    0,
+                    fmt::format("position {} is missing {} pages, the first is {}",
+                        position,
+                        missing.size(),
+                        missing.front()));
+            } else if (!missing.empty()) {
+                add_issue(severity::warning,
+                    0,
+                    fmt::format("position {} is missing page(s) {}", position, fmt::join(missing, ", ")));
+            }
+        }
+    }
+
+    uint32_t page_config::normalize() {
+        if (mode_ != config_mode::elden) {
+            return normalize_default();
+        }
+
+        //file order breaks ties, rewrite_settings does the same with the order it reads them in
+        std::ranges::stable_sort(entries_, [](const page_entry& a_left, const page_entry& a_right) {
+            return std::tie(a_left.position, a_left.page) < std::tie(a_right.position, a_right.page);
+        });
+
+        uint32_t changed = 0;
+        std::map<uint32_t, uint32_t> next_page_for_position;
+        for (auto& entry : entries_) {
+            if (entry.position >= util::page_key_position_count) {
+                continue;
+            }
+            const auto page = next_page_for_position[entry.position]++;
+            auto section = get_section_name(page, entry.position);
+            if (page != entry.page || section != entry.section) {
+                ++changed;
+            }
+            entry.page = page;
+            entry.section = std::move(section);
+        }
+
+        std::ranges::stable_sort(entries_, {}, [](const page_entry& a_entry) {
+            return util::make_page_key(a_entry.page, a_entry.position);
+        });
+        return changed;
+    }
+
+    uint32_t page_config::normalize_default() {
+        //the plugin loads the sections in file order and a later page replaces an earlier one with the same key
+        std::unordered_map<util::page_key, size_t> last;
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            if (const auto& entry = entries_[i]; entry.position < util::page_key_position_count) {
+                last[util::make_page_key(entry.page, entry.position)] = i;
+            }
+        }
+
+        uint32_t changed = 0;
+        std::vector<page_entry> kept;
+        kept.reserve(last.size());
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            auto& entry = entries_[i];
+            if (entry.position >= util::page_key_position_count) {
+                continue;
+            }
+            if (last[util::make_page_key(entry.page, entry.position)] != i) {
+                ++changed;
+                continue;
+            }
+            if (auto section = get_section_name(entry.page, entry.position); section != entry.section) {
+                ++changed;
+                entry.section = std::move(section);
+            }
+            kept.push_back(std::move(entry));
+        }
+
+        std::ranges::stable_sort(kept, {}, [](const page_entry& a_entry) {
+            return util::make_page_key(a_entry.page, a_entry.position);
+        });
+        entries_ = std::move(kept);
+        return changed;
+    }
+
+    std::string page_config::write() const {
+        //SimpleIni writes the bom as well, so a save from the plugin does not show up as a change
+        std::string out = "\xEF\xBB\xBF";
+        for (const auto& entry : entries_) {
+            if (entry.position >= util::page_key_position_count) {
+                continue;
+            }
+            if (out.size() > 3) {
+                out += "\n";
+            }
+            fmt::format_to(std::back_inserter(out), "[{}]\n", entry.section);
+            fmt::format_to(std::back_inserter(out), "{} = {}\n", key_page, entry.page);
+            fmt::format_to(std::back_inserter(out), "{} = {}\n", key_position, entry.position);
+            fmt::format_to(std::back_inserter(out), "{} = {}\n", key_type, entry.type);
+            fmt::format_to(std::back_inserter(out), "{} = {}\n", key_form, entry.form);
+            fmt::format_to(std::back_inserter(out), "{} = {}\n", key_action, entry.action);
+            fmt::format_to(std::back_inserter(out), "{} = {}\n", key_hand, entry.hand);
+            fmt::format_to(std::back_inserter(out), "{} = {}\n", key_effect_actor_value, entry.effect_actor_value);
+            fmt::format_to(std::back_inserter(out), "{} = {}\n", key_type_left, entry.type_left);
+            fmt::format_to(std::back_inserter(out), "{} = {}\n", key_form_left, entry.form_left);
+            fmt::format_to(std::back_inserter(out), "{} = {}\n", key_action_left, entry.action_left);
+        }
+        return out;
+    }
+
+    bool page_config::has_errors() const {
+        return std::ranges::any_of(issues_,
+            [](const config_issue& a_issue) { return a_issue.level == severity::error; });
+    }
+
+    std::vector<uint32_t> page_config::get_page_counts() const {
+        std::vector<uint32_t> counts(util::page_key_position_count, 0);
+        for (const auto& entry : entries_) {
+            if (entry.position < util::page_key_position_count) {
+                ++counts[entry.position];
+            }
+        }
+        return counts;
+    }
+
+    void page_config::add_issue(const severity a_level, const uint32_t a_line, std::string a_message) {
+        issues_.push_back({ a_level, a_line, std::move(a_message) });
+    }
+
+    bool page_config::is_form_string(const std::string& a_form) {
+        const auto split = a_form.find(delimiter);
+        if (split == std::string::npos || split == 0 || split + 1 == a_form.size()) {
+            return false;
+        }
+        uint32_t form_id = 0;
+        const auto* first = a_form.data() + split + 1;
+        const auto* last = a_form.data() + a_form.size();
+        const auto [ptr, error] = std::from_chars(first, last, form_id, 16);
+        return error == std::errc() && ptr == last;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "ini_file.h"
+#include "util/page_key.h"
+#include <map>
+
+namespace core {
+    //one section of the custom config, defaults are the ones custom_setting reads with
+    class page_entry {
+    public:
+        std::string section;
+        uint32_t line = 0;
+        uint32_t page = 0;
+        uint32_t position = 0;
+        uint32_t type = 0;
+        std::string form;
+        uint32_t action = 0;
+        uint32_t hand = 1;
+        int effect_actor_value = -1;
+        uint32_t type_left = 0;
+        std::string form_left;
+        uint32_t action_left = 0;
+    };
+
+    class page_config {
+    public:
+        enum class severity : std::uint32_t { warning = 0, error = 1 };
+        //only elden keeps the pages of a position consecutive, the default mode loads every page where it is
+        enum class config_mode : std::uint32_t { default_mode = 0, elden = 1 };
+
+        struct config_issue {
+            severity level = severity::warning;
+            uint32_t line = 0;
+            std::string message;
+        };
+
+        explicit page_config(const config_mode a_mode) : mode_(a_mode) {}
+
+        //read like the plugin does it, sections with the same name are merged and the last value wins
+        void read(const ini_file& a_file);
+        //values the plugin can not use are errors, everything rewrite_settings would fix is a warning
+        void validate();
+        //elden gets consecutive pages per position starting at 0, the default mode keeps the pages and drops the
+        //sections a later one replaces. returns how many sections got a new page or name or got dropped
+        uint32_t normalize();
+        //same keys and order custom_setting writes, sections ordered by page and position
+        [[nodiscard]] std::string write() const;
+
+        [[nodiscard]] const std::vector<page_entry>& get_entries() const { return entries_; }
+        [[nodiscard]] const std::vector<config_issue>& get_issues() const { return issues_; }
+        [[nodiscard]] bool has_errors() const;
+        //pages per position, index is the position
+        [[nodiscard]] std::vector<uint32_t> get_page_counts() const;
+
+    private:
+        void add_issue(severity a_level, uint32_t a_line, std::string a_message);
+        void read_value(page_entry& a_entry, const ini_file::ini_value& a_value);
+        void validate_entry(const page_entry& a_entry);
+        void validate_pages();
+        uint32_t normalize_default();
+        static bool is_form_string(const std::string& a_form);
+
+        config_mode mode_;
+        std::vector<page_entry> entries_;
+        std::vector<config_issue> issues_;
+    };
+}
@@ -0,0 +1,109 @@
+#include "hud_draw.h"
+
+namespace core {
+    void draw_slots(const float a_x, const float a_y, const hud_snapshot& a_snapshot, render_target& a_target) {
+        for (const auto& position : a_snapshot.positions) {
+            const auto& draw_setting = position.draw_setting;
+            a_target.draw_slot(a_x,
+                a_y,
+                draw_setting.hud_image_scale_width,
+                draw_setting.hud_image_scale_height,
+                draw_setting.offset_slot_x,
+                draw_setting.offset_slot_y,
+                position.button_press_modify,
+                draw_setting.background_icon_transparency);
+            a_target.draw_icon(a_x,
+                a_y,
+                draw_setting.icon_scale_width,
+                draw_setting.icon_scale_height,
+                draw_setting.offset_slot_x,
+                draw_setting.offset_slot_y,
+                position.icon_type,
+                draw_setting.icon_transparency);
+
+            if (!position.slot_name.empty()) {
+                const auto center_text =
+                    (position.position == position_type::top || position.position == position_type::bottom);
+                const auto deduct_text_x = position.position == position_type::left;
+                const auto deduct_text_y = position.position == position_type::bottom;
+                const auto add_text_x = false;
+                const auto add_text_y = position.position == position_type::top;
+                a_target.draw_text(draw_setting.width_setting,
+                    draw_setting.height_setting,
+                    draw_setting.offset_slot_x,
+                    draw_setting.offset_slot_y,
+                    draw_setting.offset_name_text_x,
+                    draw_setting.offset_name_text_y,
+                    position.slot_name.c_str(),
+                    draw_setting.slot_item_name_transparency,
+                    draw_setting.slot_item_red,
+                    draw_setting.slot_item_green,
+                    draw_setting.slot_item_blue,
+                    position.item_name_font_size,
+                    center_text,
+                    deduct_text_x,
+                    deduct_text_y,
+                    add_text_x,
+                    add_text_y);
+            }
+
+            if (!position.slot_text.empty()) {
+                a_target.draw_text(draw_setting.width_setting,
+                    draw_setting.height_setting,
+                    draw_setting.offset_slot_x,
+                    draw_setting.offset_slot_y,
+                    draw_setting.offset_text_x,
+                    draw_setting.offset_text_y,
+                    position.slot_text.c_str(),
+                    draw_setting.slot_count_transparency,
+                    draw_setting.slot_count_red,
+                    draw_setting.slot_count_green,
+                    draw_setting.slot_count_blue,
+                    position.count_font_size,
+                    true,
+                    false,
+                    false,
+                    false,
+                    false);
+            }
+        }
+
+        if (!a_snapshot.ammo) {
+            return;
+        }
+        const auto& ammo = a_snapshot.ammo_setting;
+        a_target.draw_slot(a_x,
+            a_y,
+            ammo.image_scale_width,
+            ammo.image_scale_height,
+            ammo.offset_slot_x,
+            ammo.offset_slot_y,
+            a_snapshot.ammo_button_press_modify,
+            ammo.background_icon_transparency);
+        a_target.draw_icon(a_x,
+            a_y,
+            ammo.icon_scale_width,
+            ammo.icon_scale_height,
+            ammo.offset_slot_x,
+            ammo.offset_slot_y,
+            ammo.icon_type,
+            ammo.icon_transparency);
+        a_target.draw_text(a_x,
+            a_y,
+            ammo.offset_slot_x,
+            ammo.offset_slot_y,
+            ammo.offset_text,
+            ammo.offset_text,
+            a_snapshot.ammo_count.c_str(),
+            ammo.slot_count_transparency,
+            ammo.slot_count_red,
+            ammo.slot_count_green,
+            ammo.slot_count_blue,
+            ammo.count_font_size,
+            true,
+            false,
+            false,
+            false,
+            false);
+    }
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include "hud_snapshot.h"
+#include "render_target.h"
+
+namespace core {
+    //background, icon, name and count of each position and the ammo slot, in the order they are drawn
+    void draw_slots(float a_x, float a_y, const hud_snapshot& a_snapshot, render_target& a_target);
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "position.h"
+#include <string>
+#include <vector>
+
+namespace core {
+    //what the renderer needs of a page, the page model keeps one per page
+    struct position_draw_setting {
+        float key_icon_scale_width = 0.f;
+        float key_icon_scale_height = 0.f;
+
+        float icon_scale_width = 0.f;
+        float icon_scale_height = 0.f;
+
+        uint32_t background_icon_transparency = draw_full;
+        uint32_t icon_transparency = draw_full;
+        uint32_t key_transparency = draw_full;
+        uint32_t slot_count_transparency = draw_full;
+        uint32_t slot_item_name_transparency = draw_full;
+
+        uint32_t slot_count_red = draw_full;
+        uint32_t slot_count_green = draw_full;
+        uint32_t slot_count_blue = draw_full;
+        uint32_t slot_item_red = draw_full;
+        uint32_t slot_item_green = draw_full;
+        uint32_t slot_item_blue = draw_full;
+
+        float offset_slot_x = 0.f;
+        float offset_slot_y = 0.f;
+        float offset_key_x = 0.f;
+        float offset_key_y = 0.f;
+        float offset_text_x = 0.f;
+        float offset_text_y = 0.f;
+
+        float offset_name_text_x = 0.f;
+        float offset_name_text_y = 0.f;
+
+        float width_setting = 0.f;
+        float height_setting = 0.f;
+
+        float hud_image_scale_width = 0.f;
+        float hud_image_scale_height = 0.f;
+
+        [[maybe_unused]] uint32_t background_transparency = draw_full;
+
+        uint32_t alpha_slot_animation = 0;
+        float duration_slot_animation = 0.f;
+    };
+
+    //the ammo slot is not a page, its values come straight from the mcm
+    struct ammo_draw_setting {
+        uint32_t icon_type = 0;
+        float image_scale_width = 0.f;
+        float image_scale_height = 0.f;
+        float icon_scale_width = 0.f;
+        float icon_scale_height = 0.f;
+        float offset_slot_x = 0.f;
+        float offset_slot_y = 0.f;
+        float offset_text = 0.f;
+        float count_font_size = 0.f;
+        uint32_t background_icon_transparency = draw_full;
+        uint32_t icon_transparency = draw_full;
+        uint32_t slot_count_transparency = draw_full;
+        uint32_t slot_count_red = draw_full;
+        uint32_t slot_count_green = draw_full;
+        uint32_t slot_count_blue = draw_full;
+    };
+
+    //one position as the renderer draws it, copied out of the page so the renderer never touches the pages
+    struct hud_position_snapshot {
+        position_type position = position_type::total;
+        //ui::icon_image_type, the core does not know the images
+        uint32_t icon_type = 0;
+        uint32_t button_press_modify = draw_full;
+        uint32_t key = 0;
+        position_draw_setting draw_setting;
+        float item_name_font_size = 0.f;
+        float count_font_size = 0.f;
+        bool item_name = false;
+        std::string slot_name;
+        std::string slot_text;
+    };
+
+    struct hud_snapshot {
+        std::vector<hud_position_snapshot> positions;
+        bool ammo = false;
+        uint32_t ammo_button_press_modify = draw_full;
+        std::string ammo_count;
+        ammo_draw_setting ammo_setting;
+    };
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+
+namespace core {
+    using form_id = uint32_t;
+
+    //RE::ActorValue::kNone, for anything that is not a grouped potion
+    constexpr uint32_t no_potion_group = static_cast<uint32_t>(-1);
+
+    //an inventory object as far as the core cares about it. the plugin fills it from the form while it has it at hand
+    struct item_record {
+        form_id id = 0;
+        int32_t count = 0;
+        //the actor value a potion restores, potions are grouped by it
+        uint32_t potion_group = no_potion_group;
+        //magnitude * duration of the costliest effect, what the potion restores in total
+        float restore_amount = 0.f;
+        bool dynamic = false;
+    };
+
+    //the player inventory, reduced to the items the hud can show
+    class inventory_source {
+    public:
+        virtual ~inventory_source() = default;
+        virtual void for_each_item(const std::function<void(const item_record&)>& a_visit) const = 0;
+    };
+}
@@ -0,0 +1,148 @@
+#include "item_counts.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <tuple>
+
+namespace core {
+    void item_counts::reset() {
+        built_ = false;
+        counts_.clear();
+        group_counts_.clear();
+        potion_buckets_.clear();
+    }
+
+    void item_counts::build(const inventory_source& a_inventory) {
+        reset();
+        a_inventory.for_each_item([this](const item_record& a_item) {
+            if (a_item.count <= 0) {
+                return;
+            }
+            counts_[a_item.id] = a_item.count;
+            if (a_item.potion_group != no_potion_group) {
+                group_counts_[a_item.potion_group] += a_item.count;
+                potion_buckets_[a_item.potion_group].push_back(
+                    { a_item.restore_amount, a_item.id, a_item.dynamic, a_item.count });
+            }
+        });
+        for (auto& [group, bucket] : potion_buckets_) {
+            std::ranges::sort(bucket, potion_less);
+        }
+        built_ = true;
+    }
+
+    void item_counts::apply_delta(const item_record& a_item) {
+        //nothing built yet, the first read gets it from the inventory anyway
+        if (!built_) {
+            return;
+        }
+
+        auto& count = counts_[a_item.id];
+        count = std::max(count + a_item.count, 0);
+        if (a_item.potion_group != no_potion_group) {
+            auto& group_count = group_counts_[a_item.potion_group];
+            group_count = std::max(group_count + a_item.count, 0);
+            update_potion(a_item, count);
+        }
+    }
+
+    int32_t item_counts::get_count(const form_id a_form) const {
+        if (const auto it = counts_.find(a_form); it != counts_.end()) {
+            return it->second;
+        }
+        return 0;
+    }
+
+    int32_t item_counts::get_group_count(const uint32_t a_group) const {
+        if (const auto it = group_counts_.find(a_group); it != group_counts_.end()) {
+            return it->second;
+        }
+        return 0;
+    }
+
+    form_id item_counts::get_fitting_potion(const uint32_t a_group,
+        const float a_missing,
+        const float a_min_perfect,
+        const float a_max_perfect,
+        const bool a_skip_last_dynamic) const {
+        const auto it = potion_buckets_.find(a_group);
+        if (it == potion_buckets_.end() || it->second.empty()) {
+            return 0;
+        }
+        const auto& bucket = it->second;
+
+        if (const auto* entry = find_closest(bucket,
+                a_missing,
+                a_missing * a_min_perfect,
+                a_missing * a_max_perfect,
+                a_skip_last_dynamic);
+            entry) {
+            return entry->id;
+        }
+
+        //nothing is a perfect fit, still take the one that is closest
+        if (const auto* entry = find_closest(bucket,
+                a_missing,
+                std::numeric_limits<float>::lowest(),
+                std::numeric_limits<float>::max(),
+                a_skip_last_dynamic);
+            entry) {
+            return entry->id;
+        }
+        return 0;
+    }
+
+    bool item_counts::potion_less(const potion_entry& a_left, const potion_entry& a_right) {
+        return std::tie(a_left.amount, a_left.id) < std::tie(a_right.amount, a_right.id);
+    }
+
+    void item_counts::update_potion(const item_record& a_item, const int32_t a_count) {
+        auto& bucket = potion_buckets_[a_item.potion_group];
+        const potion_entry key{ a_item.restore_amount, a_item.id, a_item.dynamic, a_count };
+        const auto it = std::ranges::lower_bound(bucket, key, potion_less);
+        const auto found = it != bucket.end() && it->id == key.id;
+        if (found && a_count > 0) {
+            it->count = a_count;
+        } else if (found) {
+            bucket.erase(it);
+        } else if (a_count > 0) {
+            bucket.insert(it, key);
+        }
+    }
+
+    const item_counts::potion_entry* item_counts::find_closest(const potion_bucket& a_bucket,
+        const float a_target,
+        const float a_lowest,
+        const float a_highest,
+        const bool a_skip_last_dynamic) {
+        const auto usable = [a_skip_last_dynamic](const potion_entry& a_entry) {
+            return a_entry.count > 0 && !(a_skip_last_dynamic && a_entry.count == 1 && a_entry.dynamic);
+        };
+
+        const auto first = std::ranges::lower_bound(a_bucket, a_lowest, {}, &potion_entry::amount);
+        const auto last = std::ranges::upper_bound(first, a_bucket.end(), a_highest, {}, &potion_entry::amount);
+        const auto split = std::ranges::lower_bound(first, last, a_target, {}, &potion_entry::amount);
+
+        //walk away from the target on both sides, the first usable one that is closer wins
+        auto above = split;
+        auto below = split;
+        while (above != last || below != first) {
+            const auto above_diff = above != last ? above->amount - a_target : std::numeric_limits<float>::max();
+            const auto below_diff =
+                below != first ? a_target - std::prev(below)->amount : std::numeric_limits<float>::max();
+            if (above_diff <= below_diff) {
+                if (usable(*above)) {
+                    return std::to_address(above);
+                }
+                ++above;
+            } else {
+                --below;
+                if (usable(*below)) {
+                    return std::to_address(below);
+                }
+            }
+        }
+        return nullptr;
+    }
+}
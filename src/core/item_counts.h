@@ -0,0 +1,55 @@
+#pragma once
+#include "inventory_source.h"
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+    //counts of the items the hud can show, taken with one look at the inventory and then kept up with the changes.
+    //not thread safe, the plugin guards it
+    class item_counts {
+    public:
+        //the next build takes the counts from the inventory again
+        void reset();
+        [[nodiscard]] bool is_built() const { return built_; }
+        void build(const inventory_source& a_inventory);
+        //a_item.count is the change, nothing happens as long as nothing is built
+        void apply_delta(const item_record& a_item);
+
+        [[nodiscard]] int32_t get_count(form_id a_form) const;
+        //sum over the potions grouped under the actor value
+        [[nodiscard]] int32_t get_group_count(uint32_t a_group) const;
+        //owned potion of the group that restores closest to the missing amount, one inside the min/max range wins
+        //over a closer one outside of it. dynamic potions with one left are skipped if asked for. 0 if there is none
+        [[nodiscard]] form_id get_fitting_potion(uint32_t a_group,
+            float a_missing,
+            float a_min_perfect,
+            float a_max_perfect,
+            bool a_skip_last_dynamic) const;
+
+        [[nodiscard]] size_t get_tracked_form_count() const { return counts_.size(); }
+        [[nodiscard]] size_t get_tracked_group_count() const { return group_counts_.size(); }
+
+    private:
+        struct potion_entry {
+            float amount = 0.f;
+            form_id id = 0;
+            bool dynamic = false;
+            int32_t count = 0;
+        };
+        //sorted by amount, form id keeps equal amounts in a fixed order
+        using potion_bucket = std::vector<potion_entry>;
+
+        static bool potion_less(const potion_entry& a_left, const potion_entry& a_right);
+        void update_potion(const item_record& a_item, int32_t a_count);
+        static const potion_entry* find_closest(const potion_bucket& a_bucket,
+            float a_target,
+            float a_lowest,
+            float a_highest,
+            bool a_skip_last_dynamic);
+
+        bool built_ = false;
+        std::unordered_map<form_id, int32_t> counts_;
+        std::unordered_map<uint32_t, int32_t> group_counts_;
+        std::unordered_map<uint32_t, potion_bucket> potion_buckets_;
+    };
+}
@@ -0,0 +1,76 @@
+#include "key_code.h"
+
+namespace core {
+    uint32_t get_key_id(const input_device a_device, const uint32_t a_key) {
+        switch (a_device) {
+            case input_device::mouse:
+                return a_key + key_mouse_offset;
+            case input_device::keyboard:
+                return a_key + key_keyboard_offset;
+            case input_device::gamepad:
+                return get_gamepad_index(a_key);
+            case input_device::other:
+                break;
+        }
+        return a_key;
+    }
+
+    uint32_t get_gamepad_index(const uint32_t a_button) {
+        uint32_t index;
+        switch (a_button) {
+            case gamepad_up:
+                index = 0;
+                break;
+            case gamepad_down:
+                index = 1;
+                break;
+            case gamepad_left:
+                index = 2;
+                break;
+            case gamepad_right:
+                index = 3;
+                break;
+            case gamepad_start:
+                index = 4;
+                break;
+            case gamepad_back:
+                index = 5;
+                break;
+            case gamepad_left_thumb:
+                index = 6;
+                break;
+            case gamepad_right_thumb:
+                index = 7;
+                break;
+            case gamepad_left_shoulder:
+                index = 8;
+                break;
+            case gamepad_right_shoulder:
+                index = 9;
+                break;
+            case gamepad_a:
+                index = 10;
+                break;
+            case gamepad_b:
+                index = 11;
+                break;
+            case gamepad_x:
+                index = 12;
+                break;
+            case gamepad_y:
+                index = 13;
+                break;
+            case gamepad_left_trigger:
+                index = 14;
+                break;
+            case gamepad_right_trigger:
+                index = 15;
+                break;
+            default:
+                index = key_invalid;
+                break;
+        }
+
+        return index != key_invalid ? index + key_gamepad_offset : key_invalid;
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+
+namespace core {
+    //one number per key over all devices, that is what the mcm stores and the key table is indexed with
+    enum : uint32_t {
+        key_invalid = static_cast<uint32_t>(-1),
+        key_keyboard_offset = 0,
+        key_mouse_offset = 256,
+        key_gamepad_offset = 266,
+        //16 gamepad buttons, every valid key id is below
+        key_total = 282
+    };
+
+    //same order as RE::INPUT_DEVICE
+    enum class input_device : uint32_t { keyboard = 0, mouse = 1, gamepad = 2, other = 3 };
+
+    //the xinput masks the game reports gamepad buttons with, same as RE::BSWin32GamepadDevice::Key
+    enum gamepad_button : uint32_t {
+        gamepad_up = 0x0001,
+        gamepad_down = 0x0002,
+        gamepad_left = 0x0004,
+        gamepad_right = 0x0008,
+        gamepad_start = 0x0010,
+        gamepad_back = 0x0020,
+        gamepad_left_thumb = 0x0040,
+        gamepad_right_thumb = 0x0080,
+        gamepad_left_shoulder = 0x0100,
+        gamepad_right_shoulder = 0x0200,
+        gamepad_a = 0x1000,
+        gamepad_b = 0x2000,
+        gamepad_x = 0x4000,
+        gamepad_y = 0x8000,
+        gamepad_left_trigger = 0x0009,
+        gamepad_right_trigger = 0x000A
+    };
+
+    uint32_t get_key_id(input_device a_device, uint32_t a_key);
+    uint32_t get_gamepad_index(uint32_t a_button);
+}
@@ -0,0 +1,21 @@
+#include "key_table.h"
+
+namespace core {
+    void key_table::clear() { dispatch_.fill({}); }
+
+    void key_table::add(const uint32_t a_key, const uint32_t a_roles, const position_type a_position) {
+        if (a_key == key_invalid || a_key >= dispatch_.size()) {
+            return;
+        }
+        auto& [roles, position] = dispatch_[a_key];
+        roles |= a_roles;
+        if (a_position != position_type::total) {
+            position = a_position;
+        }
+    }
+
+    const key_table::key_dispatch& key_table::get(const uint32_t a_key) const {
+        static constexpr key_dispatch unbound;
+        return a_key < dispatch_.size() ? dispatch_[a_key] : unbound;
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "key_code.h"
+#include "position.h"
+#include <array>
+
+namespace core {
+    //indexed with the normalized key id, so an input event needs a single lookup
+    class key_table {
+    public:
+        //what a key is bound to, one key can have more than one
+        enum key_role : uint32_t {
+            none = 0,
+            position_button = 1 << 0,
+            scroll = 1 << 1,
+            utility = 1 << 2,
+            toggle = 1 << 3,
+            hide_show = 1 << 4,
+            top_execute = 1 << 5
+        };
+
+        //position is total if the key is no position button
+        struct key_dispatch {
+            uint32_t roles = key_role::none;
+            position_type position = position_type::total;
+        };
+
+        void clear();
+        //invalid keys are ignored, the roles add up if a key is bound more than once
+        void add(uint32_t a_key, uint32_t a_roles, position_type a_position = position_type::total);
+        //unknown keys get an entry without roles
+        [[nodiscard]] const key_dispatch& get(uint32_t a_key) const;
+
+    private:
+        std::array<key_dispatch, key_total> dispatch_{};
+    };
+}
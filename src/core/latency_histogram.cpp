@@ -0,0 +1,59 @@
+#include "latency_histogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace core {
+    void latency_histogram::record(const uint64_t a_value) {
+        ++counts_[get_index(a_value)];
+        ++count_;
+        max_ = std::max(max_, a_value);
+    }
+
+    void latency_histogram::reset() {
+        counts_.fill(0);
+        count_ = 0;
+        max_ = 0;
+    }
+
+    uint64_t latency_histogram::get_percentile(const double a_percentile) const {
+        if (count_ == 0) {
+            return 0;
+        }
+        const auto rank = std::max<uint64_t>(
+            1,
+            static_cast<uint64_t>(std::ceil(std::clamp(a_percentile, 0.0, 1.0) * static_cast<double>(count_))));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                //the last bucket has no upper end, everything too big for the others is in there
+                return i == counts_.size() - 1 ? max_ : std::min(get_upper(i), max_);
+            }
+        }
+        return max_;
+    }
+
+    size_t latency_histogram::get_index(const uint64_t a_value) {
+        if (a_value < sub_bucket_count) {
+            return static_cast<size_t>(a_value);
+        }
+        const auto bit = static_cast<uint32_t>(std::bit_width(a_value)) - 1;
+        if (bit > highest_bit) {
+            return bucket_count - 1;
+        }
+        //the four bits below the highest one pick the bucket within the magnitude
+        const auto shift = bit - sub_bucket_bits;
+        const auto sub = static_cast<uint32_t>(a_value >> shift) & (sub_bucket_count - 1);
+        return static_cast<size_t>(sub_bucket_count * (shift + 1) + sub);
+    }
+
+    uint64_t latency_histogram::get_upper(const size_t a_index) {
+        if (a_index < sub_bucket_count) {
+            return a_index;
+        }
+        const auto shift = static_cast<uint32_t>(a_index / sub_bucket_count) - 1;
+        const auto sub = static_cast<uint64_t>(a_index % sub_bucket_count);
+        return ((sub_bucket_count + sub + 1) << shift) - 1;
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace core {
+    //counts latencies in buckets that get wider with the value, like an hdr histogram. below 16 every value has its
+    //own bucket, above it a bucket is at most 1/16 of its value wide. fixed size, recording never allocates
+    class latency_histogram {
+    public:
+        void record(uint64_t a_value);
+        void reset();
+
+        [[nodiscard]] uint64_t get_count() const { return count_; }
+        [[nodiscard]] uint64_t get_max() const { return max_; }
+        //the upper end of the bucket the percentile falls into, a_percentile from 0 to 1. 0 if nothing is recorded
+        [[nodiscard]] uint64_t get_percentile(double a_percentile) const;
+
+    private:
+        static constexpr uint32_t sub_bucket_bits = 4;
+        static constexpr uint32_t sub_bucket_count = 1 << sub_bucket_bits;
+        //the highest bit a value can have, everything above lands in the last bucket
+        static constexpr uint32_t highest_bit = 40;
+        static constexpr size_t bucket_count = sub_bucket_count * (highest_bit - sub_bucket_bits + 2);
+
+        static size_t get_index(uint64_t a_value);
+        static uint64_t get_upper(size_t a_index);
+
+        std::array<uint64_t, bucket_count> counts_{};
+        uint64_t count_ = 0;
+        uint64_t max_ = 0;
+    };
+}
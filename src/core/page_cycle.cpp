@@ -0,0 +1,64 @@
+#include "page_cycle.h"
+
+namespace core {
+    void page_cycle::set_active_page(const uint32_t a_page) { active_page_ = a_page; }
+
+    uint32_t page_cycle::get_active_page() const { return active_page_; }
+
+    uint32_t page_cycle::get_next_page(const uint32_t a_max_page_count) const {
+        //we start at 0, so it is max count -1
+        if (active_page_ < a_max_page_count - 1) {
+            return active_page_ + 1;
+        }
+        return 0;
+    }
+
+    void page_cycle::set_active_page_position(const uint32_t a_page, const position_type a_position) {
+        if (is_valid(a_position)) {
+            active_page_per_position_[static_cast<uint32_t>(a_position)] = a_page;
+        }
+    }
+
+    uint32_t page_cycle::get_active_page_position(const position_type a_position) const {
+        if (!is_valid(a_position)) {
+            return 0;
+        }
+        return active_page_per_position_[static_cast<uint32_t>(a_position)].value_or(0);
+    }
+
+    uint32_t page_cycle::get_next_page_position(const position_type a_position,
+        const uint32_t a_max_page_count) const {
+        if (!is_valid(a_position)) {
+            return 0;
+        }
+        if (const auto& current = active_page_per_position_[static_cast<uint32_t>(a_position)];
+            current && *current < a_max_page_count - 1) {
+            return *current + 1;
+        }
+        return 0;
+    }
+
+    void page_cycle::set_highest_page_position(const int a_page, const position_type a_position) {
+        if (is_valid(a_position)) {
+            highest_set_page_per_position_[static_cast<uint32_t>(a_position)] = a_page;
+        }
+    }
+
+    int page_cycle::get_highest_page_position(const position_type a_position) const {
+        if (!is_valid(a_position)) {
+            return -1;
+        }
+        return highest_set_page_per_position_[static_cast<uint32_t>(a_position)];
+    }
+
+    uint32_t page_cycle::get_next_non_empty_page_position(const position_type a_position,
+        const uint32_t a_max_page_count) const {
+        const auto next = static_cast<int>(get_next_page_position(a_position, a_max_page_count));
+        if (next > get_highest_page_position(a_position)) {
+            return 0;
+        }
+        return static_cast<uint32_t>(next);
+    }
+
+    bool page_cycle::is_valid(const position_type a_position) { return a_position < position_type::total; }
+}
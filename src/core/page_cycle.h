@@ -0,0 +1,33 @@
+#pragma once
+#include "position.h"
+#include <array>
+#include <optional>
+
+namespace core {
+    //which page is active, for all positions at once or per position in elden mode, and where cycling goes next
+    class page_cycle {
+    public:
+        void set_active_page(uint32_t a_page);
+        [[nodiscard]] uint32_t get_active_page() const;
+        //wraps to 0 after the last page
+        [[nodiscard]] uint32_t get_next_page(uint32_t a_max_page_count) const;
+
+        void set_active_page_position(uint32_t a_page, position_type a_position);
+        [[nodiscard]] uint32_t get_active_page_position(position_type a_position) const;
+        [[nodiscard]] uint32_t get_next_page_position(position_type a_position, uint32_t a_max_page_count) const;
+
+        //-1 as long as nothing is set for the position
+        void set_highest_page_position(int a_page, position_type a_position);
+        [[nodiscard]] int get_highest_page_position(position_type a_position) const;
+        //pages are consecutive from 0, so after the highest set one it goes back to 0
+        [[nodiscard]] uint32_t get_next_non_empty_page_position(position_type a_position,
+            uint32_t a_max_page_count) const;
+
+    private:
+        static bool is_valid(position_type a_position);
+
+        uint32_t active_page_ = 0;
+        std::array<std::optional<uint32_t>, position_count> active_page_per_position_;
+        std::array<int, position_count> highest_set_page_per_position_ = { -1, -1, -1, -1 };
+    };
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <cstdint>
+
+namespace core {
+    //the four slots of the hud, total is used for "none" and for the ammo slot
+    enum class position_type : std::uint32_t { top = 0, right = 1, bottom = 2, left = 3, total = 4 };
+
+    constexpr uint32_t position_count = static_cast<uint32_t>(position_type::total);
+
+    constexpr uint32_t draw_full = 255;
+}
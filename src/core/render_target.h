@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+
+namespace core {
+    //the drawing calls the hud is made of, the plugin draws them with imgui
+    class render_target {
+    public:
+        virtual ~render_target() = default;
+
+        virtual void draw_slot(float a_x,
+            float a_y,
+            float a_scale_x,
+            float a_scale_y,
+            float a_offset_x,
+            float a_offset_y,
+            uint32_t a_modify,
+            uint32_t a_alpha) = 0;
+        virtual void draw_icon(float a_x,
+            float a_y,
+            float a_scale_x,
+            float a_scale_y,
+            float a_offset_x,
+            float a_offset_y,
+            uint32_t a_icon_type,
+            uint32_t a_alpha) = 0;
+        virtual void draw_text(float a_x,
+            float a_y,
+            float a_offset_x,
+            float a_offset_y,
+            float a_offset_extra_x,
+            float a_offset_extra_y,
+            const char* a_text,
+            uint32_t a_alpha,
+            uint32_t a_red,
+            uint32_t a_green,
+            uint32_t a_blue,
+            float a_font_size,
+            bool a_center_text,
+            bool a_deduct_text_x,
+            bool a_deduct_text_y,
+            bool a_add_text_x,
+            bool a_add_text_y) = 0;
+    };
+}
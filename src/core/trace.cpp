@@ -0,0 +1,191 @@
+#include "trace.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+
+namespace core {
+    constexpr std::array<uint8_t, 4> trace_magic = { 'L', 'T', 'H', 'T' };
+
+    enum item_flag : uint8_t { potion = 1 << 0, dynamic = 1 << 1 };
+
+    static void write_varint(uint64_t a_value, std::vector<uint8_t>& a_out) {
+        while (a_value >= 0x80) {
+            a_out.push_back(static_cast<uint8_t>(a_value | 0x80));
+            a_value >>= 7;
+        }
+        a_out.push_back(static_cast<uint8_t>(a_value));
+    }
+
+    //small negative changes stay small
+    static uint64_t zigzag(const int32_t a_value) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(a_value)) << 1) ^ (a_value < 0 ? 0xFFFFFFFFFFFFFFFF : 0);
+    }
+
+    static int32_t unzigzag(const uint64_t a_value) {
+        return static_cast<int32_t>(static_cast<uint32_t>(a_value >> 1) ^ (0u - static_cast<uint32_t>(a_value & 1)));
+    }
+
+    void trace_writer::write_header(std::vector<uint8_t>& a_out) {
+        a_out.insert(a_out.end(), trace_magic.begin(), trace_magic.end());
+        a_out.push_back(version);
+    }
+
+    void trace_writer::write(const trace_event& a_event, std::vector<uint8_t>& a_out) {
+        a_out.push_back(static_cast<uint8_t>(a_event.type));
+        write_varint(a_event.time >= last_time_ ? a_event.time - last_time_ : 0, a_out);
+        last_time_ = std::max(last_time_, a_event.time);
+
+        switch (a_event.type) {
+            case trace_event_type::key:
+                a_out.push_back(static_cast<uint8_t>(a_event.device));
+                write_varint(a_event.id_code, a_out);
+                a_out.push_back(static_cast<uint8_t>(a_event.state));
+                break;
+            case trace_event_type::inventory: {
+                const auto& item = a_event.item;
+                const auto is_potion = item.potion_group != no_potion_group;
+                write_varint(item.id, a_out);
+                write_varint(zigzag(item.count), a_out);
+                a_out.push_back(static_cast<uint8_t>((is_potion ? item_flag::potion : 0) |
+                                                     (item.dynamic ? item_flag::dynamic : 0)));
+                if (is_potion) {
+                    write_varint(item.potion_group, a_out);
+                    const auto amount = std::bit_cast<uint32_t>(item.restore_amount);
+                    for (auto i = 0; i < 4; ++i) {
+                        a_out.push_back(static_cast<uint8_t>(amount >> (i * 8)));
+                    }
+                }
+                break;
+            }
+            case trace_event_type::equip:
+                write_varint(a_event.form, a_out);
+                a_out.push_back(a_event.equipped ? 1 : 0);
+                break;
+            case trace_event_type::menu:
+                a_out.push_back(a_event.opening ? 1 : 0);
+                write_varint(a_event.menu_name.size(), a_out);
+                a_out.insert(a_out.end(), a_event.menu_name.begin(), a_event.menu_name.end());
+                break;
+            case trace_event_type::binding:
+                write_varint(a_event.key, a_out);
+                write_varint(a_event.roles, a_out);
+                a_out.push_back(static_cast<uint8_t>(a_event.position));
+                break;
+        }
+    }
+
+    bool trace_reader::read_header(std::string& a_error) {
+        if (data_.size() < trace_magic.size() + 1 ||
+            std::memcmp(data_.data(), trace_magic.data(), trace_magic.size()) != 0) {
+            a_error = "not a trace file";
+            return false;
+        }
+        if (const auto file_version = data_[trace_magic.size()]; file_version != trace_writer::version) {
+            a_error = "trace version " + std::to_string(file_version) + " is not supported";
+            return false;
+        }
+        offset_ = trace_magic.size() + 1;
+        return true;
+    }
+
+    bool trace_reader::next(trace_event& a_event) {
+        if (offset_ >= data_.size()) {
+            return false;
+        }
+
+        uint8_t type = 0;
+        uint64_t delta = 0;
+        auto ok = read_byte(type) && read_varint(delta);
+        a_event.type = static_cast<trace_event_type>(type);
+        last_time_ += delta;
+        a_event.time = last_time_;
+
+        uint8_t byte = 0;
+        switch (a_event.type) {
+            case trace_event_type::key:
+                ok = ok && read_byte(byte);
+                a_event.device = static_cast<input_device>(byte);
+                ok = ok && read_varint_as(a_event.id_code) && read_byte(byte);
+                a_event.state = static_cast<key_state>(byte);
+                break;
+            case trace_event_type::inventory: {
+                auto& item = a_event.item;
+                uint64_t count = 0;
+                ok = ok && read_varint_as(item.id) && read_varint(count) && read_byte(byte);
+                item.count = unzigzag(count);
+                item.dynamic = (byte & item_flag::dynamic) != 0;
+                item.potion_group = no_potion_group;
+                item.restore_amount = 0.f;
+                if (ok && (byte & item_flag::potion) != 0) {
+                    uint32_t amount = 0;
+                    ok = read_varint_as(item.potion_group);
+                    for (auto i = 0; ok && i < 4; ++i) {
+                        ok = read_byte(byte);
+                        amount |= static_cast<uint32_t>(byte) << (i * 8);
+                    }
+                    item.restore_amount = std::bit_cast<float>(amount);
+                }
+                break;
+            }
+            case trace_event_type::equip:
+                ok = ok && read_varint_as(a_event.form) && read_byte(byte);
+                a_event.equipped = byte != 0;
+                break;
+            case trace_event_type::menu: {
+                uint64_t length = 0;
+                ok = ok && read_byte(byte) && read_varint(length) && length <= data_.size() - offset_;
+                a_event.opening = byte != 0;
+                if (ok) {
+                    a_event.menu_name.assign(reinterpret_cast<const char*>(data_.data() + offset_),
+                        static_cast<size_t>(length));
+                    offset_ += static_cast<size_t>(length);
+                }
+                break;
+            }
+            case trace_event_type::binding:
+                ok = ok && read_varint_as(a_event.key) && read_varint_as(a_event.roles) && read_byte(byte);
+                a_event.position = static_cast<position_type>(byte);
+                break;
+            default:
+                ok = false;
+                break;
+        }
+
+        failed_ = !ok;
+        return ok;
+    }
+
+    bool trace_reader::read_byte(uint8_t& a_value) {
+        if (offset_ >= data_.size()) {
+            return false;
+        }
+        a_value = data_[offset_++];
+        return true;
+    }
+
+    bool trace_reader::read_varint(uint64_t& a_value) {
+        a_value = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = 0;
+            if (!read_byte(byte)) {
+                return false;
+            }
+            a_value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <class T>
+    bool trace_reader::read_varint_as(T& a_value) {
+        uint64_t value = 0;
+        if (!read_varint(value)) {
+            return false;
+        }
+        a_value = static_cast<T>(value);
+        return true;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "inventory_source.h"
+#include "key_code.h"
+#include "position.h"
+#include <span>
+#include <string>
+#include <vector>
+
+namespace core {
+    //what the plugin got from the game, in the order it got it. small enough to keep a long session in a file,
+    //every number is a varint and the time is the distance to the event before
+    enum class trace_event_type : uint8_t { key = 0, inventory = 1, equip = 2, menu = 3, binding = 4 };
+
+    //held is not recorded, the hud only acts on the edges
+    enum class key_state : uint8_t { down = 0, up = 1 };
+
+    struct trace_event {
+        trace_event_type type = trace_event_type::key;
+        //microseconds since the recording started
+        uint64_t time = 0;
+
+        //key, the raw id code, it is normalized like ProcessEvent does it
+        input_device device = input_device::keyboard;
+        uint32_t id_code = 0;
+        key_state state = key_state::down;
+
+        //inventory, count is the change
+        item_record item;
+
+        //equip
+        form_id form = 0;
+        bool equipped = false;
+
+        //menu
+        std::string menu_name;
+        bool opening = false;
+
+        //binding, one entry of the key table, written whenever the table is built
+        uint32_t key = 0;
+        uint32_t roles = 0;
+        position_type position = position_type::total;
+    };
+
+    class trace_writer {
+    public:
+        static constexpr uint8_t version = 1;
+
+        //a trace starts with it, a new file needs it once
+        static void write_header(std::vector<uint8_t>& a_out);
+        void write(const trace_event& a_event, std::vector<uint8_t>& a_out);
+
+    private:
+        uint64_t last_time_ = 0;
+    };
+
+    class trace_reader {
+    public:
+        explicit trace_reader(std::span<const uint8_t> a_data) : data_(a_data) {}
+
+        bool read_header(std::string& a_error);
+        //false at the end or if the rest is cut off, failed() tells which
+        bool next(trace_event& a_event);
+        [[nodiscard]] bool failed() const { return failed_; }
+
+    private:
+        bool read_byte(uint8_t& a_value);
+        bool read_varint(uint64_t& a_value);
+        template <class T>
+        bool read_varint_as(T& a_value);
+
+        std::span<const uint8_t> data_;
+        size_t offset_ = 0;
+        uint64_t last_time_ = 0;
+        bool failed_ = false;
+    };
+}
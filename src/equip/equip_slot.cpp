@@ -28,7 +28,7 @@ namespace equip {
         const auto is_worn = is_item_worn(a_obj, a_player);
         if (is_worn) {
             a_actor_equip_manager->UnequipObject(a_player, a_obj);
-            logger::trace("unequipped {} armor"sv, a_obj->GetName());
+            LOG_TRACE("unequipped {} armor"sv, a_obj->GetName());
         }
         return is_worn;
     }
@@ -50,7 +50,7 @@ namespace equip {
         }
 
         if (equipped_object) {
-            logger::debug("Object {} is equipped, is left {}."sv,
+            LOG_DEBUG("Object {} is equipped, is left {}."sv,
                 equipped_object->GetName(),
                 a_slot == get_left_hand_slot());
             bool did_call = false;
@@ -78,7 +78,7 @@ namespace equip {
                 did_call = true;
             }
 
-            logger::trace("called un equip for {}, left {}, did call {}"sv,
+            LOG_TRACE("called un equip for {}, left {}, did call {}"sv,
                 equipped_object->GetName(),
                 a_slot == get_left_hand_slot(),
                 did_call);
@@ -116,7 +116,7 @@ namespace equip {
     void equip_slot::un_equip_shout_slot(RE::PlayerCharacter*& a_player) {
         auto* selected_power = a_player->GetActorRuntimeData().selectedPower;
         if (selected_power) {
-            logger::trace("Equipped form is {}, try to un equip"sv,
+            LOG_TRACE("Equipped form is {}, try to un equip"sv,
                 util::string_util::int_to_hex(selected_power->formID));
             if (selected_power->Is(RE::FormType::Shout)) {
                 equip::equip_slot::un_equip_shout(nullptr, 0, a_player, selected_power->As<RE::TESShout>());
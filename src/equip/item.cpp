@@ -1,6 +1,7 @@
 ﻿#include "item.h"
 #include "equip_slot.h"
 #include "handle/extra_data_holder.h"
+#include "handle/item_count_handle.h"
 #include "setting/mcm_setting.h"
 #include "util/constant.h"
 #include "util/helper.h"
@@ -14,10 +15,10 @@ namespace equip {
         RE::PlayerCharacter*& a_player,
         handle::slot_setting::slot_type a_type) {
         auto left = a_slot == equip_slot::get_left_hand_slot();
-        logger::trace("try to equip {}, left {}, type {}"sv, a_form->GetName(), left, static_cast<uint32_t>(a_type));
+        LOG_TRACE("try to equip {}, left {}, type {}"sv, a_form->GetName(), left, static_cast<uint32_t>(a_type));
 
         if (a_form->formID == util::unarmed) {
-            logger::trace("Got unarmed, try to call un equip"sv);
+            LOG_TRACE("Got unarmed, try to call un equip"sv);
             equip_slot::un_equip_hand(a_slot, a_player, handle::slot_setting::action_type::un_equip);
             return;
         }
@@ -25,48 +26,36 @@ namespace equip {
         RE::TESBoundObject* obj = nullptr;
         RE::ExtraDataList* extra = nullptr;
         std::vector<RE::ExtraDataList*> extra_vector;
-        std::map<RE::TESBoundObject*, std::pair<int, std::unique_ptr<RE::InventoryEntryData>>> potential_items;
-        if (a_type == handle::slot_setting::slot_type::weapon) {
-            if (!a_form->Is(RE::FormType::Weapon)) {
-                logger::warn("object {} is not a weapon. return."sv, a_form->GetName());
-                return;
-            }
-            potential_items = util::player::get_inventory(a_player, RE::FormType::Weapon);
-        } else if (a_type == handle::slot_setting::slot_type::shield) {
-            if (!a_form->Is(RE::FormType::Armor)) {
-                logger::warn("object {} is not an armor. return."sv, a_form->GetName());
-                return;
-            }
-            potential_items = util::player::get_inventory(a_player, RE::FormType::Armor);
-        } else if (a_type == handle::slot_setting::slot_type::light) {
-            if (!a_form->Is(RE::FormType::Light)) {
-                logger::warn("object {} is not a light. return."sv, a_form->GetName());
-                return;
-            }
-            potential_items = util::player::get_inventory(a_player, RE::FormType::Light);
+        if (a_type == handle::slot_setting::slot_type::weapon && !a_form->Is(RE::FormType::Weapon)) {
+            logger::warn("object {} is not a weapon. return."sv, a_form->GetName());
+            return;
+        }
+        if (a_type == handle::slot_setting::slot_type::shield && !a_form->Is(RE::FormType::Armor)) {
+            logger::warn("object {} is not an armor. return."sv, a_form->GetName());
+            return;
+        }
+        if (a_type == handle::slot_setting::slot_type::light && !a_form->Is(RE::FormType::Light)) {
+            logger::warn("object {} is not a light. return."sv, a_form->GetName());
+            return;
         }
 
         auto item_count = 0;
-        for (const auto& [item, inv_data] : potential_items) {
-            if (const auto& [num_items, entry] = inv_data; entry->object->formID == a_form->formID) {
-                obj = item;
-                item_count = num_items;
-                auto simple_extra_data_list = entry->extraLists;
-                if (simple_extra_data_list) {
-                    for (auto* extra_data : *simple_extra_data_list) {
-                        extra = extra_data;
-                        auto worn_right = extra_data->HasType(RE::ExtraDataType::kWorn);
-                        auto worn_left = extra_data->HasType(RE::ExtraDataType::kWornLeft);
-                        logger::trace("extra data {}, worn right {}, worn left {}"sv,
-                            extra_data->GetCount(),
-                            worn_right,
-                            worn_left);
-                        if (!worn_right && !worn_left) {
-                            extra_vector.push_back(extra_data);
-                        }
+        if (const auto [object, count, entry] = util::player::get_inventory_item(a_player, a_form); count > 0) {
+            obj = object;
+            item_count = count;
+            if (auto* simple_extra_data_list = entry ? entry->extraLists : nullptr; simple_extra_data_list) {
+                for (auto* extra_data : *simple_extra_data_list) {
+                    extra = extra_data;
+                    auto worn_right = extra_data->HasType(RE::ExtraDataType::kWorn);
+                    auto worn_left = extra_data->HasType(RE::ExtraDataType::kWornLeft);
+                    LOG_TRACE("extra data {}, worn right {}, worn left {}"sv,
+                        extra_data->GetCount(),
+                        worn_right,
+                        worn_left);
+                    if (!worn_right && !worn_left) {
+                        extra_vector.push_back(extra_data);
                     }
                 }
-                break;
             }
         }
 
@@ -88,34 +77,34 @@ namespace equip {
                 extra = extra_vector.back();
                 extra_vector.pop_back();  //remove last item, because we already use that
                 extra_handler->init_extra_data(a_form, extra_vector);
-                logger::trace("set {} extra data for form {}"sv, extra_vector.size(), a_form->GetName());
+                LOG_TRACE("set {} extra data for form {}"sv, extra_vector.size(), a_form->GetName());
             }
         }
 
         const auto* obj_right = a_player->GetActorRuntimeData().currentProcess->GetEquippedRightHand();
         const auto* obj_left = a_player->GetActorRuntimeData().currentProcess->GetEquippedLeftHand();
         if (left && obj_left && obj_left->formID == obj->formID) {
-            logger::debug("Object Left {} is already where it should be already equipped. return."sv, obj->GetName());
+            LOG_DEBUG("Object Left {} is already where it should be already equipped. return."sv, obj->GetName());
             return;
         }
 
         if (!left && obj_right && obj_right->formID == obj->formID) {
-            logger::debug("Object Right {} is already where it should be already equipped. return."sv, obj->GetName());
+            LOG_DEBUG("Object Right {} is already where it should be already equipped. return."sv, obj->GetName());
             return;
         }
 
         auto equipped_count = 0;
         if (obj_right && obj_right->formID == obj->formID) {
             equipped_count++;
-            logger::debug("Object {} already equipped."sv, obj->GetName());
+            LOG_DEBUG("Object {} already equipped."sv, obj->GetName());
         }
 
         if (obj_left && obj_left->formID == obj->formID) {
             equipped_count++;
-            logger::debug("Object {} already equipped."sv, obj->GetName());
+            LOG_DEBUG("Object {} already equipped."sv, obj->GetName());
         }
 
-        logger::trace("Got a count of {} in the Inventory {}, Equipped {}"sv,
+        LOG_TRACE("Got a count of {} in the Inventory {}, Equipped {}"sv,
             obj->GetName(),
             item_count,
             equipped_count);
@@ -127,26 +116,21 @@ namespace equip {
             return;
         }
 
-        logger::trace("try to equip weapon/shield/light {}"sv, a_form->GetName());
-        auto* task = SKSE::GetTaskInterface();
-        if (task) {
-            task->AddTask(
-                [=]() { RE::ActorEquipManager::GetSingleton()->EquipObject(a_player, obj, extra, 1, a_slot); });
-        }
-        logger::trace("equipped weapon/shield/light {}, left {}. return."sv, a_form->GetName(), left);
+        LOG_TRACE("try to equip weapon/shield/light {}"sv, a_form->GetName());
+        //we run in the task of the action queue already
+        RE::ActorEquipManager::GetSingleton()->EquipObject(a_player, obj, extra, 1, a_slot);
+        LOG_TRACE("equipped weapon/shield/light {}, left {}. return."sv, a_form->GetName(), left);
     }
 
     void item::equip_armor(const RE::TESForm* a_form, RE::PlayerCharacter*& a_player) {
-        logger::trace("try to equip {}"sv, a_form->GetName());
+        LOG_TRACE("try to equip {}"sv, a_form->GetName());
 
         RE::TESBoundObject* obj = nullptr;
         auto item_count = 0;
-        for (const auto& [item, inv_data] : util::player::get_inventory(a_player, RE::FormType::Armor)) {
-            if (const auto& [num_items, entry] = inv_data; entry->object->formID == a_form->formID) {
-                obj = entry->object;
-                item_count = num_items;
-                break;
-            }
+        if (const auto [object, count, entry] = util::player::get_inventory_item(a_player, a_form);
+            count > 0 && a_form->IsArmor()) {
+            obj = object;
+            item_count = count;
         }
 
         if (!obj || item_count == 0) {
@@ -154,27 +138,24 @@ namespace equip {
             //update ui in this case
             return;
         }
-        logger::trace("try to equip armor/clothing {}"sv, a_form->GetName());
+        LOG_TRACE("try to equip armor/clothing {}"sv, a_form->GetName());
 
         if (auto* equip_manager = RE::ActorEquipManager::GetSingleton();
             !equip_slot::un_equip_if_equipped(obj, a_player, equip_manager)) {
             equip_manager->EquipObject(a_player, obj);
-            logger::trace("equipped armor {}. return."sv, a_form->GetName());
+            LOG_TRACE("equipped armor {}. return."sv, a_form->GetName());
         }
     }
 
     void item::consume_potion(const RE::TESForm* a_form, RE::PlayerCharacter*& a_player) {
-        logger::trace("try to consume {}"sv, a_form->GetName());
+        LOG_TRACE("try to consume {}"sv, a_form->GetName());
 
         RE::TESBoundObject* obj = nullptr;
         uint32_t left = 0;
-        for (auto potential_items = util::player::get_inventory(a_player, RE::FormType::AlchemyItem);
-             const auto& [item, inv_data] : potential_items) {
-            if (const auto& [num_items, entry] = inv_data; entry->object->formID == a_form->formID) {
-                obj = item;
-                left = num_items;
-                break;
-            }
+        if (const auto [object, count, entry] = util::player::get_inventory_item(a_player, a_form);
+            count > 0 && a_form->Is(RE::FormType::AlchemyItem)) {
+            obj = object;
+            left = count;
         }
 
         if (config::mcm_setting::get_prevent_consumption_of_last_dynamic_potion() && obj && obj->IsDynamicForm() &&
@@ -199,27 +180,24 @@ namespace equip {
         auto* alchemy_item = obj->As<RE::AlchemyItem>();
         if (alchemy_item->IsPoison()) {
             poison_weapon(a_player, alchemy_item, left);
-            logger::trace("Is a poison, I am done here. return.");
+            LOG_TRACE("Is a poison, I am done here. return.");
             return;
         }
 
-        logger::trace("calling drink/eat potion/food {}, count left {}"sv, obj->GetName(), left);
+        LOG_TRACE("calling drink/eat potion/food {}, count left {}"sv, obj->GetName(), left);
         RE::ActorEquipManager::GetSingleton()->EquipObject(a_player, obj);
-        logger::trace("drank/ate potion/food {}. return."sv, obj->GetName());
+        LOG_TRACE("drank/ate potion/food {}. return."sv, obj->GetName());
     }
 
     void item::equip_ammo(const RE::TESForm* a_form, RE::PlayerCharacter*& a_player) {
-        logger::trace("try to equip {}"sv, a_form->GetName());
+        LOG_TRACE("try to equip {}"sv, a_form->GetName());
 
         RE::TESBoundObject* obj = nullptr;
         auto left = 0;
-        for (auto potential_items = util::player::get_inventory(a_player, RE::FormType::Ammo);
-             const auto& [item, inv_data] : potential_items) {
-            if (const auto& [num_items, entry] = inv_data; entry->object->formID == a_form->formID) {
-                obj = item;
-                left = num_items;
-                break;
-            }
+        if (const auto [object, count, entry] = util::player::get_inventory_item(a_player, a_form);
+            count > 0 && a_form->Is(RE::FormType::Ammo)) {
+            obj = object;
+            left = count;
         }
 
         if (!obj || left == 0) {
@@ -229,19 +207,16 @@ namespace equip {
 
         if (const auto* current_ammo = a_player->GetCurrentAmmo();
             current_ammo && current_ammo->formID == obj->formID) {
-            logger::debug("Ammo {} already equipped, return."sv, obj->GetName());
+            LOG_DEBUG("Ammo {} already equipped, return."sv, obj->GetName());
             return;
         }
 
-        auto* task = SKSE::GetTaskInterface();
-        if (task) {
-            task->AddTask([=]() { RE::ActorEquipManager::GetSingleton()->EquipObject(a_player, obj); });
-        }
-        logger::trace("equipped {}. return."sv, obj->GetName());
+        RE::ActorEquipManager::GetSingleton()->EquipObject(a_player, obj);
+        LOG_TRACE("equipped {}. return."sv, obj->GetName());
     }
 
     void item::un_equip_ammo() {
-        logger::debug("check if we need to un equip ammo"sv);
+        LOG_DEBUG("check if we need to un equip ammo"sv);
         auto player = RE::PlayerCharacter::GetSingleton();
 
         auto* obj = player->GetCurrentAmmo();
@@ -253,9 +228,9 @@ namespace equip {
         if (ammo->GetRuntimeData().data.flags.all(RE::AMMO_DATA::Flag::kNonBolt) ||
             ammo->GetRuntimeData().data.flags.none(RE::AMMO_DATA::Flag::kNonBolt)) {
             RE::ActorEquipManager::GetSingleton()->UnequipObject(player, ammo);
-            logger::trace("Called to un equip {}"sv, ammo->GetName());
+            LOG_TRACE("Called to un equip {}"sv, ammo->GetName());
         }
-        logger::trace("Done work. return"sv);
+        LOG_TRACE("Done work. return"sv);
     }
 
     void item::find_and_consume_fitting_option(RE::ActorValue a_actor_value, RE::PlayerCharacter*& a_player) {
@@ -266,7 +241,7 @@ namespace equip {
             a_player->GetActorValueModifier(RE::ACTOR_VALUE_MODIFIER::kTemporary, RE::ActorValue::kHealth);
         auto max_actor_value = permanent_actor_value + temporary_actor_value;
         auto missing = max_actor_value - current_actor_value;
-        logger::trace("actor value {}, current {}, max {}, missing {}"sv,
+        LOG_TRACE("actor value {}, current {}, max {}, missing {}"sv,
             static_cast<int>(a_actor_value),
             fmt::format(FMT_STRING("{:.2f}"), current_actor_value),
             fmt::format(FMT_STRING("{:.2f}"), max_actor_value),
@@ -275,56 +250,19 @@ namespace equip {
         //min heal, max heal
         auto min_perfect = config::mcm_setting::get_potion_min_perfect();
         auto max_perfect = config::mcm_setting::get_potion_max_perfect();
-        logger::trace("min perfect {}, max perfect {}, missing {}"sv,
+        LOG_TRACE("min perfect {}, max perfect {}, missing {}"sv,
             fmt::format(FMT_STRING("{:.2f}"), missing * min_perfect),
             fmt::format(FMT_STRING("{:.2f}"), missing * max_perfect),
             fmt::format(FMT_STRING("{:.2f}"), missing));
 
-        RE::TESBoundObject* obj = nullptr;
-        for (auto potential_items = util::player::get_inventory(a_player, RE::FormType::AlchemyItem);
-             const auto& [item, inv_data] : potential_items) {
-            const auto& [num_items, entry] = inv_data;
-
-            auto* alchemy_item = item->As<RE::AlchemyItem>();
-            if (alchemy_item->IsPoison() || alchemy_item->IsFood()) {
-                continue;
-            }
-            //returns currently only the types we want
-            auto actor_value = util::helper::get_actor_value_effect_from_potion(item);
-            if (actor_value == RE::ActorValue::kNone) {
-                continue;
-            }
-
-            if (actor_value == a_actor_value) {
-                //set obj here, because if we do not have a perfect hit, we still need to consume something
-                if (config::mcm_setting::get_prevent_consumption_of_last_dynamic_potion() &&
-                    alchemy_item->IsDynamicForm() && num_items == 1) {
-                    logger::warn(
-                        "Somehow the game crashes on potions with dynamic id if the count is 0 (happens with or without the mod). So I am not consuming it. Form {}, Name {}"sv,
-                        util::string_util::int_to_hex(alchemy_item->formID),
-                        alchemy_item->GetName());
-                    continue;
-                }
-                obj = alchemy_item;
-
-                auto magnitude = alchemy_item->GetCostliestEffectItem()->GetMagnitude();
-                auto duration = alchemy_item->GetCostliestEffectItem()->GetDuration();
-                if (duration == 0) {
-                    duration = 1;
-                }
-
-                auto max_healed = magnitude * duration;
-                if (max_healed >= (missing * min_perfect) && max_healed <= (missing * max_perfect)) {
-                    logger::trace("found potion {}, magnitude * duration {}"sv,
-                        obj->GetName(),
-                        fmt::format(FMT_STRING("{:.2f}"), max_healed));
-                    break;
-                }
-            }
-        }
+        RE::TESBoundObject* obj = handle::item_count_handle::get_singleton()->get_fitting_potion(a_actor_value,
+            missing,
+            min_perfect,
+            max_perfect,
+            config::mcm_setting::get_prevent_consumption_of_last_dynamic_potion());
 
         if (obj) {
-            logger::trace("calling to consume potion {}"sv, obj->GetName());
+            LOG_TRACE("calling to consume potion {}"sv, obj->GetName());
             consume_potion(obj, a_player);
         } else {
             logger::warn("No suitable potion found. return.");
@@ -332,7 +270,7 @@ namespace equip {
     }
 
     void item::poison_weapon(RE::PlayerCharacter*& a_player, RE::AlchemyItem*& a_poison, uint32_t a_count) {
-        logger::trace("try to apply poison to weapon, count left {}"sv, a_count);
+        LOG_TRACE("try to apply poison to weapon, count left {}"sv, a_count);
         uint32_t potion_doses = 1;
         /* it works for vanilla and adamant
             * vanilla does a basic set value to 3
@@ -351,7 +289,7 @@ namespace equip {
                 potion_doses = static_cast<int>(perk_visit.get_result());
             }
         }
-        logger::trace("Poison dose set value is {}"sv, potion_doses);
+        LOG_TRACE("Poison dose set value is {}"sv, potion_doses);
 
         RE::BGSSoundDescriptor* sound_descriptor;
         if (a_poison->data.consumptionSound) {
@@ -364,7 +302,7 @@ namespace equip {
         //check count here as well, since we need max 2
         auto* equipped_object = a_player->GetEquippedEntryData(false);
         if (equipped_object && equipped_object->object->IsWeapon() && !equipped_object->IsPoisoned()) {
-            logger::trace("try to add poison {} to right {}"sv, a_poison->GetName(), equipped_object->GetDisplayName());
+            LOG_TRACE("try to add poison {} to right {}"sv, a_poison->GetName(), equipped_object->GetDisplayName());
             equipped_object->PoisonObject(a_poison, potion_doses);
             util::player::play_sound(sound_descriptor, a_player);
             a_player->RemoveItem(a_poison, 1, RE::ITEM_REMOVE_REASON::kRemove, nullptr, nullptr);
@@ -374,7 +312,7 @@ namespace equip {
         auto* equipped_object_left = a_player->GetEquippedEntryData(true);
         if (equipped_object_left && equipped_object_left->object->IsWeapon() && !equipped_object_left->IsPoisoned() &&
             a_count > 0) {
-            logger::trace("try to add poison {} to left {}"sv,
+            LOG_TRACE("try to add poison {} to left {}"sv,
                 a_poison->GetName(),
                 equipped_object_left->GetDisplayName());
             equipped_object_left->PoisonObject(a_poison, potion_doses);
@@ -11,7 +11,7 @@ namespace equip {
         const RE::BGSEquipSlot* a_slot,
         RE::PlayerCharacter*& a_player) {
         auto left = a_slot == equip_slot::get_left_hand_slot();
-        logger::trace("try to work spell {}, action {}, left {}"sv,
+        LOG_TRACE("try to work spell {}, action {}, left {}"sv,
             a_form->GetName(),
             static_cast<uint32_t>(a_action),
             left);
@@ -30,7 +30,7 @@ namespace equip {
 
         //maybe check if the spell is already equipped
         auto casting_type = spell->GetCastingType();
-        logger::trace("spell {} is type {}"sv, spell->GetName(), static_cast<uint32_t>(casting_type));
+        LOG_TRACE("spell {} is type {}"sv, spell->GetName(), static_cast<uint32_t>(casting_type));
         if (a_action == action_type::instant && casting_type != RE::MagicSystem::CastingType::kConcentration) {
             if (config::mcm_setting::get_elden_demon_souls()) {
                 auto selected_power = a_player->GetActorRuntimeData().selectedPower;
@@ -47,7 +47,7 @@ namespace equip {
 
             //might cost nothing if nothing has been equipped into tha hands after start, so it seems
             auto cost = spell->CalculateMagickaCost(actor);
-            logger::trace("spell cost for {} is {}"sv, spell->GetName(), fmt::format(FMT_STRING("{:.2f}"), cost));
+            LOG_TRACE("spell cost for {} is {}"sv, spell->GetName(), fmt::format(FMT_STRING("{:.2f}"), cost));
 
             auto current_magicka = actor->AsActorValueOwner()->GetActorValue(RE::ActorValue::kMagicka);
             auto dual_cast = false;
@@ -55,7 +55,7 @@ namespace equip {
                 config::mcm_setting::get_elden_demon_souls()) {
                 auto* game_setting = RE::GameSettingCollection::GetSingleton();
                 auto dual_cast_cost_multiplier = game_setting->GetSetting("fMagicDualCastingCostMult")->GetFloat();
-                logger::trace("dual cast, multiplier {}"sv,
+                LOG_TRACE("dual cast, multiplier {}"sv,
                     fmt::format(FMT_STRING("{:.2f}"), dual_cast_cost_multiplier));
                 dual_cast = can_dual_cast(cost, current_magicka, dual_cast_cost_multiplier);
                 if (dual_cast) {
@@ -63,7 +63,7 @@ namespace equip {
                     caster->SetDualCasting(true);
                 }
             }
-            logger::trace("got temp magicka {}, cost {}, can dual cast {}"sv, current_magicka, cost, dual_cast);
+            LOG_TRACE("got temp magicka {}, cost {}, can dual cast {}"sv, current_magicka, cost, dual_cast);
 
             if (current_magicka < cost) {
                 if (!RE::UI::GetSingleton()->GetMenu<RE::HUDMenu>()) {
@@ -94,7 +94,7 @@ namespace equip {
             if (auto* effect = spell->GetCostliestEffectItem()) {
                 magnitude = effect->GetMagnitude();
             }
-            logger::trace("casting spell {}, magnitude {}, effectiveness {}"sv,
+            LOG_TRACE("casting spell {}, magnitude {}, effectiveness {}"sv,
                 spell->GetName(),
                 fmt::format(FMT_STRING("{:.2f}"), magnitude),
                 fmt::format(FMT_STRING("{:.2f}"), effectiveness));
@@ -111,28 +111,28 @@ namespace equip {
             const auto* obj_right = a_player->GetActorRuntimeData().currentProcess->GetEquippedRightHand();
             const auto* obj_left = a_player->GetActorRuntimeData().currentProcess->GetEquippedLeftHand();
             if (left && obj_left && obj_left->formID == spell->formID) {
-                logger::debug("Object Left {} is already where it should be already equipped. return."sv,
+                LOG_DEBUG("Object Left {} is already where it should be already equipped. return."sv,
                     spell->GetName());
                 return;
             }
             if (!left && obj_right && obj_right->formID == spell->formID) {
-                logger::debug("Object Right {} is already where it should be already equipped. return."sv,
+                LOG_DEBUG("Object Right {} is already where it should be already equipped. return."sv,
                     spell->GetName());
                 return;
             }
 
-            logger::trace("calling equip spell {}, left {}"sv, spell->GetName(), left);
-            auto* task = SKSE::GetTaskInterface();
-            if (task) {
-                task->AddTask([=]() { RE::ActorEquipManager::GetSingleton()->EquipSpell(a_player, spell, a_slot); });
-            }
+            LOG_TRACE("calling equip spell {}, left {}"sv, spell->GetName(), left);
+            //we run in the task of the action queue already
+            RE::ActorEquipManager::GetSingleton()->EquipSpell(a_player, spell, a_slot);
         }
 
-        logger::trace("worked spell {}, action {}. return."sv, a_form->GetName(), static_cast<uint32_t>(a_action));
+        LOG_TRACE("worked spell {}, action {}. return."sv, a_form->GetName(), static_cast<uint32_t>(a_action));
     }
 
-    void magic::cast_scroll(const RE::TESForm* a_form, action_type a_action, RE::PlayerCharacter*& a_player) {
-        logger::trace("try to work scroll {}, action {}"sv, a_form->GetName(), static_cast<uint32_t>(a_action));
+    void magic::cast_scroll(const RE::TESForm* a_form,
+        action_type a_action,
+        RE::PlayerCharacter*& a_player) {
+        LOG_TRACE("try to work scroll {}, action {}"sv, a_form->GetName(), static_cast<uint32_t>(a_action));
 
         if (!a_form->Is(RE::FormType::Scroll)) {
             logger::warn("object {} is not a scroll. return."sv, a_form->GetName());
@@ -141,13 +141,9 @@ namespace equip {
 
         RE::TESBoundObject* obj = nullptr;
         auto left = 0;
-        for (auto potential_items = util::player::get_inventory(a_player, RE::FormType::Scroll);
-             const auto& [item, inv_data] : potential_items) {
-            if (const auto& [num_items, entry] = inv_data; entry->object->formID == a_form->formID) {
-                obj = item;
-                left = num_items;
-                break;
-            }
+        if (const auto [object, count, entry] = util::player::get_inventory_item(a_player, a_form); count > 0) {
+            obj = object;
+            left = count;
         }
 
         if (!obj || left == 0) {
@@ -162,17 +158,14 @@ namespace equip {
                 ->CastSpellImmediate(scroll, false, actor, 1.0f, false, 0.0f, nullptr);
             actor->RemoveItem(scroll, 1, RE::ITEM_REMOVE_REASON::kRemove, nullptr, nullptr);
         } else {
-            auto* task = SKSE::GetTaskInterface();
-            if (task) {
-                task->AddTask([=]() { RE::ActorEquipManager::GetSingleton()->EquipObject(a_player, obj); });
-            }
+            RE::ActorEquipManager::GetSingleton()->EquipObject(a_player, obj);
         }
 
-        logger::trace("worked scroll {}, action {}. return."sv, a_form->GetName(), static_cast<uint32_t>(a_action));
+        LOG_TRACE("worked scroll {}, action {}. return."sv, a_form->GetName(), static_cast<uint32_t>(a_action));
     }
 
     void magic::equip_or_cast_power(RE::TESForm* a_form, action_type a_action, RE::PlayerCharacter*& a_player) {
-        logger::trace("try to work power {}, action {}"sv, a_form->GetName(), static_cast<uint32_t>(a_action));
+        LOG_TRACE("try to work power {}, action {}"sv, a_form->GetName(), static_cast<uint32_t>(a_action));
 
         if (!a_form->Is(RE::FormType::Spell)) {
             logger::warn("object {} is not a spell. return."sv, a_form->GetName());
@@ -181,12 +174,12 @@ namespace equip {
 
         if (const auto* selected_power = a_player->GetActorRuntimeData().selectedPower;
             selected_power && a_action != handle::slot_setting::action_type::instant) {
-            logger::trace("current selected power is {}, is shout {}, is spell {}"sv,
+            LOG_TRACE("current selected power is {}, is shout {}, is spell {}"sv,
                 selected_power->GetName(),
                 selected_power->Is(RE::FormType::Shout),
                 selected_power->Is(RE::FormType::Spell));
             if (selected_power->formID == a_form->formID) {
-                logger::debug("no need to equip power {}, it is already equipped. return."sv, a_form->GetName());
+                LOG_DEBUG("no need to equip power {}, it is already equipped. return."sv, a_form->GetName());
                 return;
             }
         }
@@ -213,7 +206,7 @@ namespace equip {
             if (auto* effect = spell->GetCostliestEffectItem()) {
                 magnitude = effect->GetMagnitude();
             }
-            logger::trace("casting spell {}, magnitude {}, effectiveness {}"sv,
+            LOG_TRACE("casting spell {}, magnitude {}, effectiveness {}"sv,
                 spell->GetName(),
                 fmt::format(FMT_STRING("{:.2f}"), magnitude),
                 fmt::format(FMT_STRING("{:.2f}"), effectiveness));
@@ -229,11 +222,11 @@ namespace equip {
         } else {
             RE::ActorEquipManager::GetSingleton()->EquipSpell(a_player, spell);
         }
-        logger::trace("worked power {} action {}. return."sv, a_form->GetName(), static_cast<uint32_t>(a_action));
+        LOG_TRACE("worked power {} action {}. return."sv, a_form->GetName(), static_cast<uint32_t>(a_action));
     }
 
     void magic::equip_shout(RE::TESForm* a_form, RE::PlayerCharacter*& a_player) {
-        logger::trace("try to equip shout {}"sv, a_form->GetName());
+        LOG_TRACE("try to equip shout {}"sv, a_form->GetName());
 
         if (!a_form->Is(RE::FormType::Shout)) {
             logger::warn("object {} is not a shout. return."sv, a_form->GetName());
@@ -241,12 +234,12 @@ namespace equip {
         }
 
         if (const auto selected_power = a_player->GetActorRuntimeData().selectedPower; selected_power) {
-            logger::trace("current selected power is {}, is shout {}, is spell {}"sv,
+            LOG_TRACE("current selected power is {}, is shout {}, is spell {}"sv,
                 selected_power->GetName(),
                 selected_power->Is(RE::FormType::Shout),
                 selected_power->Is(RE::FormType::Spell));
             if (selected_power->formID == a_form->formID) {
-                logger::debug("no need to equip shout {}, it is already equipped. return."sv, a_form->GetName());
+                LOG_DEBUG("no need to equip shout {}, it is already equipped. return."sv, a_form->GetName());
                 return;
             }
         }
@@ -258,7 +251,7 @@ namespace equip {
         }
 
         RE::ActorEquipManager::GetSingleton()->EquipShout(a_player, shout);
-        logger::trace("equipped shout {}. return."sv, a_form->GetName());
+        LOG_TRACE("equipped shout {}. return."sv, a_form->GetName());
     }
 
     RE::MagicSystem::CastingSource magic::get_casting_source(const RE::BGSEquipSlot* a_slot) {
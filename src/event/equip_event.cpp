@@ -1,9 +1,11 @@
 ﻿#include "equip_event.h"
+#include "handle/equip_state_handle.h"
 #include "handle/name_handle.h"
+#include "processing/equip_latency.h"
 #include "processing/set_setting_data.h"
 #include "setting/mcm_setting.h"
 #include "util/helper.h"
-#include "util/player/player.h"
+#include "util/trace_recorder.h"
 
 namespace event {
     equip_event* equip_event::get_singleton() {
@@ -18,22 +20,23 @@ namespace event {
         if (!a_event || !a_event->actor || !a_event->actor->IsPlayerRef()) {
             return event_result::kContinue;
         }
+        util::trace_recorder::get_singleton()->record_equip(a_event->baseObject, a_event->equipped);
+        processing::equip_latency::get_singleton()->on_equip_event(a_event->baseObject, a_event->equipped);
 
         auto* form = RE::TESForm::LookupByID(a_event->baseObject);
         if (!form) {
             return event_result::kContinue;
         }
 
-        if (config::mcm_setting::get_draw_current_items_text() &&
-            (form->IsWeapon() || form->Is(RE::FormType::Spell) || form->IsAmmo() || form->Is(RE::FormType::Light))) {
-            handle::name_handle::get_singleton()->init_names(util::player::get_hand_assignment());
+        handle::equip_state_handle::get_singleton()->update();
+
+        //the names are put together when they get drawn, from the state updated above
+        if (form->IsWeapon() || form->Is(RE::FormType::Spell) || form->IsAmmo() || form->Is(RE::FormType::Light)) {
+            handle::name_handle::get_singleton()->set_item_names_dirty();
         }
 
-        if (config::mcm_setting::get_draw_current_shout_text() && form->Is(RE::FormType::Shout) ||
-            form->Is(RE::FormType::Spell)) {
-            // call function there and check selected power, spell trigger and spells as well but that is ok for now
-            handle::name_handle::get_singleton()->init_voice_name(
-                RE::PlayerCharacter::GetSingleton()->GetActorRuntimeData().selectedPower);
+        if (form->Is(RE::FormType::Shout) || form->Is(RE::FormType::Spell)) {
+            handle::name_handle::get_singleton()->set_voice_name_dirty();
         }
 
         //add check if we need to block left
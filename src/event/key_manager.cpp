@@ -2,15 +2,20 @@
 #include "handle/ammo_handle.h"
 #include "handle/extra_data_holder.h"
 #include "handle/page_handle.h"
+#include "processing/cycle_commit.h"
+#include "processing/equip_latency.h"
 #include "processing/game_menu_setting.h"
 #include "processing/setting_execute.h"
 #include "setting/mcm_setting.h"
+#include "ui/hud_model.h"
 #include "ui/ui_renderer.h"
+#include "util/trace_recorder.h"
 
 namespace event {
     using event_result = RE::BSEventNotifyControl;
     using position_type = handle::position_setting::position_type;
     using common = control::common;
+    using key_role = control::binding::key_role;
     using mcm = config::mcm_setting;
     using setting_execute = processing::setting_execute;
 
@@ -33,6 +38,13 @@ namespace event {
             return event_result::kContinue;
         }
 
+        //all of it, the replay checks the menus and bindings itself
+        if (const auto* recorder = util::trace_recorder::get_singleton(); recorder->is_active()) {
+            for (auto* event = *a_event; event; event = event->next) {
+                recorder->record_key(event->AsButtonEvent());
+            }
+        }
+
         //top execute btn is bound to the shout key, no need to check here
         if (!key_binding->keys_configured()) {
             return event_result::kContinue;
@@ -57,6 +69,11 @@ namespace event {
         }
 
         handle::extra_data_holder::get_singleton()->reset_data();
+        //the equips queued for these events are measured from here
+        auto* latency = processing::equip_latency::get_singleton();
+        latency->set_input_time(processing::equip_latency::clock::now());
+        //a key of ours might change what is shown, the hud gets it once all events are handled
+        auto handled = false;
 
         // We might get a list of events to handle.
         for (auto* event = *a_event; event; event = event->next) {
@@ -75,6 +92,13 @@ namespace event {
 
             common::get_key_id(button, key_);
 
+            //one lookup tells us everything the key is bound to, nothing to do for the rest
+            const auto& dispatch = key_binding->get_dispatch(key_);
+            if (dispatch.roles == key_role::none) {
+                continue;
+            }
+            handled = true;
+
             if (const auto* control_map = RE::ControlMap::GetSingleton(); !control_map->IsMovementControlsEnabled()) {
                 continue;
             }
@@ -96,21 +120,16 @@ namespace event {
                 continue;
             }
 
-            //get shout key
-            auto elden = mcm::get_elden_demon_souls();
-            if (elden) {
-                RE::UserEvents* user_events = RE::UserEvents::GetSingleton();
-                key_binding->set_top_execute(control_map->GetMappedKey(user_events->shout, button->device.get()));
-            }
+            //the shout key is part of the dispatch as well, it is looked up when the bindings change
+            const auto elden = key_binding->get_elden();
 
             // These are the buttons for cycling through positional lists.
-            auto is_position_button = key_binding->is_position_button(key_);
-            auto is_showhide_key = common::is_key_valid_and_matches(key_, key_binding->get_hide_show());
-            auto is_power_key = common::is_key_valid_and_matches(key_, key_binding->get_top_execute());
-            auto is_utility_key = key_ == key_binding->get_bottom_action();
-            auto is_toggle_key =
-                common::is_key_valid_and_matches(key_, key_binding->get_bottom_execute_or_toggle_action());
-            auto execute_requires_modifier = mcm::get_bottom_execute_key_combo_only();
+            auto is_position_button = (dispatch.roles & key_role::position_button) != 0;
+            auto is_showhide_key = (dispatch.roles & key_role::hide_show) != 0;
+            auto is_power_key = (dispatch.roles & key_role::top_execute) != 0;
+            auto is_utility_key = (dispatch.roles & key_role::utility) != 0;
+            auto is_toggle_key = (dispatch.roles & key_role::toggle) != 0;
+            auto execute_requires_modifier = key_binding->get_bottom_execute_key_combo_only();
 
             if (mcm::get_hide_outside_combat() && !ui::ui_renderer::get_fade()) {
                 if ((is_position_button || is_toggle_key || (elden && is_power_key)) &&
@@ -120,8 +139,8 @@ namespace event {
             }
 
             if (button->IsDown() && is_position_button) {
-                logger::debug("configured key ({}) is down"sv, key_);
-                auto* position_setting = setting_execute::get_position_setting_for_key(key_);
+                LOG_DEBUG("configured key ({}) is down"sv, key_);
+                auto* position_setting = setting_execute::get_position_setting_for_position(dispatch.position);
                 if (!position_setting) {
                     logger::warn("setting for key {} is null. break."sv, key_);
                     continue;
@@ -130,11 +149,11 @@ namespace event {
             }
 
             if (button->IsUp() && is_position_button) {
-                logger::debug("configured Key ({}) is up"sv, key_);
+                LOG_DEBUG("configured Key ({}) is up"sv, key_);
                 //set slot back to normal color
                 // Look up the current thing-we-would-do for this keypress, then do it.
                 // E.g., equip the next item in the cycle.
-                auto* position_setting = setting_execute::get_position_setting_for_key(key_);
+                auto* position_setting = setting_execute::get_position_setting_for_position(dispatch.position);
                 if (!position_setting) {
                     logger::warn("setting for key {} is null. break."sv, key_);
                     continue;
@@ -171,7 +190,7 @@ namespace event {
 
             // For the normal mode, which we'll be deleting, the toggle key is the page key.
             if (button->IsPressed() && !elden && is_toggle_key) {
-                logger::debug("configured toggle key ({}) is pressed"sv, key_);
+                LOG_DEBUG("configured toggle key ({}) is pressed"sv, key_);
 
                 const auto* handler = handle::page_handle::get_singleton();
                 handler->set_active_page(handler->get_next_page_id());
@@ -186,7 +205,7 @@ namespace event {
 
             if (elden && button->IsPressed()) {
                 if (toggle_key_is_enough || utility_execute_requested) {
-                    auto* page_setting = setting_execute::get_position_setting_for_key(key_);
+                    auto* page_setting = setting_execute::get_position_setting_for_position(dispatch.position);
                     if (!page_setting) {
                         logger::warn("setting for key {} is null. break."sv, key_);
                         break;
@@ -194,7 +213,7 @@ namespace event {
                     setting_execute::activate(page_setting->slot_settings);
                 }
                 if (is_power_key) {
-                    auto* page_setting = setting_execute::get_position_setting_for_key(key_);
+                    auto* page_setting = setting_execute::get_position_setting_for_position(dispatch.position);
                     if (!page_setting) {
                         logger::warn("setting for key {} is null. break."sv, key_);
                         break;
@@ -205,19 +224,27 @@ namespace event {
             }
 
             if (is_position_button && button->IsPressed()) {
-                do_button_press(key_, key_binding);
+                do_button_press(key_, dispatch);
             }
         } // end event handling for loop
+        latency->clear_input_time();
+
+        if (handled) {
+            ui::hud_model::get_singleton()->publish();
+        }
 
         return event_result::kContinue;
     }
 
-    void key_manager::do_button_press(uint32_t a_key, control::binding*& a_binding) const {
-        logger::debug("configured Key ({}) pressed"sv, a_key);
-        auto* position_setting = setting_execute::get_position_setting_for_key(a_key);
+    void key_manager::do_button_press(const uint32_t a_key, const control::binding::key_dispatch& a_dispatch) const {
+        LOG_DEBUG("configured Key ({}) pressed"sv, a_key);
+        auto* position_setting = setting_execute::get_position_setting_for_position(a_dispatch.position);
+        if (!position_setting) {
+            return;
+        }
 
         // Simple case first, then early return for readability.
-        if (!mcm::get_elden_demon_souls()) {
+        if (!control::binding::get_singleton()->get_elden()) {
             setting_execute::activate(position_setting->slot_settings);
             return;
         }
@@ -226,8 +253,8 @@ namespace event {
 
         // If we're in utility execute requested mode, do nothing, because we already did it
         // in the function that called this one. This seems like it needs untangling.
-        auto execute_requires_modifier = mcm::get_bottom_execute_key_combo_only();
-        if (execute_requires_modifier && mToggleModeEntered && a_key == a_binding->get_bottom_action()) {
+        auto execute_requires_modifier = control::binding::get_singleton()->get_bottom_execute_key_combo_only();
+        if (execute_requires_modifier && mToggleModeEntered && (a_dispatch.roles & key_role::utility)) {
             return;
         }
 
@@ -236,12 +263,12 @@ namespace event {
 
         // Is this position locked? If so, we just check our ammo and exit.
         if (key_handler->is_position_locked(position_setting->position)) {
-            logger::trace("position {} is locked, skip"sv, static_cast<uint32_t>(position_setting->position));
+            LOG_TRACE("position {} is locked, skip"sv, static_cast<uint32_t>(position_setting->position));
             //check ammo is set, might be a bow or crossbow present
             const auto* ammo_handle = handle::ammo_handle::get_singleton();
             if (const auto next_ammo = ammo_handle->get_next_ammo()) {
                 setting_execute::execute_ammo(next_ammo);
-                handle::ammo_handle::get_singleton()->get_current()->highlight_slot = true;
+                ui::hud_model::get_singleton()->highlight(position_type::total);
             }
             return;
         }
@@ -253,25 +280,22 @@ namespace event {
         
         // Get the new position setting. If we get nothing here, we are in a state where
         // we can't do anything useful.
-        auto* new_position = setting_execute::get_position_setting_for_key(a_key);
+        auto* new_position = setting_execute::get_position_setting_for_position(a_dispatch.position);
 
         if (!new_position) {
             logger::warn("setting for key {} is null. break."sv, key_);
             return;
         }
-        new_position->highlight_slot = true;
-        if (!scroll_position(a_key, a_binding)) {
-            setting_execute::activate(new_position->slot_settings);
-        } else if (new_position->position == position_type::top) {
-            setting_execute::activate(new_position->slot_settings, true);
-        }
-    }
+        ui::hud_model::get_singleton()->highlight(new_position->position);
 
-    bool key_manager::scroll_position(const uint32_t a_key, control::binding*& a_binding) {
-        if (a_key == a_binding->get_bottom_action() || a_key == a_binding->get_top_action()) {
-            return true;
+        //scrolling the bottom does not equip anything, the top only equips
+        const auto only_equip = (a_dispatch.roles & key_role::scroll) != 0;
+        if (only_equip && new_position->position != position_type::top) {
+            return;
+        }
+        if (!processing::cycle_commit::get_singleton()->schedule(new_position->position, only_equip)) {
+            setting_execute::activate(new_position->slot_settings, only_equip);
         }
-        return false;
     }
 
     void key_manager::do_button_down(handle::position_setting*& a_position_setting) const {
@@ -33,8 +33,7 @@ namespace event {
 
         bool mToggleModeEntered = false;
 
-        void do_button_press(uint32_t a_key, control::binding*& a_binding) const;
-        [[nodiscard]] static bool scroll_position(uint32_t a_key, control::binding*& a_binding);
+        void do_button_press(uint32_t a_key, const control::binding::key_dispatch& a_dispatch) const;
         void do_button_down(handle::position_setting*& a_position_setting) const;
     };
 }
@@ -1,5 +1,6 @@
 #include "menu_manager.h"
 #include "control/binding.h"
+#include "util/trace_recorder.h"
 
 namespace event {
     menu_manager* menu_manager::get_singleton() {
@@ -15,6 +16,7 @@ namespace event {
         if (!a_event) {
             return event_result::kContinue;
         }
+        util::trace_recorder::get_singleton()->record_menu(a_event->menuName.c_str(), a_event->opening);
 
         // If this menu is relevant to us and it's not opening, we clear the state that
         // tracks whether our cycle edit keys are activated. Probably don't need this.
@@ -32,6 +34,11 @@ namespace event {
                 binding->set_is_remove_down(false);
             }
         }
+
+        //the shout key might have been changed in the controls
+        if (!a_event->opening && a_event->menuName == RE::JournalMenu::MENU_NAME) {
+            control::binding::get_singleton()->set_top_execute();
+        }
         return event_result::kContinue;
     }
 }  // event
@@ -0,0 +1,166 @@
+#include "ammo_index.h"
+#include "ammo_handle.h"
+#include "util/constant.h"
+#include "util/player/player.h"
+#include "util/string_util.h"
+
+namespace handle {
+    ammo_index* ammo_index::get_singleton() {
+        static ammo_index singleton;
+        return std::addressof(singleton);
+    }
+
+    void ammo_index::reset() const {
+        if (!this->data_) {
+            return;
+        }
+        ammo_index_data* data = this->data_;
+
+        ammo_handle::get_singleton()->clear_ammo();
+        std::scoped_lock lock(data->lock);
+        data->built = false;
+        data->entries.clear();
+        data->arrows = {};
+        data->bolts = {};
+        data->selection.clear();
+        LOG_TRACE("reset ammo index"sv);
+    }
+
+    void ammo_index::apply_delta(const RE::TESBoundObject* a_object, const int32_t a_count) {
+        if (!this->data_ || !a_object || !a_object->IsAmmo()) {
+            return;
+        }
+        ammo_index_data* data = this->data_;
+
+        std::scoped_lock lock(data->lock);
+        //nothing built yet, the first read gets it from the inventory anyway
+        if (!data->built) {
+            return;
+        }
+
+        auto* ammo = const_cast<RE::TESBoundObject*>(a_object)->As<RE::TESAmmo>();
+        if (!is_indexed(ammo)) {
+            return;
+        }
+        const auto it = data->entries.find(ammo->GetFormID());
+        const auto count = (it != data->entries.end() ? it->second.data.item_count : 0) + a_count;
+        set_count(ammo, std::max(count, 0));
+        LOG_TRACE("ammo {}, new count {}, change count {}"sv,
+            util::string_util::int_to_hex(ammo->GetFormID()),
+            count,
+            a_count);
+    }
+
+    ammo_data* ammo_index::get_ammo_data(const RE::TESForm* a_form) {
+        if (!a_form || !a_form->IsAmmo()) {
+            return nullptr;
+        }
+        if (!this->data_) {
+            this->data_ = new ammo_index_data();
+        }
+        build_if_needed();
+        ammo_index_data* data = this->data_;
+
+        std::scoped_lock lock(data->lock);
+        if (const auto it = data->entries.find(a_form->GetFormID()); it != data->entries.end()) {
+            return std::addressof(it->second.data);
+        }
+        return nullptr;
+    }
+
+    const std::vector<ammo_data*>& ammo_index::get_sorted(const bool a_crossbow,
+        const bool a_by_quantity,
+        const bool a_only_favorite,
+        const uint32_t a_max_items) {
+        if (!this->data_) {
+            this->data_ = new ammo_index_data();
+        }
+        build_if_needed();
+        ammo_index_data* data = this->data_;
+
+        std::scoped_lock lock(data->lock);
+        auto& selection = data->selection;
+        selection.clear();
+
+        auto* player = RE::PlayerCharacter::GetSingleton();
+        const auto add = [&](const RE::FormID a_form_id) {
+            auto& entry = data->entries.at(a_form_id);
+            //favorites are not reported by any hook, they are checked on the few that get looked at
+            if (a_only_favorite) {
+                const auto item = util::player::get_inventory_item(player, entry.data.form);
+                if (!item.entry || !item.entry->IsFavorited()) {
+                    return;
+                }
+            }
+            selection.push_back(std::addressof(entry.data));
+            LOG_TRACE("got {} count {}"sv, entry.data.form->GetName(), entry.data.item_count);
+        };
+
+        const auto& views = a_crossbow ? data->bolts : data->arrows;
+        if (a_by_quantity) {
+            for (auto it = views.by_quantity.begin(); it != views.by_quantity.end() && selection.size() < a_max_items;
+                 ++it) {
+                add(it->second);
+            }
+        } else {
+            for (auto it = views.by_damage.begin(); it != views.by_damage.end() && selection.size() < a_max_items;
+                 ++it) {
+                add(it->second);
+            }
+        }
+        return selection;
+    }
+
+    bool ammo_index::is_indexed(const RE::TESAmmo* a_ammo) {
+        if (!a_ammo || !a_ammo->GetPlayable() ||
+            a_ammo->GetRuntimeData().data.flags.any(RE::AMMO_DATA::Flag::kNonPlayable)) {
+            return false;
+        }
+        return a_ammo->GetFormID() != util::bound_arrow;
+    }
+
+    void ammo_index::build_if_needed() const {
+        ammo_index_data* data = this->data_;
+        std::scoped_lock lock(data->lock);
+        if (data->built) {
+            return;
+        }
+
+        auto* player = RE::PlayerCharacter::GetSingleton();
+        if (!player) {
+            return;
+        }
+        for (const auto& [item, inv_data] : util::player::get_inventory(player, RE::FormType::Ammo)) {
+            if (auto* ammo = item->As<RE::TESAmmo>(); is_indexed(ammo)) {
+                set_count(ammo, inv_data.first);
+            }
+        }
+        data->built = true;
+        LOG_DEBUG("built ammo index, {} arrows, {} bolts"sv,
+            data->arrows.by_damage.size(),
+            data->bolts.by_damage.size());
+    }
+
+    void ammo_index::set_count(RE::TESAmmo* a_ammo, const int32_t a_count) const {
+        ammo_index_data* data = this->data_;
+        const auto form_id = a_ammo->GetFormID();
+        auto [it, inserted] = data->entries.try_emplace(form_id);
+        auto& entry = it->second;
+        if (inserted) {
+            entry.data.form = a_ammo;
+            entry.damage = static_cast<uint32_t>(a_ammo->GetRuntimeData().data.damage);
+            entry.bolt = a_ammo->GetRuntimeData().data.flags.none(RE::AMMO_DATA::Flag::kNonBolt);
+        }
+
+        auto& views = entry.bolt ? data->bolts : data->arrows;
+        if (entry.data.item_count > 0) {
+            views.by_damage.erase({ entry.damage, form_id });
+            views.by_quantity.erase({ entry.data.item_count, form_id });
+        }
+        entry.data.item_count = a_count;
+        if (a_count > 0) {
+            views.by_damage.insert({ entry.damage, form_id });
+            views.by_quantity.insert({ a_count, form_id });
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "handle/data/ammo_data.h"
+
+namespace handle {
+    //the owned arrows and bolts, sorted by damage and by quantity at all times. it is built with one look at the
+    //inventory and then follows the changes the player hook reports, so a bow equip just reads the front of a view
+    class ammo_index {
+    public:
+        static ammo_index* get_singleton();
+        //the ammo data handed out before is gone after this, so the ammo handle gets cleared as well
+        void reset() const;
+        void apply_delta(const RE::TESBoundObject* a_object, int32_t a_count);
+        //the data the index keeps for the form, the ammo handle points to it so counts stay up to date
+        ammo_data* get_ammo_data(const RE::TESForm* a_form);
+        //best first, the list is kept and filled again on the next call
+        const std::vector<ammo_data*>&
+            get_sorted(bool a_crossbow, bool a_by_quantity, bool a_only_favorite, uint32_t a_max_items);
+
+        ammo_index(const ammo_index&) = delete;
+        ammo_index(ammo_index&&) = delete;
+
+        ammo_index& operator=(const ammo_index&) const = delete;
+        ammo_index& operator=(ammo_index&&) const = delete;
+
+    private:
+        ammo_index() : data_(nullptr) {}
+        ~ammo_index() = default;
+
+        struct ammo_entry {
+            ammo_data data;
+            uint32_t damage = 0;
+            bool bolt = false;
+        };
+
+        //highest first, the form id keeps equal values in a fixed order
+        using damage_view = std::set<std::pair<uint32_t, RE::FormID>, std::greater<>>;
+        using quantity_view = std::set<std::pair<int32_t, RE::FormID>, std::greater<>>;
+
+        struct ammo_views {
+            damage_view by_damage;
+            quantity_view by_quantity;
+        };
+
+        static bool is_indexed(const RE::TESAmmo* a_ammo);
+        void build_if_needed() const;
+        void set_count(RE::TESAmmo* a_ammo, int32_t a_count) const;
+
+        struct ammo_index_data {
+            std::mutex lock;
+            bool built = false;
+            //nodes stay where they are, the pointers to the ammo data are kept by the ammo handle
+            std::unordered_map<RE::FormID, ammo_entry> entries;
+            ammo_views arrows;
+            ammo_views bolts;
+            std::vector<ammo_data*> selection;
+        };
+
+        ammo_index_data* data_;
+    };
+}
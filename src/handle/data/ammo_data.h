@@ -7,6 +7,12 @@ namespace handle {
         RE::TESForm* form = nullptr;
         int32_t item_count = 0;
         uint32_t button_press_modify = ui::draw_full;
-        bool highlight_slot = false;
+    };
+
+    //ammo as written to the co-save, the data itself comes from the ammo index again
+    class ammo_snapshot {
+    public:
+        RE::FormID form_id = 0;
+        int32_t item_count = 0;
     };
 }
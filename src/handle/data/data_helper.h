@@ -1,7 +1,9 @@
 ﻿#pragma once
 #include "handle/data/page/slot_setting.h"
+#include "util/memory_stats.h"
 
-class data_helper {
+//they are handed around as raw pointers and not always freed, the memory report shows how many are left
+class data_helper : public util::memory_counted<util::memory_stats::subsystem::data_helper> {
 public:
     RE::TESForm* form = nullptr;
     handle::slot_setting::slot_type type = handle::slot_setting::slot_type::empty;
@@ -0,0 +1,19 @@
+#pragma once
+#include "handle/data/data_helper.h"
+#include "position_setting.h"
+#include "slot_setting.h"
+#include "ui/image_path.h"
+
+namespace handle {
+    //everything needed to build a page again without reading the config or the inventory
+    class page_snapshot {
+    public:
+        uint32_t page = 0;
+        position_setting::position_type position = position_setting::position_type::total;
+        slot_setting::hand_equip hand = slot_setting::hand_equip::total;
+        ui::icon_image_type icon_type = ui::icon_image_type::icon_default;
+        std::vector<data_helper> slots;
+        //same order as slots
+        std::vector<int32_t> item_counts;
+    };
+}
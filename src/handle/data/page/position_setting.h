@@ -1,13 +1,15 @@
 ﻿#pragma once
+#include "core/position.h"
 #include "position_draw_setting.h"
 #include "setting/custom_setting.h"
 #include "slot_setting.h"
 #include "ui/image_path.h"
+#include "util/memory_stats.h"
 
 namespace handle {
-    class position_setting {
+    class position_setting : public util::memory_counted<util::memory_stats::subsystem::page_model> {
     public:
-        enum class position_type : std::uint32_t { top = 0, right = 1, bottom = 2, left = 3, total = 4 };
+        using position_type = core::position_type;
 
         uint32_t page = 0;
         position_type position = position_type::total;
@@ -19,6 +21,5 @@ namespace handle {
         float item_name_font_size = 0.f;
         float count_font_size = 0.f;
         bool item_name = false;
-        bool highlight_slot = false;
     };
 }
@@ -1,7 +1,8 @@
 ﻿#pragma once
+#include "util/memory_stats.h"
 
 namespace handle {
-    class slot_setting {
+    class slot_setting : public util::memory_counted<util::memory_stats::subsystem::page_model> {
     public:
         //un equip just makes sense with form == nullptr
         enum class action_type : std::uint32_t { default_action = 0, instant = 1, un_equip = 2 };
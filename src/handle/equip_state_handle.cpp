@@ -0,0 +1,86 @@
+#include "equip_state_handle.h"
+#include "util/string_util.h"
+
+namespace handle {
+    //the game did not take the equip, like for an item that is gone. the cached state is trusted again after it
+    constexpr auto pending_timeout = std::chrono::seconds(2);
+
+    equip_state_handle* equip_state_handle::get_singleton() {
+        static equip_state_handle singleton;
+        return std::addressof(singleton);
+    }
+
+    void equip_state_handle::update() {
+        if (!this->data_) {
+            this->data_ = new equip_state_handle_data();
+        }
+        equip_state_handle_data* data = this->data_;
+
+        auto* player = RE::PlayerCharacter::GetSingleton();
+        if (!player) {
+            return;
+        }
+        const auto set = [data](const equip_target a_target, RE::TESForm* a_form) {
+            data->equipped[static_cast<size_t>(a_target)].store(a_form);
+        };
+
+        if (auto* current_process = player->GetActorRuntimeData().currentProcess; current_process) {
+            set(equip_target::right, current_process->GetEquippedRightHand());
+            set(equip_target::left, current_process->GetEquippedLeftHand());
+        } else {
+            set(equip_target::right, nullptr);
+            set(equip_target::left, nullptr);
+        }
+        set(equip_target::voice, player->GetActorRuntimeData().selectedPower);
+        set(equip_target::ammo, player->GetCurrentAmmo());
+
+        for (size_t i = 0; i < data->pending.size(); ++i) {
+            if (data->pending[i].load() && data->equipped[i].load() == data->pending_form[i].load()) {
+                data->pending[i].store(false);
+            }
+        }
+
+        const auto form_string = [this](const equip_target a_target) {
+            const auto* form = get_equipped(a_target);
+            return form ? util::string_util::int_to_hex(form->GetFormID()) : "null";
+        };
+        LOG_TRACE("equipped right {}, left {}, voice {}, ammo {}"sv,
+            form_string(equip_target::right),
+            form_string(equip_target::left),
+            form_string(equip_target::voice),
+            form_string(equip_target::ammo));
+    }
+
+    RE::TESForm* equip_state_handle::get_equipped(const equip_target a_target) const {
+        if (!this->data_ || a_target == equip_target::total) {
+            return nullptr;
+        }
+        return this->data_->equipped[static_cast<size_t>(a_target)].load();
+    }
+
+    bool equip_state_handle::is_equipped(const RE::TESForm* a_form, const equip_target a_target) const {
+        //not known yet is never equipped, then the equip just runs
+        if (!a_form || !this->data_ || a_target == equip_target::total) {
+            return false;
+        }
+        const auto index = static_cast<size_t>(a_target);
+        if (const auto* data = this->data_; data->pending[index].load()) {
+            const auto since = clock::time_point(clock::duration(data->pending_since[index].load()));
+            if (clock::now() - since < pending_timeout) {
+                return false;
+            }
+        }
+        return get_equipped(a_target) == a_form;
+    }
+
+    void equip_state_handle::set_pending(const equip_target a_target, const RE::TESForm* a_form) {
+        if (!this->data_ || a_target == equip_target::total) {
+            return;
+        }
+        equip_state_handle_data* data = this->data_;
+        const auto index = static_cast<size_t>(a_target);
+        data->pending_form[index].store(a_form);
+        data->pending_since[index].store(clock::now().time_since_epoch().count());
+        data->pending[index].store(true);
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+namespace handle {
+    //what the player has in the hands, the voice slot and as ammo. the equip event keeps it current, so a press that
+    //would equip the same again can be dropped without looking at the inventory
+    class equip_state_handle {
+    public:
+        enum class equip_target : std::uint32_t { right = 0, left = 1, voice = 2, ammo = 3, total = 4 };
+
+        static equip_state_handle* get_singleton();
+        //reads everything from the player again
+        void update();
+        [[nodiscard]] RE::TESForm* get_equipped(equip_target a_target) const;
+        //false while an equip for the target still waits for its event, the cached form might be replaced any moment
+        [[nodiscard]] bool is_equipped(const RE::TESForm* a_form, equip_target a_target) const;
+        //an equip for the target was sent to the game, null for an un equip
+        void set_pending(equip_target a_target, const RE::TESForm* a_form);
+
+        equip_state_handle(const equip_state_handle&) = delete;
+        equip_state_handle(equip_state_handle&&) = delete;
+
+        equip_state_handle& operator=(const equip_state_handle&) const = delete;
+        equip_state_handle& operator=(equip_state_handle&&) const = delete;
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        equip_state_handle() : data_(nullptr) {}
+        ~equip_state_handle() = default;
+
+        struct equip_state_handle_data {
+            //read from the input and the papyrus thread, written by the equip event
+            std::array<std::atomic<RE::TESForm*>, static_cast<size_t>(equip_target::total)> equipped{};
+            //what was sent last, cleared once the update shows it
+            std::array<std::atomic<bool>, static_cast<size_t>(equip_target::total)> pending{};
+            std::array<std::atomic<const RE::TESForm*>, static_cast<size_t>(equip_target::total)> pending_form{};
+            std::array<std::atomic<clock::rep>, static_cast<size_t>(equip_target::total)> pending_since{};
+        };
+
+        equip_state_handle_data* data_;
+    };
+}
@@ -1,4 +1,5 @@
 #include "extra_data_holder.h"
+#include "util/memory_stats.h"
 
 namespace handle {
     extra_data_holder* extra_data_holder::get_singleton() {
@@ -19,7 +20,8 @@ namespace handle {
         }
 
         data->form_extra_data_map[a_form] = a_extra_data_list;
-        logger::trace("set extra data list, form {}, count {}"sv, a_form->GetName(), data->form_extra_data_map.size());
+        count_memory(data);
+        LOG_TRACE("set extra data list, form {}, count {}"sv, a_form->GetName(), data->form_extra_data_map.size());
     }
 
     void extra_data_holder::overwrite_extra_data_for_form(const RE::TESForm* a_form,
@@ -31,6 +33,7 @@ namespace handle {
 
         if (data->form_extra_data_map.contains(a_form)) {
             data->form_extra_data_map[a_form] = a_extra_data_list;
+            count_memory(data);
         }
     }
 
@@ -44,9 +47,10 @@ namespace handle {
             return;
         }
 
-        logger::trace("before reset, extra data list {}"sv, data->form_extra_data_map.size());
+        LOG_TRACE("before reset, extra data list {}"sv, data->form_extra_data_map.size());
         data->form_extra_data_map.clear();
-        logger::trace("did reset, extra data list {}"sv, data->form_extra_data_map.size());
+        count_memory(data);
+        LOG_TRACE("did reset, extra data list {}"sv, data->form_extra_data_map.size());
     }
 
     bool extra_data_holder::is_form_set(const RE::TESForm* a_form) {
@@ -70,4 +74,17 @@ namespace handle {
 
         return {};
     }
+
+    void extra_data_holder::count_memory(const extra_data_holder_data* a_data) {
+        size_t lists = 0;
+        for (const auto& entry : a_data->form_extra_data_map) {
+            lists += entry.second.capacity();
+        }
+        //a map node holds the key, the vector and about three pointers of its own
+        constexpr auto node_size =
+            sizeof(const RE::TESForm*) + sizeof(std::vector<RE::ExtraDataList*>) + 3 * sizeof(void*);
+        util::memory_stats::set(util::memory_stats::subsystem::extra_data,
+            lists,
+            a_data->form_extra_data_map.size() * node_size + lists * sizeof(RE::ExtraDataList*));
+    }
 }  // handle
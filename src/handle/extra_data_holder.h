@@ -25,6 +25,8 @@ namespace handle {
             std::map<const RE::TESForm*, std::vector<RE::ExtraDataList*>> form_extra_data_map;
         };
 
+        static void count_memory(const extra_data_holder_data* a_data);
+
         extra_data_holder_data* data_;
     };
 }  // handle
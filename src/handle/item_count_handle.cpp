@@ -0,0 +1,181 @@
+#include "item_count_handle.h"
+#include "util/helper.h"
+#include "util/string_util.h"
+
+namespace handle {
+    //hands the tracked part of the player inventory to the core
+    class item_count_handle::player_inventory final : public core::inventory_source {
+    public:
+        explicit player_inventory(RE::PlayerCharacter* a_player) : player_(a_player) {}
+
+        void for_each_item(const std::function<void(const core::item_record&)>& a_visit) const override {
+            for (const auto& [item, inv_data] :
+                player_->GetInventory([](const RE::TESBoundObject& a_object) { return is_tracked(&a_object); })) {
+                if (const auto num_items = inv_data.first; num_items > 0) {
+                    a_visit(get_record(item, num_items));
+                }
+            }
+        }
+
+    private:
+        RE::PlayerCharacter* player_;
+    };
+
+    item_count_handle* item_count_handle::get_singleton() {
+        static item_count_handle singleton;
+        return std::addressof(singleton);
+    }
+
+    void item_count_handle::reset() const {
+        if (!this->data_) {
+            return;
+        }
+        item_count_handle_data* data = this->data_;
+
+        std::scoped_lock lock(data->lock);
+        data->counts.reset();
+        LOG_TRACE("reset item counts"sv);
+    }
+
+    void item_count_handle::apply_delta(const RE::TESBoundObject* a_object, const int32_t a_count) {
+        if (!this->data_ || !a_object || !is_tracked(a_object)) {
+            return;
+        }
+        item_count_handle_data* data = this->data_;
+
+        std::scoped_lock lock(data->lock);
+        //nothing built yet, the first read gets it from the inventory anyway
+        if (!data->counts.is_built()) {
+            return;
+        }
+
+        data->counts.apply_delta(get_record(const_cast<RE::TESBoundObject*>(a_object), a_count));
+        LOG_TRACE("FormId {}, mirrored count {}, change count {}"sv,
+            util::string_util::int_to_hex(a_object->GetFormID()),
+            data->counts.get_count(a_object->GetFormID()),
+            a_count);
+    }
+
+    int32_t item_count_handle::get_count(const RE::TESForm* a_form) {
+        if (!a_form || !a_form->IsInventoryObject()) {
+            return 0;
+        }
+        if (!this->data_) {
+            this->data_ = new item_count_handle_data();
+        }
+        build_if_needed();
+        item_count_handle_data* data = this->data_;
+
+        std::scoped_lock lock(data->lock);
+        return data->counts.get_count(a_form->GetFormID());
+    }
+
+    int32_t item_count_handle::get_actor_value_count(const RE::ActorValue a_actor_value) {
+        if (a_actor_value == RE::ActorValue::kNone) {
+            return 0;
+        }
+        if (!this->data_) {
+            this->data_ = new item_count_handle_data();
+        }
+        build_if_needed();
+        item_count_handle_data* data = this->data_;
+
+        std::scoped_lock lock(data->lock);
+        return data->counts.get_group_count(static_cast<uint32_t>(a_actor_value));
+    }
+
+    RE::AlchemyItem* item_count_handle::get_fitting_potion(const RE::ActorValue a_actor_value,
+        const float a_missing,
+        const float a_min_perfect,
+        const float a_max_perfect,
+        const bool a_skip_last_dynamic) {
+        if (a_actor_value == RE::ActorValue::kNone) {
+            return nullptr;
+        }
+        if (!this->data_) {
+            this->data_ = new item_count_handle_data();
+        }
+        build_if_needed();
+        item_count_handle_data* data = this->data_;
+
+        RE::FormID form_id;
+        {
+            std::scoped_lock lock(data->lock);
+            form_id = data->counts.get_fitting_potion(static_cast<uint32_t>(a_actor_value),
+                a_missing,
+                a_min_perfect,
+                a_max_perfect,
+                a_skip_last_dynamic);
+        }
+        if (form_id == 0) {
+            return nullptr;
+        }
+
+        auto* potion = RE::TESForm::LookupByID<RE::AlchemyItem>(form_id);
+        if (potion) {
+            LOG_TRACE("found potion {} for missing {}"sv, potion->GetName(), a_missing);
+        }
+        return potion;
+    }
+
+    bool item_count_handle::is_tracked(const RE::TESForm* a_form) {
+        //what can end up in a slot or the ammo list
+        switch (a_form->GetFormType()) {
+            case RE::FormType::Weapon:
+            case RE::FormType::Armor:
+            case RE::FormType::Light:
+            case RE::FormType::AlchemyItem:
+            case RE::FormType::Scroll:
+            case RE::FormType::Ammo:
+            case RE::FormType::Misc:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    core::item_record item_count_handle::get_record(RE::TESBoundObject* a_object, const int32_t a_count) {
+        core::item_record record;
+        record.id = a_object->GetFormID();
+        record.count = a_count;
+        if (const auto actor_value = util::helper::get_actor_value_effect_from_potion(a_object);
+            actor_value != RE::ActorValue::kNone) {
+            record.potion_group = static_cast<uint32_t>(actor_value);
+            record.restore_amount = get_restore_amount(a_object->As<RE::AlchemyItem>());
+            record.dynamic = a_object->IsDynamicForm();
+        }
+        return record;
+    }
+
+    void item_count_handle::build_if_needed() const {
+        item_count_handle_data* data = this->data_;
+        std::scoped_lock lock(data->lock);
+        if (data->counts.is_built()) {
+            return;
+        }
+
+        auto* player = RE::PlayerCharacter::GetSingleton();
+        if (!player) {
+            return;
+        }
+        data->counts.build(player_inventory(player));
+        LOG_DEBUG("built item counts for {} forms, {} potion groups"sv,
+            data->counts.get_tracked_form_count(),
+            data->counts.get_tracked_group_count());
+    }
+
+    float item_count_handle::get_restore_amount(RE::AlchemyItem* a_potion) {
+        if (!a_potion) {
+            return 0.f;
+        }
+        auto* effect = a_potion->GetCostliestEffectItem();
+        if (!effect) {
+            return 0.f;
+        }
+        auto duration = effect->GetDuration();
+        if (duration == 0) {
+            duration = 1;
+        }
+        return effect->GetMagnitude() * static_cast<float>(duration);
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "core/item_counts.h"
+
+namespace handle {
+    //counts of the items the hud can show, taken with one look at the inventory and then kept up with the changes
+    //the player hook reports, so a slot does not need to go through the whole inventory for its count
+    class item_count_handle {
+    public:
+        static item_count_handle* get_singleton();
+        //the next read takes the counts from the inventory again
+        void reset() const;
+        void apply_delta(const RE::TESBoundObject* a_object, int32_t a_count);
+        int32_t get_count(const RE::TESForm* a_form);
+        //sum over the potions grouped under the actor value
+        int32_t get_actor_value_count(RE::ActorValue a_actor_value);
+        //owned potion of the group that restores closest to the missing amount, one inside the min/max range wins
+        //over a closer one outside of it. dynamic potions with one left are skipped if asked for
+        RE::AlchemyItem* get_fitting_potion(RE::ActorValue a_actor_value,
+            float a_missing,
+            float a_min_perfect,
+            float a_max_perfect,
+            bool a_skip_last_dynamic);
+
+        //what can end up in a slot or the ammo list
+        static bool is_tracked(const RE::TESForm* a_form);
+        //the potion values are only filled for grouped potions
+        static core::item_record get_record(RE::TESBoundObject* a_object, int32_t a_count);
+
+        item_count_handle(const item_count_handle&) = delete;
+        item_count_handle(item_count_handle&&) = delete;
+
+        item_count_handle& operator=(const item_count_handle&) const = delete;
+        item_count_handle& operator=(item_count_handle&&) const = delete;
+
+    private:
+        item_count_handle() : data_(nullptr) {}
+        ~item_count_handle() = default;
+
+        class player_inventory;
+
+        static float get_restore_amount(RE::AlchemyItem* a_potion);
+        void build_if_needed() const;
+
+        struct item_count_handle_data {
+            std::mutex lock;
+            core::item_counts counts;
+        };
+
+        item_count_handle_data* data_;
+    };
+}
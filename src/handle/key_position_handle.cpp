@@ -11,7 +11,7 @@ namespace handle {
     }
 
     void key_position_handle::init_key_position_map() {
-        logger::trace("init key position map ..."sv);
+        LOG_TRACE("init key position map ..."sv);
         if (!this->data_) {
             this->data_ = new key_position_handle_data();
         }
@@ -29,7 +29,7 @@ namespace handle {
         data->position_key_map[position_type::left] = mcm::get_left_action_key();
 
 
-        logger::trace("done with init of position key map."sv);
+        LOG_TRACE("done with init of position key map."sv);
     }
 
     void key_position_handle::set_position_lock(const position_type a_position, const uint32_t a_locked) {
@@ -37,7 +37,7 @@ namespace handle {
             this->data_ = new key_position_handle_data();
         }
         key_position_handle_data* data = this->data_;
-        logger::trace("init lock for position {}, lock {}"sv, static_cast<uint32_t>(a_position), a_locked);
+        LOG_TRACE("init lock for position {}, lock {}"sv, static_cast<uint32_t>(a_position), a_locked);
         data->position_lock_map[a_position] = a_locked;
     }
 
@@ -45,7 +45,7 @@ namespace handle {
         if (const key_position_handle_data* data = this->data_;
             data && !data->key_position_map.empty() && data->key_position_map.contains(a_key)) {
             const auto pos = data->key_position_map.at(a_key);
-            logger::trace("got position {} for key {}"sv, static_cast<uint32_t>(pos), a_key);
+            LOG_TRACE("got position {} for key {}"sv, static_cast<uint32_t>(pos), a_key);
             return pos;
         }
         return position_type::total;
@@ -55,7 +55,7 @@ namespace handle {
         if (const key_position_handle_data* data = this->data_;
             data && !data->position_key_map.empty() && data->position_key_map.contains(a_position)) {
             const auto key = data->position_key_map.at(a_position);
-            logger::trace("got key {} for position {}"sv, key, static_cast<uint32_t>(a_position));
+            LOG_TRACE("got key {} for position {}"sv, key, static_cast<uint32_t>(a_position));
             return key;
         }
         return 0;
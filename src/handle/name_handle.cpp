@@ -1,78 +1,82 @@
 ﻿#include "name_handle.h"
-#include "handle/data/data_helper.h"
+#include "handle/equip_state_handle.h"
 #include "util/constant.h"
+#include "util/helper.h"
 
 namespace handle {
+    static constexpr auto empty_name = "<Empty>";
+
     name_handle* name_handle::get_singleton() {
         static name_handle singleton;
         return std::addressof(singleton);
     }
 
-    void name_handle::init_names(const std::vector<data_helper*>& data_helpers) {
+    void name_handle::set_item_names_dirty() {
         if (!this->data_) {
             this->data_ = new name_handle_data();
         }
+        this->data_->item_names_dirty.store(true);
+    }
 
-        name_handle_data* data = this->data_;
-        std::string help_string;
-
-        data->name = "<Empty>";
-
-        auto check_ammo = false;
-        std::string name_right = "<Empty>";
-        if (!data_helpers.empty()) {
-            if (data_helpers[0]->form) {
-                name_right = data_helpers[0]->form->GetName();
-                if (data_helpers[0]->form->IsWeapon()) {
-                    //check_ammo
-                    if (auto* weapon = data_helpers[0]->form->As<RE::TESObjectWEAP>();
-                        (weapon->IsBow() || weapon->IsCrossbow()) && !weapon->IsBound()) {
-                        check_ammo = true;
-                    }
-                }
-            }
-            data->name = name_right;
+    void name_handle::set_voice_name_dirty() {
+        if (!this->data_) {
+            this->data_ = new name_handle_data();
         }
+        this->data_->voice_name_dirty.store(true);
+    }
 
-        if (check_ammo && data_helpers.size() != 2) {
-            auto* player = RE::PlayerCharacter::GetSingleton();
-            if (auto* ammo = player->GetCurrentAmmo(); ammo && (ammo->IsBolt() || ammo->IsAmmo())) {
-                data->name = fmt::format("{} {} {}", ammo->GetName(), util::delimiter, name_right);
-            }
+    const std::string& name_handle::get_item_name_string() {
+        if (!this->data_) {
+            this->data_ = new name_handle_data();
         }
-
-        if (data_helpers.size() == 2) {
-            std::string name_left = "<Empty>";
-            if (data_helpers[1]->form) {
-                name_left = data_helpers[1]->form->GetName();
-            }
-            data->name = fmt::format("{} {} {}", name_left, util::delimiter, name_right);
+        if (this->data_->item_names_dirty.exchange(false)) {
+            compose_item_names();
         }
-        logger::trace("name set to {}"sv, data->name);
+        return this->data_->name;
     }
 
-    void name_handle::init_voice_name(const RE::TESForm* a_form) {
+    const std::string& name_handle::get_voice_name_string() {
         if (!this->data_) {
             this->data_ = new name_handle_data();
         }
+        if (this->data_->voice_name_dirty.exchange(false)) {
+            compose_voice_name();
+        }
+        return this->data_->voice_name;
+    }
 
+    void name_handle::compose_item_names() const {
+        using equip_target = equip_state_handle::equip_target;
         name_handle_data* data = this->data_;
+        const auto* equip_state = equip_state_handle::get_singleton();
+        auto* right = equip_state->get_equipped(equip_target::right);
+        auto* left = equip_state->get_equipped(equip_target::left);
 
-        data->voice_name = a_form ? a_form->GetName() : "";
-        logger::trace("voice name set to {}"sv, data->voice_name);
-    }
-
-    std::string name_handle::get_item_name_string() const {
-        if (const name_handle_data* data = this->data_; data) {
-            return data->name;
+        //the string keeps its capacity, so writing it again does not allocate most of the time
+        data->name.clear();
+        const auto name_right = right ? right->GetName() : empty_name;
+        if (right && left == right && util::helper::is_two_handed(right)) {
+            if (const auto* weapon = right->As<RE::TESObjectWEAP>();
+                weapon && (weapon->IsBow() || weapon->IsCrossbow()) && !weapon->IsBound()) {
+                if (const auto* ammo = equip_state->get_equipped(equip_target::ammo); ammo) {
+                    fmt::format_to(std::back_inserter(data->name), "{} {} ", ammo->GetName(), util::delimiter);
+                }
+            }
+            data->name.append(name_right);
+        } else {
+            fmt::format_to(std::back_inserter(data->name),
+                "{} {} {}",
+                left ? left->GetName() : empty_name,
+                util::delimiter,
+                name_right);
         }
-        return {};
+        LOG_TRACE("name set to {}"sv, data->name);
     }
 
-    std::string name_handle::get_voice_name_string() const {
-        if (const name_handle_data* data = this->data_; data) {
-            return data->voice_name;
-        }
-        return {};
+    void name_handle::compose_voice_name() const {
+        name_handle_data* data = this->data_;
+        const auto* voice = equip_state_handle::get_singleton()->get_equipped(equip_state_handle::equip_target::voice);
+        data->voice_name.assign(voice ? voice->GetName() : "");
+        LOG_TRACE("voice name set to {}"sv, data->voice_name);
     }
 }
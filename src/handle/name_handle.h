@@ -1,14 +1,16 @@
 ﻿#pragma once
-#include "handle/data/data_helper.h"
 
 namespace handle {
+    //the texts for what is equipped. a change just marks them, they get put together from the equip state once the
+    //renderer draws them, so nothing is done while the text is not shown
     class name_handle {
     public:
         static name_handle* get_singleton();
-        void init_names(const std::vector<data_helper*>& data_helpers);
-        void init_voice_name(const RE::TESForm* a_form);
-        [[nodiscard]] std::string get_item_name_string() const;
-        [[nodiscard]] std::string get_voice_name_string() const;
+        void set_item_names_dirty();
+        void set_voice_name_dirty();
+        //only called by the renderer, the string stays valid until its next call
+        [[nodiscard]] const std::string& get_item_name_string();
+        [[nodiscard]] const std::string& get_voice_name_string();
 
         name_handle(const name_handle&) = delete;
         name_handle(name_handle&&) = delete;
@@ -20,7 +22,12 @@ namespace handle {
         name_handle() : data_(nullptr) {}
         ~name_handle() = default;
 
+        void compose_item_names() const;
+        void compose_voice_name() const;
+
         struct name_handle_data {
+            std::atomic<bool> item_names_dirty = true;
+            std::atomic<bool> voice_name_dirty = true;
             std::string name;
             std::string voice_name;
         };
@@ -3,10 +3,11 @@
 #include "handle/data/data_helper.h"
 #include "handle/data/page/position_setting.h"
 #include "handle/data/page/slot_setting.h"
+#include "handle/item_count_handle.h"
 #include "setting/mcm_setting.h"
 #include "util/constant.h"
+#include "util/form_cache.h"
 #include "util/helper.h"
-#include "util/player/player.h"
 #include "util/string_util.h"
 
 namespace handle {
@@ -23,7 +24,7 @@ namespace handle {
         const std::vector<data_helper*>& data_helpers,
         const slot_setting::hand_equip a_hand,
         key_position_handle*& a_key_pos) {
-        logger::trace("init page {}, position {}, data_size for settings {}, hand {} ..."sv,
+        LOG_TRACE("init page {}, position {}, data_size for settings {}, hand {} ..."sv,
             a_page,
             static_cast<uint32_t>(a_position),
             data_helpers.size(),
@@ -32,8 +33,83 @@ namespace handle {
             this->data_ = new page_handle_data();
         }
 
+        add_page(build_page(a_page, a_position, data_helpers, a_hand, a_key_pos));
+    }
+
+    void page_handle::restore_page(const page_snapshot& a_snapshot, key_position_handle*& a_key_pos) {
+        LOG_TRACE("restore page {}, position {}, slots {}, hand {} ..."sv,
+            a_snapshot.page,
+            static_cast<uint32_t>(a_snapshot.position),
+            a_snapshot.slots.size(),
+            static_cast<uint32_t>(a_snapshot.hand));
+        if (a_snapshot.slots.empty()) {
+            logger::warn("snapshot for page {} got no slots. return."sv, a_snapshot.page);
+            return;
+        }
+        if (!this->data_) {
+            this->data_ = new page_handle_data();
+        }
+
+        std::vector<data_helper*> data_helpers;
+        for (const auto& slot : a_snapshot.slots) {
+            data_helpers.push_back(const_cast<data_helper*>(&slot));
+        }
+
+        //counts and icon are taken over from the save, no need to look at the inventory or keywords again
+        add_page(build_page(a_snapshot.page,
+            a_snapshot.position,
+            data_helpers,
+            a_snapshot.hand,
+            a_key_pos,
+            &a_snapshot.item_counts,
+            &a_snapshot.icon_type));
+    }
+
+    void page_handle::init_empty_pages(key_position_handle*& a_key_pos) {
+        LOG_TRACE("init empty pages ..."sv);
+        if (!this->data_) {
+            this->data_ = new page_handle_data();
+        }
         page_handle_data* data = this->data_;
 
+        //configured pages are added again while processing the config, every other page falls back to the empty one
+        for (const auto& [key, page] : data->page_settings) {
+            delete_page(page);
+        }
+        data->page_settings.clear();
+
+        data_helper empty;
+        empty.form = nullptr;
+        empty.action_type = slot_setting::action_type::default_action;
+        empty.type = slot_type::empty;
+        const std::vector<data_helper*> data_helpers = { &empty };
+
+        for (auto i = 0; i < static_cast<int>(position_type::total); ++i) {
+            const auto position = static_cast<position_type>(i);
+            if (const auto it = data->empty_page_settings.find(position); it != data->empty_page_settings.end()) {
+                delete_page(it->second);
+            }
+            data->empty_page_settings[position] =
+                build_page(0, position, data_helpers, slot_setting::hand_equip::total, a_key_pos);
+        }
+
+        //the active pages get written to (button feedback, blocked icons), they can not be the shared empty page
+        for (auto i = 0; i < static_cast<int>(position_type::total); ++i) {
+            const auto position = static_cast<position_type>(i);
+            materialize_page(mcm::get_elden_demon_souls() ? data->cycle.get_active_page_position(position) :
+                                                            data->cycle.get_active_page(),
+                position);
+        }
+        LOG_TRACE("done init empty pages."sv);
+    }
+
+    position_setting* page_handle::build_page(const uint32_t a_page,
+        const position_type a_position,
+        const std::vector<data_helper*>& data_helpers,
+        const slot_setting::hand_equip a_hand,
+        key_position_handle*& a_key_pos,
+        const std::vector<int32_t>* a_item_counts,
+        const icon_type* a_icon) {
         auto elden = mcm::get_elden_demon_souls();
 
         const auto slot_offset_x = mcm::get_hud_slot_position_offset_x();
@@ -46,7 +122,7 @@ namespace handle {
 
         auto* slots = new std::vector<slot_setting*>;
         for (auto* element : data_helpers) {
-            logger::trace("processing form {}, type {}, action {}, left {}, actor_value {}"sv,
+            LOG_TRACE("processing form {}, type {}, action {}, left {}, actor_value {}"sv,
                 element->form ? util::string_util::int_to_hex(element->form->GetFormID()) : "null",
                 static_cast<int>(element->type),
                 static_cast<uint32_t>(element->action_type),
@@ -60,7 +136,10 @@ namespace handle {
             slot->actor_value = element->actor_value;
             RE::BGSEquipSlot* equip_slot = nullptr;
             get_equip_slots(element->type, a_hand, equip_slot, element->left);
-            if (!element->form && slot->type == slot_type::consumable && slot->actor_value != RE::ActorValue::kNone) {
+            if (a_item_counts && slots->size() < a_item_counts->size()) {
+                slot->item_count = a_item_counts->at(slots->size());
+            } else if (!element->form && slot->type == slot_type::consumable &&
+                       slot->actor_value != RE::ActorValue::kNone) {
                 get_consumable_item_count(slot->actor_value, slot->item_count);
             } else {
                 get_item_count(element->form, slot->item_count, element->type);
@@ -77,16 +156,21 @@ namespace handle {
 
         page->slot_settings = *slots;
 
-        //for now the right hand or the first setting defines the icon, works well for elden.
-        page->icon_type = get_icon_type(slots->front()->type, slots->front()->form);
-        if (slots->size() == 2 && page->icon_type == icon_type::icon_default) {
-            logger::debug("Could not find an Icon with first setting, try next");
-            page->icon_type = get_icon_type(slots->at(1)->type, slots->at(1)->form);
-        }
+        if (a_icon) {
+            page->icon_type = *a_icon;
+        } else {
+            //for now the right hand or the first setting defines the icon, works well for elden.
+            page->icon_type = get_icon_type(slots->front()->type, slots->front()->form);
+            if (slots->size() == 2 && page->icon_type == icon_type::icon_default) {
+                LOG_DEBUG("Could not find an Icon with first setting, try next");
+                page->icon_type = get_icon_type(slots->at(1)->type, slots->at(1)->form);
+            }
 
-        //we set the icon type according to the actor value
-        if (slots->front()->actor_value != RE::ActorValue::kNone && slots->front()->type == slot_type::consumable) {
-            get_consumable_icon_by_actor_value(slots->front()->actor_value, page->icon_type);
+            //we set the icon type according to the actor value
+            if (slots->front()->actor_value != RE::ActorValue::kNone &&
+                slots->front()->type == slot_type::consumable) {
+                get_consumable_icon_by_actor_value(slots->front()->actor_value, page->icon_type);
+            }
         }
 
         auto* draw = new position_draw_setting();
@@ -170,18 +254,32 @@ namespace handle {
         page->item_name_font_size = config::mcm_setting::get_item_name_font_size();
         page->count_font_size = config::mcm_setting::get_slot_count_text_font_size();
 
-        if (elden) {
-            if (first_slot->type != slot_type::empty || slots->size() == 2 && slots->at(1)->type != slot_type::empty) {
-                const auto config_page = static_cast<int>(a_page);
-                if (const auto current_highest = get_highest_page_id_position(a_position);
+        return page;
+    }
+
+    void page_handle::add_page(position_setting* a_page) const {
+        page_handle_data* data = this->data_;
+        const auto page_id = a_page->page;
+        const auto position = a_page->position;
+
+        if (mcm::get_elden_demon_souls()) {
+            const auto& slots = a_page->slot_settings;
+            if (slots.front()->type != slot_type::empty || slots.size() == 2 && slots.at(1)->type != slot_type::empty) {
+                const auto config_page = static_cast<int>(page_id);
+                if (const auto current_highest = get_highest_page_id_position(position);
                     current_highest < config_page) {
-                    set_highest_page_position(config_page, a_position);
+                    set_highest_page_position(config_page, position);
                 }
             }
         }
 
-        data->page_settings[a_page][a_position] = page;
-        logger::trace("done setting page {}, position {}."sv, a_page, static_cast<uint32_t>(a_position));
+        const auto key = util::make_page_key(page_id, static_cast<uint32_t>(position));
+        auto& entry = get_or_insert_page(data->page_settings, key);
+        if (entry && entry != a_page) {
+            delete_page(entry);
+        }
+        entry = a_page;
+        LOG_TRACE("done setting page {}, position {}."sv, page_id, static_cast<uint32_t>(position));
     }
 
     void page_handle::init_actives(uint32_t a_page, position_type a_position) {
@@ -189,8 +287,9 @@ namespace handle {
             this->data_ = new page_handle_data();
         }
         page_handle_data* data = this->data_;
-        logger::trace("init active page {} for position {}"sv, a_page, static_cast<uint32_t>(a_position));
-        data->active_page_per_position[a_position] = a_page;
+        LOG_TRACE("init active page {} for position {}"sv, a_page, static_cast<uint32_t>(a_position));
+        data->cycle.set_active_page_position(a_page, a_position);
+        materialize_page(a_page, a_position);
     }
 
     void page_handle::set_active_page(const uint32_t a_page) const {
@@ -199,8 +298,11 @@ namespace handle {
         }
         page_handle_data* data = this->data_;
 
-        logger::trace("set active page to {}"sv, a_page);
-        data->active_page = a_page;
+        LOG_TRACE("set active page to {}"sv, a_page);
+        data->cycle.set_active_page(a_page);
+        for (auto i = 0; i < static_cast<int>(position_type::total); ++i) {
+            materialize_page(a_page, static_cast<position_type>(i));
+        }
     }
 
     void page_handle::set_active_page_position(const uint32_t a_page, position_type a_pos) const {
@@ -208,8 +310,9 @@ namespace handle {
             return;
         }
         page_handle_data* data = this->data_;
-        logger::trace("set active page {} for position {}"sv, a_page, static_cast<uint32_t>(a_pos));
-        data->active_page_per_position[a_pos] = a_page;
+        LOG_TRACE("set active page {} for position {}"sv, a_page, static_cast<uint32_t>(a_pos));
+        data->cycle.set_active_page_position(a_page, a_pos);
+        materialize_page(a_page, a_pos);
     }
 
     void page_handle::set_highest_page_position(int a_page, position_type a_pos) const {
@@ -217,20 +320,24 @@ namespace handle {
             return;
         }
         page_handle_data* data = this->data_;
-        logger::trace("set highest page {} for position {}"sv, a_page, static_cast<uint32_t>(a_pos));
-        data->highest_set_page_per_position[a_pos] = a_page;
+        LOG_TRACE("set highest page {} for position {}"sv, a_page, static_cast<uint32_t>(a_pos));
+        data->cycle.set_highest_page_position(a_page, a_pos);
     }
 
     position_setting* page_handle::get_page_setting(const uint32_t a_page, const position_type a_position) const {
-        if (const page_handle_data* data = this->data_; data && !data->page_settings.empty() &&
-                                                        data->page_settings.contains(a_page) &&
-                                                        data->page_settings.at(a_page).contains(a_position)) {
-            return data->page_settings.at(a_page).at(a_position);
+        if (const page_handle_data* data = this->data_; data) {
+            const auto key = util::make_page_key(a_page, static_cast<uint32_t>(a_position));
+            if (const auto it = find_page(data->page_settings, key); it != data->page_settings.end()) {
+                return it->second;
+            }
+            if (a_page < mcm::get_max_page_count() && data->empty_page_settings.contains(a_position)) {
+                return data->empty_page_settings.at(a_position);
+            }
         }
         return nullptr;
     }
 
-    std::map<uint32_t, std::map<position_type, position_setting*>> page_handle::get_pages() const {
+    page_handle::page_map page_handle::get_pages() const {
         if (const page_handle_data* data = this->data_; data && !data->page_settings.empty()) {
             return data->page_settings;
         }
@@ -249,12 +356,17 @@ namespace handle {
             return a_active;
         }
 
-        if (const page_handle_data* data = this->data_;
-            data && !data->page_settings.empty() && data->page_settings.contains(data->active_page)) {
-            return data->page_settings.at(data->active_page);
+        std::map<position_type, position_setting*> active;
+        if (const page_handle_data* data = this->data_; data) {
+            for (auto i = 0; i < static_cast<int>(position_type::total); ++i) {
+                const auto pos = static_cast<position_type>(i);
+                if (auto* page_setting = get_page_setting(data->cycle.get_active_page(), pos)) {
+                    active.insert({ pos, page_setting });
+                }
+            }
         }
 
-        return {};
+        return active;
     }
 
     uint32_t page_handle::get_active_page_id() const {
@@ -262,62 +374,92 @@ namespace handle {
             return 0;
         }
         if (const page_handle_data* data = this->data_; data) {
-            return data->active_page;
+            return data->cycle.get_active_page();
         }
         return {};
     }
 
     uint32_t page_handle::get_next_page_id() const {
         if (const page_handle_data* data = this->data_; data) {
-            //let's make it easy for now
-            //we start at 0, so it is max count -1
-            if (data->active_page < config::mcm_setting::get_max_page_count() - 1) {
-                return data->active_page + 1;
-            }
-            return 0;
+            return data->cycle.get_next_page(mcm::get_max_page_count());
         }
         return {};
     }
 
     uint32_t page_handle::get_active_page_id_position(const position_type a_position) const {
-        if (const page_handle_data* data = this->data_;
-            data && !data->active_page_per_position.empty() && data->active_page_per_position.contains(a_position)) {
-            return data->active_page_per_position.at(a_position);
+        if (const page_handle_data* data = this->data_; data) {
+            return data->cycle.get_active_page_position(a_position);
         }
         return 0;
     }
 
     uint32_t page_handle::get_next_page_id_position(const position_type a_position) const {
-        if (const page_handle_data* data = this->data_;
-            data && !data->active_page_per_position.empty() && data->active_page_per_position.contains(a_position)) {
-            if (const auto current = data->active_page_per_position.at(a_position);
-                current < mcm::get_max_page_count() - 1) {
-                return current + 1;
-            }
-            return 0;
+        if (const page_handle_data* data = this->data_; data) {
+            return data->cycle.get_next_page_position(a_position, mcm::get_max_page_count());
         }
         return 0;
     }
 
     //since we reorder 0 to highest is always set
     uint32_t page_handle::get_next_non_empty_setting_for_position(const position_type a_position) const {
-        //if non found it will be 0
-        const auto next = static_cast<int>(get_next_page_id_position(a_position));
-        const auto highest_set = get_highest_page_id_position(a_position);
-        if (next > highest_set) {
-            return 0;
+        if (const page_handle_data* data = this->data_; data) {
+            return data->cycle.get_next_non_empty_page_position(a_position, mcm::get_max_page_count());
         }
-        return next;
+        return 0;
     }
 
     int page_handle::get_highest_page_id_position(const position_type a_position) const {
-        if (const page_handle_data* data = this->data_; data && !data->highest_set_page_per_position.empty() &&
-                                                        data->highest_set_page_per_position.contains(a_position)) {
-            return data->highest_set_page_per_position.at(a_position);
+        if (const page_handle_data* data = this->data_; data) {
+            return data->cycle.get_highest_page_position(a_position);
         }
         return -1;
     }
 
+    void page_handle::materialize_page(const uint32_t a_page, const position_type a_position) const {
+        page_handle_data* data = this->data_;
+        const auto key = util::make_page_key(a_page, static_cast<uint32_t>(a_position));
+        if (find_page(data->page_settings, key) != data->page_settings.end() || a_page >= mcm::get_max_page_count() ||
+            !data->empty_page_settings.contains(a_position)) {
+            return;
+        }
+
+        //the page got cycled to the first time, give it its own copy so changes do not end up on every empty page
+        LOG_TRACE("materialize empty page {}, position {}"sv, a_page, static_cast<uint32_t>(a_position));
+        const auto* empty = data->empty_page_settings.at(a_position);
+        auto* page = new position_setting(*empty);
+        page->page = a_page;
+        page->draw_setting = new position_draw_setting(*empty->draw_setting);
+        page->slot_settings.clear();
+        for (const auto* slot : empty->slot_settings) {
+            page->slot_settings.push_back(new slot_setting(*slot));
+        }
+        get_or_insert_page(data->page_settings, key) = page;
+    }
+
+    page_handle::page_map::const_iterator page_handle::find_page(const page_map& a_pages, const util::page_key a_key) {
+        const auto it = std::ranges::lower_bound(a_pages, a_key, {}, &page_map::value_type::first);
+        return it != a_pages.end() && it->first == a_key ? it : a_pages.end();
+    }
+
+    position_setting*& page_handle::get_or_insert_page(page_map& a_pages, const util::page_key a_key) {
+        auto it = std::ranges::lower_bound(a_pages, a_key, {}, &page_map::value_type::first);
+        if (it == a_pages.end() || it->first != a_key) {
+            it = a_pages.emplace(it, a_key, nullptr);
+        }
+        return it->second;
+    }
+
+    void page_handle::delete_page(const position_setting* a_page) {
+        if (!a_page) {
+            return;
+        }
+        for (const auto* slot : a_page->slot_settings) {
+            delete slot;
+        }
+        delete a_page->draw_setting;
+        delete a_page;
+    }
+
     void page_handle::get_offset_values(const position_type a_position,
         const float a_setting_x,
         const float a_setting_y,
@@ -355,6 +497,11 @@ namespace handle {
     }
 
     ui::icon_image_type page_handle::get_icon_type(const slot_setting::slot_type a_type, RE::TESForm*& a_form) {
+        auto* form_cache = util::form_cache::get_singleton();
+        if (const auto cached = form_cache->get_icon(a_form, a_type)) {
+            return *cached;
+        }
+
         auto icon = icon_type::icon_default;
         switch (a_type) {
             case slot_type::weapon:
@@ -395,6 +542,7 @@ namespace handle {
                 icon = icon_type::icon_default;
                 break;
         }
+        form_cache->set_icon(a_form, a_type, icon);
         return icon;
     }
 
@@ -403,21 +551,23 @@ namespace handle {
             a_icon = icon_type::icon_default;
             return;
         }
+        using keyword_type = util::form_cache::keyword_type;
+        auto* form_cache = util::form_cache::get_singleton();
         switch (const auto* weapon = a_form->As<RE::TESObjectWEAP>(); weapon->GetWeaponType()) {
             case RE::WEAPON_TYPE::kHandToHandMelee:
                 a_icon = icon_type::hand_to_hand;
                 break;
             case RE::WEAPON_TYPE::kOneHandSword:
-                if (weapon->HasKeywordString("WeapTypeRapier")) {
+                if (form_cache->has_keyword(weapon, keyword_type::rapier)) {
                     a_icon = icon_type::rapier;
-                } else if (weapon->HasKeywordString("WeapTypeKatana")) {
+                } else if (form_cache->has_keyword(weapon, keyword_type::katana)) {
                     a_icon = icon_type::katana;
                 } else {
                     a_icon = icon_type::sword_one_handed;
                 }
                 break;
             case RE::WEAPON_TYPE::kOneHandDagger:
-                if (weapon->HasKeywordString("WeapTypeClaw")) {
+                if (form_cache->has_keyword(weapon, keyword_type::claw)) {
                     a_icon = icon_type::claw;
                 } else {
                     a_icon = icon_type::dagger;
@@ -427,23 +577,23 @@ namespace handle {
                 a_icon = icon_type::axe_one_handed;
                 break;
             case RE::WEAPON_TYPE::kOneHandMace:
-                if (weapon->HasKeywordString("WeapTypeWhip")) {
+                if (form_cache->has_keyword(weapon, keyword_type::whip)) {
                     a_icon = icon_type::whip;
                 } else {
                     a_icon = icon_type::mace;
                 }
                 break;
             case RE::WEAPON_TYPE::kTwoHandSword:
-                if (weapon->HasKeywordString("WeapTypePike")) {
+                if (form_cache->has_keyword(weapon, keyword_type::pike)) {
                     a_icon = icon_type::pike;
                 } else {
                     a_icon = icon_type::sword_two_handed;
                 }
                 break;
             case RE::WEAPON_TYPE::kTwoHandAxe:
-                if (weapon->HasKeywordString("WeapTypeHalberd")) {
+                if (form_cache->has_keyword(weapon, keyword_type::halberd)) {
                     a_icon = icon_type::halberd;
-                } else if (weapon->HasKeywordString("WeapTypeQtrStaff")) {
+                } else if (form_cache->has_keyword(weapon, keyword_type::quarter_staff)) {
                     a_icon = icon_type::quarter_staff;
                 } else {
                     a_icon = icon_type::axe_two_handed;
@@ -531,18 +681,8 @@ namespace handle {
             return;
         }
 
-        if (a_form->IsInventoryObject()) {
-            auto* player = RE::PlayerCharacter::GetSingleton();
-            for (auto potential_items = player->GetInventory(); const auto& [item, invData] : potential_items) {
-                if (invData.second->object->formID == a_form->formID) {
-                    a_count = invData.first;
-                    break;
-                }
-            }
-        } else {
-            a_count = 0;
-        }
-        logger::trace("Item {}, count {}"sv, a_form->GetName(), a_count);
+        a_count = item_count_handle::get_singleton()->get_count(a_form);
+        LOG_TRACE("Item {}, count {}"sv, a_form->GetName(), a_count);
     }
 
     void page_handle::get_item_icon(RE::TESForm*& a_form, icon_type& a_icon) {
@@ -596,23 +736,6 @@ namespace handle {
     }
 
     void page_handle::get_consumable_item_count(RE::ActorValue& a_actor_value, int32_t& a_count) {
-        auto* player = RE::PlayerCharacter::GetSingleton();
-        a_count = 0;
-        for (auto potential_items = util::player::get_inventory(player, RE::FormType::AlchemyItem);
-             const auto& [item, inv_data] : potential_items) {
-            const auto& [num_items, entry] = inv_data;
-            auto alchemy_item = item->As<RE::AlchemyItem>();
-            if (alchemy_item->IsPoison() || alchemy_item->IsFood()) {
-                continue;
-            }
-            //returns currently only the types we want
-            auto actor_value = util::helper::get_actor_value_effect_from_potion(item);
-            if (actor_value == RE::ActorValue::kNone) {
-                continue;
-            }
-            if (actor_value == a_actor_value) {
-                a_count = a_count + num_items;
-            }
-        }
+        a_count = item_count_handle::get_singleton()->get_actor_value_count(a_actor_value);
     }
 }
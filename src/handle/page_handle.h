@@ -1,8 +1,11 @@
 ﻿#pragma once
+#include "core/page_cycle.h"
 #include "handle/data/data_helper.h"
+#include "handle/data/page/page_snapshot.h"
 #include "handle/data/page/position_setting.h"
 #include "key_position_handle.h"
 #include "ui/image_path.h"
+#include "util/page_key.h"
 
 namespace handle {
     class page_handle {
@@ -10,6 +13,8 @@ namespace handle {
         using position_type = position_setting::position_type;
         using slot_type = slot_setting::slot_type;
         using icon_type = ui::icon_image_type;
+        //flat map, sorted by key and so by page first, then position. pages are looked up far more often than added
+        using page_map = std::vector<std::pair<util::page_key, position_setting*>>;
 
         static page_handle* get_singleton();
         void init_page(uint32_t a_page,
@@ -17,12 +22,14 @@ namespace handle {
             const std::vector<data_helper*>& data_helpers,
             slot_setting::hand_equip a_hand,
             key_position_handle*& a_key_pos);
+        void init_empty_pages(key_position_handle*& a_key_pos);
+        void restore_page(const page_snapshot& a_snapshot, key_position_handle*& a_key_pos);
         void init_actives(uint32_t a_page, position_type a_position);
         void set_active_page(uint32_t a_page) const;
         void set_active_page_position(uint32_t a_page, position_type a_pos) const;
         void set_highest_page_position(int a_page, position_type a_pos) const;
         [[nodiscard]] position_setting* get_page_setting(uint32_t a_page, position_type a_position) const;
-        [[nodiscard]] std::map<uint32_t, std::map<position_type, position_setting*>> get_pages() const;
+        [[nodiscard]] page_map get_pages() const;
         [[nodiscard]] std::map<position_type, position_setting*> get_active_page() const;
         [[nodiscard]] uint32_t get_active_page_id() const;
         [[nodiscard]] uint32_t get_next_page_id() const;
@@ -42,6 +49,19 @@ namespace handle {
         page_handle() : data_(nullptr) {}
         ~page_handle() = default;
 
+        static position_setting* build_page(uint32_t a_page,
+            position_type a_position,
+            const std::vector<data_helper*>& data_helpers,
+            slot_setting::hand_equip a_hand,
+            key_position_handle*& a_key_pos,
+            const std::vector<int32_t>* a_item_counts = nullptr,
+            const icon_type* a_icon = nullptr);
+        void add_page(position_setting* a_page) const;
+        void materialize_page(uint32_t a_page, position_type a_position) const;
+        static void delete_page(const position_setting* a_page);
+        static page_map::const_iterator find_page(const page_map& a_pages, util::page_key a_key);
+        //the slot for the key, null if the page was not there yet
+        static position_setting*& get_or_insert_page(page_map& a_pages, util::page_key a_key);
         static void get_offset_values(position_type a_position,
             float a_setting_x,
             float a_setting_y,
@@ -61,10 +81,10 @@ namespace handle {
         static void get_consumable_item_count(RE::ActorValue& a_actor_value, int32_t& a_count);
 
         struct page_handle_data {
-            std::map<uint32_t, std::map<position_type, position_setting*>> page_settings;
-            uint32_t active_page = 0;
-            std::map<position_type, uint32_t> active_page_per_position;
-            std::map<position_type, int> highest_set_page_per_position;
+            page_map page_settings;
+            //one empty page per position, shared by every page that is not configured
+            std::map<position_type, position_setting*> empty_page_settings;
+            core::page_cycle cycle;
         };
 
         page_handle_data* data_;
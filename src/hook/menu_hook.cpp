@@ -97,10 +97,10 @@ namespace hook {
                             auto key_position =
                                 handle::key_position_handle::get_singleton()->get_position_for_key(key_);
                             if (binding->get_is_remove_down()) {
-                                logger::trace("doing remove for form"sv);
+                                LOG_TRACE("doing remove for form"sv);
                                 processing::set_setting_data::default_remove(tes_form_menu);
                             } else {
-                                logger::trace("doing add or place for form."sv);
+                                LOG_TRACE("doing add or place for form."sv);
                                 if (config::mcm_setting::get_elden_demon_souls()) {
                                     processing::game_menu_setting::elden_souls_config(tes_form_menu,
                                         key_position,
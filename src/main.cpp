@@ -1,11 +1,36 @@
 #include "control/binding.h"
 #include "event/sink_event.h"
+#include "handle/ammo_index.h"
+#include "handle/equip_state_handle.h"
+#include "handle/item_count_handle.h"
 #include "hook/hook.h"
 #include "papyrus/papyrus.h"
+#include "processing/cycle_commit.h"
+#include "processing/equip_latency.h"
 #include "processing/set_setting_data.h"
+#include "serialization/serialization.h"
 #include "setting/file_setting.h"
 #include "setting/mcm_setting.h"
+#include "setting/setting_watcher.h"
 #include "ui/ui_renderer.h"
+#include "util/form_cache.h"
+#include "util/memory_stats.h"
+#include "util/ring_buffer_sink.h"
+#include "util/trace_recorder.h"
+
+constexpr size_t log_queue_size = 8192;
+
+//lines still in the queue would be lost with the process, the previous filter still gets to do its thing
+static LPTOP_LEVEL_EXCEPTION_FILTER previous_exception_filter = nullptr;
+
+static LONG WINAPI on_unhandled_exception(EXCEPTION_POINTERS* a_exception) {
+    if (auto* sink = util::ring_buffer_sink::get_default(); sink) {
+        logger::critical("unhandled exception {:#x}, writing out the log"sv,
+            a_exception && a_exception->ExceptionRecord ? a_exception->ExceptionRecord->ExceptionCode : 0);
+        sink->drain_now(std::chrono::milliseconds(500));
+    }
+    return previous_exception_filter ? previous_exception_filter(a_exception) : EXCEPTION_CONTINUE_SEARCH;
+}
 
 void init_logger() {
     if (static bool initialized = false; !initialized) {
@@ -21,7 +46,8 @@ void init_logger() {
         }
 
         *path /= fmt::format("{}.log"sv, Version::PROJECT);
-        auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path->string(), true);
+        //the game thread only copies the line, the file gets written by the sink's own thread
+        auto sink = std::make_shared<util::ring_buffer_sink>(path->string(), true, log_queue_size);
         auto log = std::make_shared<spdlog::logger>("global log"s, std::move(sink));
 
         log->set_level(spdlog::level::info);
@@ -44,6 +70,12 @@ void init_logger() {
             spdlog::set_level(spdlog::level::trace);
             spdlog::flush_on(spdlog::level::trace);
         }
+        if (auto* ring = util::ring_buffer_sink::get_default(); ring) {
+            ring->set_block_when_full(config::file_setting::get_log_block_when_full());
+        }
+        //the bindings go in once the data is loaded, before that no key gets handled
+        util::trace_recorder::get_singleton()->set_enabled(config::file_setting::get_record_trace());
+        previous_exception_filter = SetUnhandledExceptionFilter(on_unhandled_exception);
     } catch (const std::exception& e) {
         logger::critical("failed, cause {}"sv, e.what());
     }
@@ -53,7 +85,7 @@ void message_callback(SKSE::MessagingInterface::Message* msg) {
     switch (msg->type) {
         case SKSE::MessagingInterface::kDataLoaded:
             if (ui::ui_renderer::d_3d_init_hook::initialized) {
-                logger::trace("Added Callback for UI. Now load Images, scale values width {}, height {}"sv,
+                LOG_TRACE("Added Callback for UI. Now load Images, scale values width {}, height {}"sv,
                     ui::ui_renderer::get_resolution_scale_width(),
                     ui::ui_renderer::get_resolution_scale_height());
 
@@ -62,16 +94,31 @@ void message_callback(SKSE::MessagingInterface::Message* msg) {
                 papyrus::Register();
                 hook::hook::install();
                 control::binding::get_singleton()->set_all_keys();
+                util::form_cache::get_singleton()->init_keywords();
                 logger::info("done with data loaded"sv);
             }
             break;
         case SKSE::MessagingInterface::kPostLoadGame:
         case SKSE::MessagingInterface::kNewGame:
             logger::info("Running checks for data and hud settings after {}"sv, static_cast<uint32_t>(msg->type));
-            processing::set_setting_data::read_and_set_data();
+            //whatever got cycled to before belongs to the old game
+            processing::cycle_commit::get_singleton()->cancel();
+            util::trace_recorder::get_singleton()->flush();
+            processing::equip_latency::get_singleton()->log_report();
+            handle::item_count_handle::get_singleton()->reset();
+            handle::ammo_index::get_singleton()->reset();
+            util::form_cache::get_singleton()->reset();
+            handle::equip_state_handle::get_singleton()->update();
+            //the co-save already holds the resolved pages, the config is only read if it is missing or stale
+            if (msg->type != SKSE::MessagingInterface::kPostLoadGame || !serialization::page_record::restore()) {
+                processing::set_setting_data::read_and_set_data();
+            }
             processing::set_setting_data::get_actives_and_equip();
             processing::set_setting_data::check_config_data();
             ui::ui_renderer::set_show_ui(config::file_setting::get_show_ui());
+            config::setting_watcher::get_singleton()->start();
+            //growth from one load to the next shows up in here
+            util::memory_stats::log_report();
             logger::info("Done running after {}"sv, static_cast<uint32_t>(msg->type));
             break;
         default:
@@ -87,6 +134,8 @@ EXTERN_C [[maybe_unused]] __declspec(dllexport) bool SKSEAPI SKSEPlugin_Load(con
 
     Init(a_skse);
 
+    serialization::Register();
+
     SKSE::AllocTrampoline(14 * 3);
 
     stl::write_thunk_call<ui::ui_renderer::d_3d_init_hook>();
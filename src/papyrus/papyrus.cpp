@@ -1,29 +1,24 @@
 ﻿#include "papyrus.h"
-#include "control/binding.h"
+#include "processing/equip_latency.h"
 #include "processing/set_setting_data.h"
 #include "setting/custom_setting.h"
 #include "setting/file_setting.h"
 #include "setting/mcm_setting.h"
+#include "setting/setting_watcher.h"
 #include "ui/ui_renderer.h"
 #include "util/constant.h"
 #include "util/helper.h"
+#include "util/memory_stats.h"
 
 namespace papyrus {
     static const char* mcm_name = "LamasTinyHUD_MCM";
 
     void hud_mcm::on_config_close(RE::TESQuest*) {
         logger::info("on config close"sv);
-        config::mcm_setting::read_setting();
-        if (config::mcm_setting::get_elden_demon_souls()) {
-            util::helper::rewrite_settings();
-        }
-        processing::set_setting_data::read_and_set_data();
-        processing::set_setting_data::get_actives_and_equip();
-        control::binding::get_singleton()->set_all_keys();
-        //In case the setting was changed
-        ui::ui_renderer::set_fade(true, 1.f);
-
-        logger::debug("on config close done. return."sv);
+        clear_section_index();
+        //reading and equipping would hold up the script vm, the watcher does it and the hud swaps on the next frame
+        config::setting_watcher::get_singleton()->request_rebuild();
+        LOG_DEBUG("on config close done. return."sv);
     }
 
     RE::BSFixedString hud_mcm::get_resolution_width(RE::TESQuest*) {
@@ -35,28 +30,30 @@ namespace papyrus {
     }
 
     std::vector<RE::BSFixedString> hud_mcm::get_section_names(RE::TESQuest*, uint32_t a_position) {
-        const auto sections = util::helper::get_configured_section_page_names(a_position);
+        auto& index = get_section_index();
+        std::scoped_lock lock(index.lock);
+        const auto& entries = get_section_entries(index, a_position);
         std::vector<RE::BSFixedString> sections_bs_string;
-        sections_bs_string.reserve(sections.size());
-        for (const auto& section : sections) {
-            sections_bs_string.emplace_back(get_form_name_string_for_section(section));
+        sections_bs_string.reserve(entries.size());
+        for (const auto& entry : entries) {
+            sections_bs_string.emplace_back(entry.display_name);
         }
-        logger::trace("Returning {} sections for Position {}"sv, sections_bs_string.size(), a_position);
+        LOG_TRACE("Returning {} sections for Position {}"sv, sections_bs_string.size(), a_position);
         return sections_bs_string;
     }
 
     RE::BSFixedString hud_mcm::get_page(RE::TESQuest*, const uint32_t a_index, uint32_t a_position) {
-        logger::trace("page was requested for index {}"sv, a_index);
-        if (const auto section = get_section_by_index(a_index, a_position); !section.empty()) {
-            return std::to_string(config::custom_setting::get_page_by_section(section));
+        LOG_TRACE("page was requested for index {}"sv, a_index);
+        if (section_entry entry; get_section_entry(a_index, a_position, entry)) {
+            return std::to_string(entry.page);
         }
         return "";
     }
 
     RE::BSFixedString hud_mcm::get_position(RE::TESQuest*, const uint32_t a_index, uint32_t a_position) {
-        logger::trace("position was requested for index {}"sv, a_index);
-        if (const auto section = get_section_by_index(a_index, a_position); !section.empty()) {
-            return std::to_string(config::custom_setting::get_position_by_section(section));
+        LOG_TRACE("position was requested for index {}"sv, a_index);
+        if (section_entry entry; get_section_entry(a_index, a_position, entry)) {
+            return std::to_string(entry.position);
         }
         return "";
     }
@@ -64,77 +61,51 @@ namespace papyrus {
     uint32_t
         hud_mcm::get_selection_type(RE::TESQuest*, const uint32_t a_index, const bool a_left, uint32_t a_position) {
         uint32_t type = 0;
-        if (const auto section = get_section_by_index(a_index, a_position); !section.empty()) {
-            if (a_left) {
-                type = config::custom_setting::get_type_left_by_section(section);
-            } else {
-                type = config::custom_setting::get_type_by_section(section);
-            }
+        if (section_entry entry; get_section_entry(a_index, a_position, entry)) {
+            type = a_left ? entry.type_left : entry.type;
         }
-        logger::trace("return type {} index {}"sv, type, a_index);
+        LOG_TRACE("return type {} index {}"sv, type, a_index);
         return type;
     }
 
     RE::BSFixedString
         hud_mcm::get_form_string(RE::TESQuest*, const uint32_t a_index, const bool a_left, uint32_t a_position) {
         std::string form_string;
-        if (const auto section = get_section_by_index(a_index, a_position); !section.empty()) {
-            if (a_left) {
-                form_string = config::custom_setting::get_item_form_left_by_section(section);
-            } else {
-                form_string = config::custom_setting::get_item_form_by_section(section);
-            }
+        if (section_entry entry; get_section_entry(a_index, a_position, entry)) {
+            form_string = a_left ? entry.form_left : entry.form;
         }
         return form_string;
     }
 
     uint32_t hud_mcm::get_slot_action(RE::TESQuest*, const uint32_t a_index, const bool a_left, uint32_t a_position) {
         uint32_t action = 0;
-        if (const auto section = get_section_by_index(a_index, a_position); !section.empty()) {
-            if (a_left) {
-                action = config::custom_setting::get_slot_action_left_by_section(section);
-            } else {
-                action = config::custom_setting::get_slot_action_by_section(section);
-            }
+        if (section_entry entry; get_section_entry(a_index, a_position, entry)) {
+            action = a_left ? entry.action_left : entry.action;
         }
-        logger::trace("return action {} index {}"sv, action, a_index);
+        LOG_TRACE("return action {} index {}"sv, action, a_index);
         return action;
     }
 
     uint32_t hud_mcm::get_hand_selection(RE::TESQuest*, const uint32_t a_index, uint32_t a_position) {
         uint32_t hand = 0;
-        if (const auto section = get_section_by_index(a_index, a_position); !section.empty()) {
-            hand = config::custom_setting::get_hand_selection_by_section(section);
+        if (section_entry entry; get_section_entry(a_index, a_position, entry)) {
+            hand = entry.hand;
         }
-        logger::trace("return hand {} index {}"sv, hand, a_index);
+        LOG_TRACE("return hand {} index {}"sv, hand, a_index);
         return hand;
     }
 
     RE::BSFixedString
         hud_mcm::get_form_name(RE::TESQuest*, const uint32_t a_index, const bool a_left, uint32_t a_position) {
-        std::string form_string;
-        if (const auto section = get_section_by_index(a_index, a_position); !section.empty()) {
-            if (a_left) {
-                form_string = config::custom_setting::get_item_form_left_by_section(section);
-            } else {
-                form_string = config::custom_setting::get_item_form_by_section(section);
-            }
-        }
-
-        if (form_string.empty()) {
-            return form_string;
-        }
-
-        const auto* form = util::helper::get_form_from_mod_id_string(form_string);
-        if (!form) {
-            return form_string;
+        std::string form_name;
+        if (section_entry entry; get_section_entry(a_index, a_position, entry)) {
+            form_name = a_left ? entry.form_name_left : entry.form_name;
         }
-
-        return form->GetName();
+        return form_name;
     }
 
     void hud_mcm::reset_section(RE::TESQuest*, const uint32_t a_index, uint32_t a_position) {
-        logger::trace("reset section was called for index {}"sv, a_index);
+        LOG_TRACE("reset section was called for index {}"sv, a_index);
         if (const auto section = get_section_by_index(a_index, a_position); !section.empty()) {
             config::custom_setting::reset_section(section);
         }
@@ -145,7 +116,7 @@ namespace papyrus {
         const bool a_left,
         const uint32_t a_value,
         uint32_t a_position) {
-        logger::trace("set action was called for index {}, left {}, value {}"sv, a_index, a_left, a_value);
+        LOG_TRACE("set action was called for index {}, left {}, value {}"sv, a_index, a_left, a_value);
         if (const auto section = get_section_by_index(a_index, a_position); !section.empty()) {
             if (a_left) {
                 config::custom_setting::write_slot_action_left_by_section(section, a_value);
@@ -156,7 +127,7 @@ namespace papyrus {
     }
 
     std::vector<RE::BSFixedString> hud_mcm::get_config_files(RE::TESQuest*, bool a_elden) {
-        logger::trace("getting config files for elden {}"sv, a_elden);
+        LOG_TRACE("getting config files for elden {}"sv, a_elden);
         auto files = search_for_config_files(a_elden);
         std::vector<RE::BSFixedString> file_list;
         file_list.reserve(files.size());
@@ -169,7 +140,7 @@ namespace papyrus {
 
     RE::BSFixedString hud_mcm::get_active_config(RE::TESQuest*, bool a_elden) {
         auto file = a_elden ? config::file_setting::get_config_elden() : config::file_setting::get_config_default();
-        logger::trace("getting active Config File, Elden {}, File {}"sv, a_elden, file);
+        LOG_TRACE("getting active Config File, Elden {}, File {}"sv, a_elden, file);
         return file;
     }
 
@@ -192,7 +163,7 @@ namespace papyrus {
                 logger::warn("Did not set new file, already exists, name {}"sv, name);
             }
         }
-        logger::trace("set config elden {}, file {}"sv, a_elden, name);
+        LOG_TRACE("set config elden {}, file {}"sv, a_elden, name);
     }
 
     void hud_mcm::set_active_config(RE::TESQuest*, bool a_elden, uint32_t a_index) {
@@ -210,8 +181,15 @@ namespace papyrus {
     }
 
     void hud_mcm::add_unarmed_setting(RE::TESQuest*, uint32_t a_position) {
+        //the vm thread must not free pages, so it is handed to the main thread
+        if (auto* task = SKSE::GetTaskInterface(); task) {
+            task->AddTask([a_position]() { add_unarmed(a_position); });
+        }
+    }
+
+    void hud_mcm::add_unarmed(const uint32_t a_position) {
         auto elden = config::mcm_setting::get_elden_demon_souls();
-        logger::trace("Try to add Unarmed for Position {}, Elden {}"sv, a_position, elden);
+        LOG_TRACE("Try to add Unarmed for Position {}, Elden {}"sv, a_position, elden);
         auto* page_handle = handle::page_handle::get_singleton();
         auto position = static_cast<handle::position_setting::position_type>(a_position);
         std::vector<data_helper*> data;
@@ -264,7 +242,7 @@ namespace papyrus {
             data.push_back(item2);
         }
         processing::set_setting_data::set_single_slot(next_page, position, data);
-        logger::trace("Added Unarmed Setting Page {}, Position {}, Setting Count {}"sv,
+        LOG_TRACE("Added Unarmed Setting Page {}, Position {}, Setting Count {}"sv,
             next_page,
             a_position,
             data.size());
@@ -272,12 +250,61 @@ namespace papyrus {
 
     RE::BSFixedString hud_mcm::get_actor_value(RE::TESQuest*, uint32_t a_index, uint32_t a_position) {
         std::string form_string;
-        if (const auto section = get_section_by_index(a_index, a_position); !section.empty()) {
-            form_string = std::to_string(config::custom_setting::get_effect_actor_value(section));
+        if (section_entry entry; get_section_entry(a_index, a_position, entry)) {
+            form_string = std::to_string(entry.actor_value);
         }
         return form_string;
     }
 
+    std::vector<RE::BSFixedString> hud_mcm::get_page_data(RE::TESQuest*, uint32_t a_position) {
+        auto& index = get_section_index();
+        std::scoped_lock lock(index.lock);
+        const auto& entries = get_section_entries(index, a_position);
+
+        std::vector<RE::BSFixedString> page_data(entries.size() * page_data_field_count);
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const auto& entry = entries[i];
+            const auto base = i * page_data_field_count;
+            const auto set = [&](page_data_field a_field, const std::string& a_value) {
+                page_data[base + static_cast<uint32_t>(a_field)] = a_value;
+            };
+            set(page_data_field::page, std::to_string(entry.page));
+            set(page_data_field::position, std::to_string(entry.position));
+            set(page_data_field::type, std::to_string(entry.type));
+            set(page_data_field::hand, std::to_string(entry.hand));
+            set(page_data_field::action, std::to_string(entry.action));
+            set(page_data_field::form_name, entry.form_name);
+            set(page_data_field::form, entry.form);
+            set(page_data_field::type_left, std::to_string(entry.type_left));
+            set(page_data_field::action_left, std::to_string(entry.action_left));
+            set(page_data_field::form_name_left, entry.form_name_left);
+            set(page_data_field::form_left, entry.form_left);
+            set(page_data_field::actor_value, std::to_string(entry.actor_value));
+        }
+        LOG_TRACE("Returning data of {} pages for Position {}"sv, entries.size(), a_position);
+        return page_data;
+    }
+
+    std::vector<RE::BSFixedString> hud_mcm::get_equip_latency(RE::TESQuest*) {
+        const auto report = processing::equip_latency::get_singleton()->get_report();
+        std::vector<RE::BSFixedString> lines;
+        lines.reserve(report.size());
+        for (const auto& line : report) {
+            lines.emplace_back(line);
+        }
+        return lines;
+    }
+
+    std::vector<RE::BSFixedString> hud_mcm::get_memory_report(RE::TESQuest*) {
+        const auto report = util::memory_stats::get_report();
+        std::vector<RE::BSFixedString> lines;
+        lines.reserve(report.size());
+        for (const auto& line : report) {
+            lines.emplace_back(line);
+        }
+        return lines;
+    }
+
     bool hud_mcm::Register(RE::BSScript::IVirtualMachine* a_vm) {
         a_vm->RegisterFunction("OnConfigClose", mcm_name, on_config_close);
         a_vm->RegisterFunction("GetResolutionWidth", mcm_name, get_resolution_width);
@@ -299,13 +326,16 @@ namespace papyrus {
         a_vm->RegisterFunction("SetActiveConfig", mcm_name, set_active_config);
         a_vm->RegisterFunction("AddUnarmedSetting", mcm_name, add_unarmed_setting);
         a_vm->RegisterFunction("GetActorValue", mcm_name, get_actor_value);
+        a_vm->RegisterFunction("GetPageData", mcm_name, get_page_data);
+        a_vm->RegisterFunction("GetEquipLatency", mcm_name, get_equip_latency);
+        a_vm->RegisterFunction("GetMemoryReport", mcm_name, get_memory_report);
 
         logger::info("Registered {} class. return."sv, mcm_name);
         return true;
     }
 
     bool hud_mcm::is_size_ok(uint32_t a_idx, uint64_t a_size) {
-        if (a_idx > a_size) {
+        if (a_idx >= a_size) {
             logger::warn("Index is {} but size is just {}, does not fit. return."sv, a_idx, a_size);
             return false;
         }
@@ -314,13 +344,91 @@ namespace papyrus {
 
     std::string hud_mcm::get_section_by_index(const uint32_t a_index, uint32_t a_position) {
         std::string section;
-        if (const auto sections = util::helper::get_configured_section_page_names(a_position);
-            !sections.empty() && is_size_ok(a_index, sections.size())) {
-            section = sections.at(a_index);
+        if (section_entry entry; get_section_entry(a_index, a_position, entry)) {
+            section = std::move(entry.section);
         }
-        logger::trace("got section {} for index {}"sv, section, a_index);
+        LOG_TRACE("got section {} for index {}"sv, section, a_index);
         return section;
     }
+
+    hud_mcm::section_index& hud_mcm::get_section_index() {
+        static section_index index;
+        return index;
+    }
+
+    const std::vector<hud_mcm::section_entry>& hud_mcm::get_section_entries(section_index& a_index,
+        uint32_t a_position) {
+        static const std::vector<section_entry> none;
+        if (a_position > util::page_key_position_count) {
+            return none;
+        }
+
+        //anything that writes the file moves the write time, so does an edit from outside the game
+        auto path = config::custom_setting::get_file_path();
+        std::error_code error;
+        const auto write_time = std::filesystem::last_write_time(path, error);
+        if (a_index.valid && a_index.path == path && !error && a_index.write_time == write_time) {
+            return a_index.positions[a_position];
+        }
+
+        for (auto& entries : a_index.positions) {
+            entries.clear();
+        }
+        auto& all = a_index.positions[util::page_key_position_count];
+        //the main thread may load a new config meanwhile, the section names point into the old one
+        const auto lock = config::custom_setting::lock_setting();
+        config::custom_setting::read_setting();
+        for (const auto sections = config::custom_setting::get_sections(); const auto& section : sections) {
+            section_entry entry;
+            entry.section = section.pItem;
+            entry.page = config::custom_setting::get_page_by_section(entry.section);
+            entry.position = config::custom_setting::get_position_by_section(entry.section);
+            entry.type = config::custom_setting::get_type_by_section(entry.section);
+            entry.form = config::custom_setting::get_item_form_by_section(entry.section);
+            entry.action = config::custom_setting::get_slot_action_by_section(entry.section);
+            entry.hand = config::custom_setting::get_hand_selection_by_section(entry.section);
+            entry.type_left = config::custom_setting::get_type_left_by_section(entry.section);
+            entry.form_left = config::custom_setting::get_item_form_left_by_section(entry.section);
+            entry.action_left = config::custom_setting::get_slot_action_left_by_section(entry.section);
+            entry.actor_value = config::custom_setting::get_effect_actor_value(entry.section);
+            entry.form_name = get_form_name_string(entry.form);
+            entry.form_name_left = get_form_name_string(entry.form_left);
+            entry.display_name = get_form_name_string_for_section(entry);
+
+            if (entry.position < util::page_key_position_count) {
+                a_index.positions[entry.position].push_back(entry);
+            }
+            all.push_back(std::move(entry));
+        }
+        a_index.path = std::move(path);
+        a_index.write_time = write_time;
+        //without a time the next call reads again
+        a_index.valid = !error;
+        LOG_TRACE("indexed {} sections of {}"sv, all.size(), a_index.path);
+
+        return a_index.positions[a_position];
+    }
+
+    bool hud_mcm::get_section_entry(const uint32_t a_index, const uint32_t a_position, section_entry& a_entry) {
+        auto& index = get_section_index();
+        std::scoped_lock lock(index.lock);
+        const auto& entries = get_section_entries(index, a_position);
+        if (entries.empty() || !is_size_ok(a_index, entries.size())) {
+            return false;
+        }
+        a_entry = entries[a_index];
+        return true;
+    }
+
+    void hud_mcm::clear_section_index() {
+        auto& index = get_section_index();
+        std::scoped_lock lock(index.lock);
+        index.valid = false;
+        for (auto& entries : index.positions) {
+            entries.clear();
+        }
+    }
+
     bool hud_mcm::check_name(const std::string& a_name) {
         //check if the file exists
         auto files = search_for_config_files(true);
@@ -345,12 +453,12 @@ namespace papyrus {
             file_name = util::ini_elden_name;
         }
 
-        logger::trace("Will start looking in Path {}"sv, util::ini_path);
+        LOG_TRACE("Will start looking in Path {}"sv, util::ini_path);
         if (std::filesystem::is_directory(util::ini_path)) {
             for (const auto& entry : std::filesystem::directory_iterator(util::ini_path)) {
                 if (is_regular_file(entry) && entry.path().extension() == util::ini_ending &&
                     entry.path().filename().string().starts_with(file_name)) {
-                    logger::trace("found file {}, path {}"sv, entry.path().filename().string(), entry.path().string());
+                    LOG_TRACE("found file {}, path {}"sv, entry.path().filename().string(), entry.path().string());
                     if (!a_elden && entry.path().filename().string().starts_with(util::ini_elden_name)) {
                         logger::warn("Skipping File {}, because it would also match for Elden"sv,
                             entry.path().filename().string());
@@ -360,22 +468,33 @@ namespace papyrus {
                 }
             }
         }
-        logger::trace("Got {} Files to return in Path"sv, file_list.size());
+        LOG_TRACE("Got {} Files to return in Path"sv, file_list.size());
         return file_list;
     }
 
-    std::string hud_mcm::get_form_name_string_for_section(const std::string& a_str) {
+    std::string hud_mcm::get_form_name_string(const std::string& a_form_string) {
+        if (a_form_string.empty()) {
+            return a_form_string;
+        }
+
+        const auto* form = util::helper::get_form_from_mod_id_string(a_form_string);
+        if (!form) {
+            return a_form_string;
+        }
+
+        return form->GetName();
+    }
+
+    std::string hud_mcm::get_form_name_string_for_section(const section_entry& a_entry) {
         std::string display_string;
-        auto form_string = config::custom_setting::get_item_form_by_section(a_str);
-        auto form_string_left = config::custom_setting::get_item_form_left_by_section(a_str);
 
         RE::TESForm* form = nullptr;
-        if (!form_string.empty()) {
-            form = util::helper::get_form_from_mod_id_string(form_string);
+        if (!a_entry.form.empty()) {
+            form = util::helper::get_form_from_mod_id_string(a_entry.form);
         }
         RE::TESForm* form_left = nullptr;
-        if (!form_string_left.empty()) {
-            form_left = util::helper::get_form_from_mod_id_string(form_string_left);
+        if (!a_entry.form_left.empty()) {
+            form_left = util::helper::get_form_from_mod_id_string(a_entry.form_left);
         }
 
         //if form is null check if av is set
@@ -398,14 +517,14 @@ namespace papyrus {
         }
 
         if (display_string.empty()) {
-            auto actor_value = static_cast<RE::ActorValue>(config::custom_setting::get_effect_actor_value(a_str));
+            auto actor_value = static_cast<RE::ActorValue>(a_entry.actor_value);
             if (util::actor_value_to_base_potion_map_.contains(actor_value)) {
                 auto* potion_form = RE::TESForm::LookupByID(util::actor_value_to_base_potion_map_[actor_value]);
                 display_string = potion_form ? potion_form->GetName() : "";
             }
         }
 
-        return display_string.empty() ? a_str : display_string;
+        return display_string.empty() ? a_entry.section : display_string;
     }
 
     void Register() {
@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include "util/page_key.h"
 
 namespace papyrus {
     class hud_mcm {
@@ -24,15 +25,72 @@ namespace papyrus {
         static void set_active_config(RE::TESQuest*, bool a_elden, uint32_t a_index);
         static void add_unarmed_setting(RE::TESQuest*, uint32_t a_position);
         static RE::BSFixedString get_actor_value(RE::TESQuest*, uint32_t a_index, uint32_t a_position);
+        //every page of the position in one go, page_data_field_count values per page in the order of page_data_field
+        static std::vector<RE::BSFixedString> get_page_data(RE::TESQuest*, uint32_t a_position);
+        //input to equip percentiles, one line per kind of action
+        static std::vector<RE::BSFixedString> get_equip_latency(RE::TESQuest*);
+        //held memory per subsystem, the same lines the log gets on each load
+        static std::vector<RE::BSFixedString> get_memory_report(RE::TESQuest*);
 
         static bool Register(RE::BSScript::IVirtualMachine* a_vm);
 
+        enum class page_data_field : std::uint32_t {
+            page = 0,
+            position = 1,
+            type = 2,
+            hand = 3,
+            action = 4,
+            form_name = 5,
+            form = 6,
+            type_left = 7,
+            action_left = 8,
+            form_name_left = 9,
+            form_left = 10,
+            actor_value = 11
+        };
+        static constexpr uint32_t page_data_field_count = 12;
+
     private:
+        struct section_entry {
+            std::string section;
+            uint32_t page = 0;
+            uint32_t position = 0;
+            uint32_t type = 0;
+            std::string form;
+            uint32_t action = 0;
+            uint32_t hand = 0;
+            uint32_t type_left = 0;
+            std::string form_left;
+            uint32_t action_left = 0;
+            int actor_value = -1;
+            std::string form_name;
+            std::string form_name_left;
+            std::string display_name;
+        };
+
+        //the custom config as the mcm sees it, read once and kept until the file or the path changes.
+        //the last list holds every section, like position total does for get_configured_section_page_names
+        struct section_index {
+            std::mutex lock;
+            std::string path;
+            std::filesystem::file_time_type write_time;
+            bool valid = false;
+            std::array<std::vector<section_entry>, util::page_key_position_count + 1> positions;
+        };
+
         static bool is_size_ok(uint32_t a_idx, uint64_t a_size);
         static std::string get_section_by_index(uint32_t a_index, uint32_t a_position);
+        static section_index& get_section_index();
+        //expects the index lock to be held
+        static const std::vector<section_entry>& get_section_entries(section_index& a_index, uint32_t a_position);
+        static bool get_section_entry(uint32_t a_index, uint32_t a_position, section_entry& a_entry);
+        static void clear_section_index();
+        static std::string get_form_name_string(const std::string& a_form_string);
         static bool check_name(const std::string& a_name);
         static std::vector<std::string> search_for_config_files(bool a_elden);
-        static std::string get_form_name_string_for_section(const std::string& a_str);
+        //only on the main thread, it replaces pages the hud may still point to
+        static void add_unarmed(uint32_t a_position);
+        static std::string get_form_name_string_for_section(const section_entry& a_entry);
     };
 
     void Register();
@@ -0,0 +1,210 @@
+#include "action_queue.h"
+#include "equip/equip_slot.h"
+#include "equip/item.h"
+#include "equip/magic.h"
+#include "equip_latency.h"
+#include "handle/equip_state_handle.h"
+#include "handle/extra_data_holder.h"
+#include "util/string_util.h"
+
+namespace processing {
+    action_queue* action_queue::get_singleton() {
+        static action_queue singleton;
+        return std::addressof(singleton);
+    }
+
+    void action_queue::add(const queued_action& a_action) {
+        if (!this->data_) {
+            this->data_ = new action_queue_data();
+        }
+        action_queue_data* data = this->data_;
+
+        std::scoped_lock lock(data->lock);
+        //keep the order of the last request, everything before it for the same slot is not needed anymore
+        if (const auto target = get_equip_target(a_action); target != equip_target::none) {
+            std::erase_if(data->actions,
+                [target](const queued_action& a_queued) { return get_equip_target(a_queued) == target; });
+            //the earlier ones are dropped anyway, that keeps what is equipped now
+            if (is_equipped(a_action, target)) {
+                LOG_TRACE("form {} is equipped already, nothing to queue"sv,
+                    util::string_util::int_to_hex(a_action.form->GetFormID()));
+                return;
+            }
+        }
+        auto& queued = data->actions.emplace_back(a_action);
+        if (!queued.input_time) {
+            queued.input_time = equip_latency::get_singleton()->get_input_time();
+        }
+        LOG_TRACE("queued action kind {}, type {}, form {}, {} queued"sv,
+            static_cast<uint32_t>(a_action.kind),
+            static_cast<uint32_t>(a_action.type),
+            a_action.form ? util::string_util::int_to_hex(a_action.form->GetFormID()) : "null",
+            data->actions.size());
+
+        if (data->task_queued) {
+            return;
+        }
+        if (auto* task = SKSE::GetTaskInterface(); task) {
+            data->task_queued = true;
+            task->AddTask([this]() { run(); });
+        }
+    }
+
+    void action_queue::run() const {
+        action_queue_data* data = this->data_;
+        std::vector<queued_action> actions;
+        {
+            std::scoped_lock lock(data->lock);
+            actions.swap(data->actions);
+            data->task_queued = false;
+        }
+        if (actions.empty()) {
+            return;
+        }
+
+        auto* player = RE::PlayerCharacter::GetSingleton();
+        LOG_TRACE("running {} actions"sv, actions.size());
+        auto* latency = equip_latency::get_singleton();
+        auto* equip_state = handle::equip_state_handle::get_singleton();
+        for (const auto& action : actions) {
+            execute(action, player);
+            //the equip event comes later, a press for what was in hand before must not be dropped until then
+            if (const auto target = get_equip_target(action); target != equip_target::none) {
+                equip_state->set_pending(get_state_target(target), action.form);
+            }
+            //execute called the equip manager itself, so this is when the game got the equip
+            if (action.input_time) {
+                latency->on_executed(action, *action.input_time);
+            }
+        }
+    }
+
+    action_queue::equip_target action_queue::get_equip_target(const queued_action& a_action) {
+        const auto hand = a_action.equip_slot == equip::equip_slot::get_left_hand_slot() ? equip_target::left :
+                                                                                           equip_target::right;
+        switch (a_action.kind) {
+            case action_kind::un_equip_hand:
+                return hand;
+            case action_kind::un_equip_voice:
+                return equip_target::voice;
+            case action_kind::ammo:
+                return equip_target::ammo;
+            case action_kind::execute:
+                break;
+        }
+
+        //instant casts and consumables do something each time, they are never replaced
+        if (a_action.action != action_type::default_action && a_action.type != slot_type::empty) {
+            return equip_target::none;
+        }
+        switch (a_action.type) {
+            case slot_type::weapon:
+            case slot_type::shield:
+            case slot_type::light:
+            case slot_type::magic:
+            case slot_type::empty:
+                return hand;
+            case slot_type::shout:
+            case slot_type::power:
+                return equip_target::voice;
+            case slot_type::consumable:
+            case slot_type::armor:
+            case slot_type::scroll:
+            case slot_type::misc:
+            case slot_type::lantern:
+            case slot_type::mask:
+                break;
+        }
+        return equip_target::none;
+    }
+
+    handle::equip_state_handle::equip_target action_queue::get_state_target(const equip_target a_target) {
+        using state_target_type = handle::equip_state_handle::equip_target;
+        switch (a_target) {
+            case equip_target::right:
+                return state_target_type::right;
+            case equip_target::left:
+                return state_target_type::left;
+            case equip_target::voice:
+                return state_target_type::voice;
+            case equip_target::ammo:
+                return state_target_type::ammo;
+            case equip_target::none:
+                break;
+        }
+        return state_target_type::total;
+    }
+
+    bool action_queue::is_equipped(const queued_action& a_action, const equip_target a_target) {
+        if (!a_action.form || a_action.kind == action_kind::un_equip_hand ||
+            a_action.kind == action_kind::un_equip_voice) {
+            return false;
+        }
+        //a specific one of the same item is asked for, that might not be the one in hand
+        if (handle::extra_data_holder::get_singleton()->is_form_set(a_action.form)) {
+            return false;
+        }
+        if (a_action.kind == action_kind::execute &&
+            (a_action.type == slot_type::empty || a_action.action != action_type::default_action)) {
+            return false;
+        }
+
+        return handle::equip_state_handle::get_singleton()->is_equipped(a_action.form, get_state_target(a_target));
+    }
+
+    void action_queue::execute(const queued_action& a_action, RE::PlayerCharacter*& a_player) {
+        auto* equip_slot = a_action.equip_slot;
+        switch (a_action.kind) {
+            case action_kind::un_equip_hand:
+                equip::equip_slot::un_equip_hand(equip_slot, a_player, action_type::un_equip);
+                return;
+            case action_kind::un_equip_voice:
+                equip::equip_slot::un_equip_shout_slot(a_player);
+                return;
+            case action_kind::ammo:
+                equip::item::equip_ammo(a_action.form, a_player);
+                return;
+            case action_kind::execute:
+                break;
+        }
+
+        switch (a_action.type) {
+            case slot_type::consumable:
+                if (a_action.form) {
+                    equip::item::consume_potion(a_action.form, a_player);
+                } else if (a_action.actor_value != RE::ActorValue::kNone) {
+                    equip::item::find_and_consume_fitting_option(a_action.actor_value, a_player);
+                }
+                break;
+            case slot_type::magic:
+                equip::magic::cast_magic(a_action.form, a_action.action, equip_slot, a_player);
+                break;
+            case slot_type::shout:
+                equip::magic::equip_shout(a_action.form, a_player);
+                break;
+            case slot_type::power:
+                equip::magic::equip_or_cast_power(a_action.form, a_action.action, a_player);
+                break;
+            case slot_type::weapon:
+            case slot_type::shield:
+            case slot_type::light:
+                equip::item::equip_item(a_action.form, equip_slot, a_player, a_action.type);
+                break;
+            case slot_type::armor:
+            case slot_type::lantern:
+            case slot_type::mask:
+                equip::item::equip_armor(a_action.form, a_player);
+                break;
+            case slot_type::scroll:
+                equip::magic::cast_scroll(a_action.form, a_action.action, a_player);
+                break;
+            case slot_type::misc:
+                //TODO
+                logger::warn("ignoring misc-item."sv);
+                break;
+            case slot_type::empty:
+                equip::equip_slot::un_equip_hand(equip_slot, a_player, a_action.action);
+                break;
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "handle/data/page/slot_setting.h"
+#include "handle/equip_state_handle.h"
+
+namespace processing {
+    //collects what the input asked for during a frame and runs it in one task. a later equip into the same hand,
+    //the voice or the ammo slot replaces an earlier one, so only the last of a quick series reaches the game
+    class action_queue {
+    public:
+        using slot_type = handle::slot_setting::slot_type;
+        using action_type = handle::slot_setting::action_type;
+
+        enum class action_kind : std::uint32_t { execute = 0, un_equip_hand = 1, un_equip_voice = 2, ammo = 3 };
+
+        //a copy of the slot values, the slot itself might be gone once the task runs
+        struct queued_action {
+            action_kind kind = action_kind::execute;
+            slot_type type = slot_type::empty;
+            RE::TESForm* form = nullptr;
+            action_type action = action_type::default_action;
+            RE::BGSEquipSlot* equip_slot = nullptr;
+            RE::ActorValue actor_value = RE::ActorValue::kNone;
+            //when the key went down, taken from equip_latency if not set
+            std::optional<std::chrono::steady_clock::time_point> input_time;
+        };
+
+        static action_queue* get_singleton();
+        void add(const queued_action& a_action);
+
+        action_queue(const action_queue&) = delete;
+        action_queue(action_queue&&) = delete;
+
+        action_queue& operator=(const action_queue&) const = delete;
+        action_queue& operator=(action_queue&&) const = delete;
+
+    private:
+        action_queue() : data_(nullptr) {}
+        ~action_queue() = default;
+
+        //which slot an action fills, none for the ones that can not be replaced like casts or potions
+        enum class equip_target : std::uint32_t { none = 0, right = 1, left = 2, voice = 3, ammo = 4 };
+
+        void run() const;
+        static equip_target get_equip_target(const queued_action& a_action);
+        static handle::equip_state_handle::equip_target get_state_target(equip_target a_target);
+        static bool is_equipped(const queued_action& a_action, equip_target a_target);
+        static void execute(const queued_action& a_action, RE::PlayerCharacter*& a_player);
+
+        struct action_queue_data {
+            std::mutex lock;
+            std::vector<queued_action> actions;
+            bool task_queued = false;
+        };
+
+        action_queue_data* data_;
+    };
+}
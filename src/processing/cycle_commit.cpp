@@ -0,0 +1,125 @@
+#include "cycle_commit.h"
+#include "equip_latency.h"
+#include "setting/mcm_setting.h"
+#include "setting_execute.h"
+
+namespace processing {
+    using mcm = config::mcm_setting;
+
+    cycle_commit* cycle_commit::get_singleton() {
+        static cycle_commit singleton;
+        return std::addressof(singleton);
+    }
+
+    bool cycle_commit::schedule(const position_type a_position, const bool a_only_equip) {
+        const auto delay = mcm::get_cycle_commit_delay();
+        if (delay == 0 || a_position == position_type::total) {
+            return false;
+        }
+
+        if (!this->data_) {
+            this->data_ = new cycle_commit_data();
+            this->data_->thread = std::jthread([this](const std::stop_token& a_stop) { run(a_stop); });
+            logger::info("started cycle commit thread"sv);
+        }
+        cycle_commit_data* data = this->data_;
+
+        {
+            std::scoped_lock lock(data->lock);
+            auto& [active, only_equip, generation, due, input_time] = data->pending[static_cast<size_t>(a_position)];
+            only_equip = a_only_equip;
+            active = true;
+            ++generation;
+            due = clock::now() + std::chrono::milliseconds(delay);
+            input_time = equip_latency::get_singleton()->get_input_time();
+            LOG_TRACE("commit for position {} in {}ms, generation {}"sv,
+                static_cast<uint32_t>(a_position),
+                delay,
+                generation);
+        }
+        data->wake.notify_one();
+        return true;
+    }
+
+    void cycle_commit::cancel() const {
+        if (!this->data_) {
+            return;
+        }
+        cycle_commit_data* data = this->data_;
+        std::scoped_lock lock(data->lock);
+        for (auto& pending : data->pending) {
+            pending.active = false;
+            ++pending.generation;
+        }
+        LOG_TRACE("dropped pending commits"sv);
+    }
+
+    void cycle_commit::run(const std::stop_token& a_stop) const {
+        cycle_commit_data* data = this->data_;
+        const auto any_active = [data] {
+            return std::ranges::any_of(data->pending, [](const pending_commit& a_pending) { return a_pending.active; });
+        };
+
+        while (!a_stop.stop_requested()) {
+            std::unique_lock lock(data->lock);
+            if (!data->wake.wait(lock, a_stop, any_active)) {
+                break;
+            }
+
+            auto next = clock::time_point::max();
+            for (const auto& pending : data->pending) {
+                if (pending.active) {
+                    next = std::min(next, pending.due);
+                }
+            }
+            //a press in between pushes the due time back, that is checked again in the next round
+            if (data->wake.wait_until(lock, a_stop, next, [] { return false; }); a_stop.stop_requested()) {
+                break;
+            }
+
+            const auto now = clock::now();
+            for (auto i = 0; i < static_cast<int>(data->pending.size()); ++i) {
+                auto& pending = data->pending[i];
+                if (!pending.active || pending.due > now) {
+                    continue;
+                }
+                pending.active = false;
+                if (auto* task = SKSE::GetTaskInterface(); task) {
+                    task->AddTask([this,
+                                      position = static_cast<position_type>(i),
+                                      only_equip = pending.only_equip,
+                                      generation = pending.generation,
+                                      input_time = pending.input_time]() {
+                        commit(position, only_equip, generation, input_time);
+                    });
+                }
+            }
+        }
+    }
+
+    void cycle_commit::commit(const position_type a_position,
+        const bool a_only_equip,
+        const uint64_t a_generation,
+        const std::optional<clock::time_point> a_input_time) const {
+        {
+            std::scoped_lock lock(this->data_->lock);
+            if (this->data_->pending[static_cast<size_t>(a_position)].generation != a_generation) {
+                LOG_TRACE("commit for position {} got replaced. return."sv, static_cast<uint32_t>(a_position));
+                return;
+            }
+        }
+
+        auto* position_setting = setting_execute::get_position_setting_for_position(a_position);
+        if (!position_setting) {
+            return;
+        }
+        LOG_DEBUG("committing position {}, only equip {}"sv, static_cast<uint32_t>(a_position), a_only_equip);
+        //the actions queued now belong to the press that scheduled the commit
+        auto* latency = equip_latency::get_singleton();
+        if (a_input_time) {
+            latency->set_input_time(*a_input_time);
+        }
+        setting_execute::activate(position_setting->slot_settings, a_only_equip);
+        latency->clear_input_time();
+    }
+}
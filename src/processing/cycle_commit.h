@@ -0,0 +1,54 @@
+#pragma once
+#include "handle/data/page/position_setting.h"
+
+namespace processing {
+    //with a delay set, cycling in elden mode only moves the highlight. the equip for the position happens once its key
+    //was left alone for the delay, so tapping through a few items equips just the last one
+    class cycle_commit {
+    public:
+        using position_type = handle::position_setting::position_type;
+
+        static cycle_commit* get_singleton();
+        //false if there is no delay set, then the caller activates right away
+        bool schedule(position_type a_position, bool a_only_equip);
+        //drops everything not equipped yet, the pages are about to change
+        void cancel() const;
+
+        cycle_commit(const cycle_commit&) = delete;
+        cycle_commit(cycle_commit&&) = delete;
+
+        cycle_commit& operator=(const cycle_commit&) const = delete;
+        cycle_commit& operator=(cycle_commit&&) const = delete;
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        cycle_commit() : data_(nullptr) {}
+        ~cycle_commit() = default;
+
+        struct pending_commit {
+            bool active = false;
+            bool only_equip = false;
+            //a newer press on the position makes an already queued commit useless
+            uint64_t generation = 0;
+            clock::time_point due;
+            //of the last press, the latency counts the delay as well
+            std::optional<clock::time_point> input_time;
+        };
+
+        void run(const std::stop_token& a_stop) const;
+        void commit(position_type a_position,
+            bool a_only_equip,
+            uint64_t a_generation,
+            std::optional<clock::time_point> a_input_time) const;
+
+        struct cycle_commit_data {
+            std::jthread thread;
+            std::mutex lock;
+            std::condition_variable_any wake;
+            std::array<pending_commit, static_cast<size_t>(position_type::total)> pending;
+        };
+
+        cycle_commit_data* data_;
+    };
+}
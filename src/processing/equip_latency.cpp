@@ -0,0 +1,187 @@
+#include "equip_latency.h"
+
+namespace processing {
+    //an equip event later than that is not the answer to the action anymore
+    constexpr auto pending_timeout = std::chrono::seconds(5);
+    //every that many actions the numbers go into the log, next to the report on each load
+    constexpr uint64_t report_interval = 250;
+
+    constexpr std::array<std::string_view, static_cast<size_t>(equip_latency::action_group::total)> group_names = {
+        "weapon",
+        "magic",
+        "voice",
+        "armor",
+        "consumable",
+        "ammo",
+        "un_equip"
+    };
+
+    equip_latency* equip_latency::get_singleton() {
+        static equip_latency singleton;
+        return std::addressof(singleton);
+    }
+
+    void equip_latency::set_input_time(const clock::time_point a_time) {
+        if (!this->data_) {
+            this->data_ = new equip_latency_data();
+        }
+        std::scoped_lock lock(this->data_->lock);
+        this->data_->input_time = a_time;
+    }
+
+    void equip_latency::clear_input_time() {
+        if (!this->data_) {
+            return;
+        }
+        std::scoped_lock lock(this->data_->lock);
+        this->data_->input_time.reset();
+    }
+
+    std::optional<equip_latency::clock::time_point> equip_latency::get_input_time() const {
+        if (!this->data_) {
+            return std::nullopt;
+        }
+        std::scoped_lock lock(this->data_->lock);
+        return this->data_->input_time;
+    }
+
+    void equip_latency::on_executed(const action_queue::queued_action& a_action, const clock::time_point a_input) {
+        const auto group = get_group(a_action);
+        if (!this->data_ || group == action_group::total) {
+            return;
+        }
+        equip_latency_data* data = this->data_;
+        const auto now = clock::now();
+
+        std::scoped_lock lock(data->lock);
+        auto& task = data->histograms[static_cast<size_t>(group)][static_cast<size_t>(stage::task)];
+        task.record(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - a_input).count()));
+
+        std::erase_if(data->pending, [data, now](const pending_equip& a_pending) {
+            if (now - a_pending.input < pending_timeout) {
+                return false;
+            }
+            ++data->no_event[static_cast<size_t>(a_pending.group)];
+            return true;
+        });
+        if (a_action.form && group != action_group::un_equip) {
+            //a second press for the same form before the event came, the event belongs to the newer one
+            std::erase_if(data->pending,
+                [&a_action](const pending_equip& a_pending) { return a_pending.form == a_action.form->GetFormID(); });
+            data->pending.push_back({ a_action.form->GetFormID(), group, a_input });
+        }
+
+        uint64_t executed = 0;
+        for (const auto& histograms : data->histograms) {
+            executed += histograms[static_cast<size_t>(stage::task)].get_count();
+        }
+        if (executed % report_interval == 0) {
+            for (const auto& line : get_report(data)) {
+                logger::info("equip latency {}"sv, line);
+            }
+        }
+    }
+
+    void equip_latency::on_equip_event(const RE::FormID a_form, const bool a_equipped) {
+        if (!this->data_ || !a_equipped) {
+            return;
+        }
+        equip_latency_data* data = this->data_;
+        const auto now = clock::now();
+
+        std::scoped_lock lock(data->lock);
+        const auto it = std::ranges::find_if(data->pending,
+            [a_form](const pending_equip& a_pending) { return a_pending.form == a_form; });
+        if (it == data->pending.end()) {
+            return;
+        }
+        auto& event = data->histograms[static_cast<size_t>(it->group)][static_cast<size_t>(stage::equip_event)];
+        event.record(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - it->input).count()));
+        data->pending.erase(it);
+    }
+
+    void equip_latency::log_report() const {
+        if (!this->data_) {
+            return;
+        }
+        std::scoped_lock lock(this->data_->lock);
+        for (const auto& line : get_report(this->data_)) {
+            logger::info("equip latency {}"sv, line);
+        }
+    }
+
+    std::vector<std::string> equip_latency::get_report() const {
+        if (!this->data_) {
+            return {};
+        }
+        std::scoped_lock lock(this->data_->lock);
+        return get_report(this->data_);
+    }
+
+    equip_latency::action_group equip_latency::get_group(const action_queue::queued_action& a_action) {
+        using slot_type = action_queue::slot_type;
+        switch (a_action.kind) {
+            case action_queue::action_kind::un_equip_hand:
+            case action_queue::action_kind::un_equip_voice:
+                return action_group::un_equip;
+            case action_queue::action_kind::ammo:
+                return action_group::ammo;
+            case action_queue::action_kind::execute:
+                break;
+        }
+
+        switch (a_action.type) {
+            case slot_type::weapon:
+            case slot_type::shield:
+            case slot_type::light:
+                return action_group::weapon;
+            case slot_type::magic:
+            case slot_type::scroll:
+                return action_group::magic;
+            case slot_type::shout:
+            case slot_type::power:
+                return action_group::voice;
+            case slot_type::armor:
+            case slot_type::lantern:
+            case slot_type::mask:
+                return action_group::armor;
+            case slot_type::consumable:
+                return action_group::consumable;
+            case slot_type::empty:
+                return action_group::un_equip;
+            case slot_type::misc:
+                break;
+        }
+        return action_group::total;
+    }
+
+    std::vector<std::string> equip_latency::get_report(const equip_latency_data* a_data) {
+        const auto ms = [](const uint64_t a_micro) { return static_cast<double>(a_micro) / 1000.0; };
+        std::vector<std::string> lines;
+        for (size_t i = 0; i < a_data->histograms.size(); ++i) {
+            const auto& task = a_data->histograms[i][static_cast<size_t>(stage::task)];
+            if (task.get_count() == 0) {
+                continue;
+            }
+            const auto& event = a_data->histograms[i][static_cast<size_t>(stage::equip_event)];
+            lines.push_back(fmt::format(
+                "{}: task {} p50 {:.1f}ms p90 {:.1f}ms p99 {:.1f}ms max {:.1f}ms, "
+                "event {} p50 {:.1f}ms p90 {:.1f}ms p99 {:.1f}ms max {:.1f}ms, {} without event"sv,
+                group_names[i],
+                task.get_count(),
+                ms(task.get_percentile(0.5)),
+                ms(task.get_percentile(0.9)),
+                ms(task.get_percentile(0.99)),
+                ms(task.get_max()),
+                event.get_count(),
+                ms(event.get_percentile(0.5)),
+                ms(event.get_percentile(0.9)),
+                ms(event.get_percentile(0.99)),
+                ms(event.get_max()),
+                a_data->no_event[i]));
+        }
+        return lines;
+    }
+}
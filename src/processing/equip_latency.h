@@ -0,0 +1,76 @@
+#pragma once
+#include "action_queue.h"
+#include "core/latency_histogram.h"
+
+namespace processing {
+    //how long it takes from a key going down until the queued task ran the action, and until the game reported the
+    //equip back, per kind of action. the key manager sets the time of the input it handles, whatever gets queued
+    //meanwhile belongs to that press
+    class equip_latency {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        enum class action_group : std::uint32_t {
+            weapon = 0,
+            magic = 1,
+            voice = 2,
+            armor = 3,
+            consumable = 4,
+            ammo = 5,
+            un_equip = 6,
+            total = 7
+        };
+
+        //task is input until the action ran, equip_event input until the game reported it
+        enum class stage : std::uint32_t { task = 0, equip_event = 1, total = 2 };
+
+        static equip_latency* get_singleton();
+
+        void set_input_time(clock::time_point a_time);
+        void clear_input_time();
+        //unset outside of handling an input, like for the equips after a load
+        [[nodiscard]] std::optional<clock::time_point> get_input_time() const;
+
+        //after the task ran it, an action with a form then waits for its equip event
+        void on_executed(const action_queue::queued_action& a_action, clock::time_point a_input);
+        void on_equip_event(RE::FormID a_form, bool a_equipped);
+
+        void log_report() const;
+        //one line per group that has samples, for the mcm debug page
+        [[nodiscard]] std::vector<std::string> get_report() const;
+
+        equip_latency(const equip_latency&) = delete;
+        equip_latency(equip_latency&&) = delete;
+
+        equip_latency& operator=(const equip_latency&) const = delete;
+        equip_latency& operator=(equip_latency&&) const = delete;
+
+    private:
+        equip_latency() : data_(nullptr) {}
+        ~equip_latency() = default;
+
+        struct pending_equip {
+            RE::FormID form = 0;
+            action_group group = action_group::total;
+            clock::time_point input;
+        };
+
+        static action_group get_group(const action_queue::queued_action& a_action);
+
+        struct equip_latency_data {
+            std::mutex lock;
+            std::optional<clock::time_point> input_time;
+            std::array<std::array<core::latency_histogram, static_cast<size_t>(stage::total)>,
+                static_cast<size_t>(action_group::total)>
+                histograms;
+            std::vector<pending_equip> pending;
+            //actions with a form that never got an equip event back, like casts
+            std::array<uint64_t, static_cast<size_t>(action_group::total)> no_event{};
+        };
+
+        //expects the lock to be held
+        static std::vector<std::string> get_report(const equip_latency_data* a_data);
+
+        equip_latency_data* data_;
+    };
+}
@@ -21,7 +21,7 @@ namespace processing {
             static_cast<uint32_t>(a_overwrite)));
         const auto pos_max = handle::page_handle::get_singleton()->get_highest_page_id_position(a_position);
         auto max = config::mcm_setting::get_max_page_count() - 1;  //we start at 0 so count -1
-        logger::trace("Max for Position {} is {}, already set before edit {}"sv,
+        LOG_TRACE("Max for Position {} is {}, already set before edit {}"sv,
             static_cast<uint32_t>(a_position),
             max,
             pos_max);
@@ -31,7 +31,7 @@ namespace processing {
 
         if (!a_overwrite && (data.size() == max || max == 0)) {
             write_notification(fmt::format("Can not add more Items to Position", max));
-            logger::trace("Max is 0, can not add anymore, return.");
+            LOG_TRACE("Max is 0, can not add anymore, return.");
             return;
         }
 
@@ -43,7 +43,7 @@ namespace processing {
                 auto log_string =
                     fmt::format("Item {} already used in that position", a_form ? a_form->GetName() : "null");
                 write_notification(log_string);
-                logger::trace("{}. return."sv, log_string);  //well
+                LOG_TRACE("{}. return."sv, log_string);  //well
                 return;
             } else {
                 write_notification(fmt::format("Added Item {}", a_form ? a_form->GetName() : "null"));
@@ -56,7 +56,7 @@ namespace processing {
             }
         }
 
-        logger::trace("Size is {}. calling to set data now, overwrite is {}."sv,
+        LOG_TRACE("Size is {}. calling to set data now, overwrite is {}."sv,
             data.size(),
             static_cast<uint32_t>(a_overwrite));
 
@@ -68,7 +68,7 @@ namespace processing {
             processing::set_setting_data::set_queue_slot(a_position, data);
         }
 
-        logger::trace("Setting done. return.");
+        LOG_TRACE("Setting done. return.");
     }
     void game_menu_setting::default_config(RE::TESForm*& a_form, position_type a_position_type, bool a_left) {
         if (!a_form) {
@@ -83,7 +83,7 @@ namespace processing {
                 two_handed,
                 a_left);
             write_notification(log_string);
-            logger::trace("{}. return."sv, log_string);  //well
+            LOG_TRACE("{}. return."sv, log_string);  //well
             return;
         }
 
@@ -161,11 +161,11 @@ namespace processing {
                     current_left = slot_settings.at(1)->form;
                 }
 
-                logger::trace("got form {}, name {} on both/right hand"sv,
+                LOG_TRACE("got form {}, name {} on both/right hand"sv,
                     current_right ? util::string_util::int_to_hex(current_right->GetFormID()) : "null",
                     current_right ? current_right->GetName() : "null");
 
-                logger::trace("got form {}, name {} on left hand"sv,
+                LOG_TRACE("got form {}, name {} on left hand"sv,
                     current_left ? util::string_util::int_to_hex(current_left->GetFormID()) : "null",
                     current_left ? current_left->GetName() : "null");
 
@@ -223,9 +223,9 @@ namespace processing {
             new_data = data;
         }
 
-        logger::trace("Size is {}. calling to set data now."sv, new_data.size());
+        LOG_TRACE("Size is {}. calling to set data now."sv, new_data.size());
         for (const auto* data_item : new_data) {
-            logger::trace("Name {}, Type {}, Action {}, Left {}",
+            LOG_TRACE("Name {}, Type {}, Action {}, Left {}",
                 data_item->form ? data_item->form->GetName() : "null",
                 static_cast<uint32_t>(data_item->type),
                 static_cast<uint32_t>(data_item->action_type),
@@ -246,7 +246,7 @@ namespace processing {
                     "_root.Menu_mc.inventoryLists.itemList.selectedEntry.formId");
                 if (result.GetType() == RE::GFxValue::ValueType::kNumber) {
                     menu_form = static_cast<std::uint32_t>(result.GetNumber());
-                    logger::trace("formid {}"sv, util::string_util::int_to_hex(menu_form));
+                    LOG_TRACE("formid {}"sv, util::string_util::int_to_hex(menu_form));
                 }
             }
         }
@@ -258,7 +258,7 @@ namespace processing {
                 magic_menu->uiMovie->GetVariable(&result, "_root.Menu_mc.inventoryLists.itemList.selectedEntry.formId");
                 if (result.GetType() == RE::GFxValue::ValueType::kNumber) {
                     menu_form = static_cast<std::uint32_t>(result.GetNumber());
-                    logger::trace("formid {}"sv, util::string_util::int_to_hex(menu_form));
+                    LOG_TRACE("formid {}"sv, util::string_util::int_to_hex(menu_form));
                 }
             }
         }
@@ -270,7 +270,7 @@ namespace processing {
                 favorite_menu->uiMovie->GetVariable(&result, "_root.MenuHolder.Menu_mc.itemList.selectedEntry.formId");
                 if (result.GetType() == RE::GFxValue::ValueType::kNumber) {
                     menu_form = static_cast<std::uint32_t>(result.GetNumber());
-                    logger::trace("formid {}"sv, util::string_util::int_to_hex(menu_form));
+                    LOG_TRACE("formid {}"sv, util::string_util::int_to_hex(menu_form));
                 }
             }
         }
@@ -289,7 +289,7 @@ namespace processing {
         const auto item = new data_helper();
         const auto type = util::helper::get_type(a_form);
         const auto two_handed = util::helper::is_two_handed(a_form);
-        logger::trace("Item {}, is Type {}, TwoHanded {}"sv,
+        LOG_TRACE("Item {}, is Type {}, TwoHanded {}"sv,
             a_form ? util::string_util::int_to_hex(a_form->formID) : "null",
             static_cast<uint32_t>(type),
             two_handed);
@@ -406,18 +406,16 @@ namespace processing {
 
         auto pages = page_handle->get_pages();
         if (!pages.empty()) {
-            for (auto& [page, page_settings] : pages) {
-                for (auto [position, page_setting] : page_settings) {
-                    if (position == a_position) {
-                        for (const auto* setting : page_setting->slot_settings) {
-                            if (setting &&
-                                ((setting->form && setting->form->formID == a_form->formID) ||
-                                    (setting->actor_value == actor_value && actor_value != RE::ActorValue::kNone))) {
-                                count++;
-                                if (max_count == count) {
-                                    logger::trace("Item already {} time(s) used. return."sv, count);
-                                    return true;
-                                }
+            for (auto& [key, page_setting] : pages) {
+                if (util::get_position_from_key(key) == static_cast<uint32_t>(a_position)) {
+                    for (const auto* setting : page_setting->slot_settings) {
+                        if (setting &&
+                            ((setting->form && setting->form->formID == a_form->formID) ||
+                                (setting->actor_value == actor_value && actor_value != RE::ActorValue::kNone))) {
+                            count++;
+                            if (max_count == count) {
+                                LOG_TRACE("Item already {} time(s) used. return."sv, count);
+                                return true;
                             }
                         }
                     }
@@ -431,7 +429,7 @@ namespace processing {
                     (data_item->actor_value == actor_value && actor_value != RE::ActorValue::kNone)) {
                     count++;
                     if (max_count == count) {
-                        logger::trace("Item already {} time(s) used. return."sv, count);
+                        LOG_TRACE("Item already {} time(s) used. return."sv, count);
                         return true;
                     }
                 }
@@ -2,38 +2,113 @@
 #include "equip/equip_slot.h"
 #include "equip/item.h"
 #include "handle/ammo_handle.h"
+#include "handle/ammo_index.h"
+#include "handle/item_count_handle.h"
 #include "handle/name_handle.h"
 #include "handle/page_handle.h"
 #include "setting/custom_setting.h"
 #include "setting/mcm_setting.h"
 #include "setting_execute.h"
+#include "ui/hud_model.h"
 #include "util/constant.h"
 #include "util/helper.h"
 #include "util/player/player.h"
 #include "util/string_util.h"
+#include "util/trace_recorder.h"
 
 namespace processing {
     using mcm = config::mcm_setting;
     using custom = config::custom_setting;
 
-    void set_setting_data::read_and_set_data() {
-        logger::trace("Setting handlers, elden demon souls {} ..."sv, mcm::get_elden_demon_souls());
+    void set_setting_data::read_and_set_data(const bool a_custom_loaded) {
+        LOG_TRACE("Setting handlers, elden demon souls {} ..."sv, mcm::get_elden_demon_souls());
 
         handle::key_position_handle::get_singleton()->init_key_position_map();
 
-        handle::name_handle::get_singleton()->init_names(util::player::get_hand_assignment());
+        handle::name_handle::get_singleton()->set_item_names_dirty();
+        handle::name_handle::get_singleton()->set_voice_name_dirty();
 
         write_empty_config_and_init_active();
 
-        logger::trace("continue with overwriting data from configuration ..."sv);
+        LOG_TRACE("continue with overwriting data from configuration ..."sv);
 
-        process_config_data();
+        process_config_data(a_custom_loaded);
 
-        logger::trace("done executing. return."sv);
+        LOG_TRACE("done executing. return."sv);
+    }
+
+    void set_setting_data::restore_data(const std::vector<handle::page_snapshot>& a_pages,
+        const uint32_t a_active_page,
+        const std::map<position_type, uint32_t>& a_active_page_per_position,
+        const std::vector<handle::ammo_snapshot>& a_ammo,
+        const RE::FormID a_current_ammo) {
+        LOG_TRACE("Restoring {} pages from save, elden demon souls {} ..."sv,
+            a_pages.size(),
+            mcm::get_elden_demon_souls());
+
+        auto* key_position = handle::key_position_handle::get_singleton();
+        key_position->init_key_position_map();
+
+        handle::name_handle::get_singleton()->set_item_names_dirty();
+        handle::name_handle::get_singleton()->set_voice_name_dirty();
+
+        write_empty_config_and_init_active();
+
+        auto* page_handle = handle::page_handle::get_singleton();
+        if (mcm::get_elden_demon_souls()) {
+            for (auto i = 0; i < static_cast<int>(position_type::total); ++i) {
+                page_handle->set_highest_page_position(-1, static_cast<position_type>(i));
+            }
+        }
+
+        for (const auto& page : a_pages) {
+            page_handle->restore_page(page, key_position);
+        }
+
+        if (mcm::get_elden_demon_souls()) {
+            for (const auto& [position, page] : a_active_page_per_position) {
+                page_handle->init_actives(page, position);
+            }
+        } else {
+            page_handle->set_active_page(a_active_page);
+        }
+
+        if (!a_ammo.empty()) {
+            //take the data of the index, it keeps the counts up to date
+            auto* ammo_index = handle::ammo_index::get_singleton();
+            std::vector<handle::ammo_data*> ammo;
+            auto current = -1;
+            for (const auto& restored : a_ammo) {
+                if (auto* indexed = ammo_index->get_ammo_data(RE::TESForm::LookupByID(restored.form_id))) {
+                    //ammo that is gone shifts the list, so the selection goes by form
+                    if (restored.form_id == a_current_ammo) {
+                        current = static_cast<int>(ammo.size());
+                    }
+                    ammo.push_back(indexed);
+                }
+            }
+            auto* ammo_handle = handle::ammo_handle::get_singleton();
+            ammo_handle->init_ammo(ammo);
+            ammo_handle->set_current(current);
+        }
+        ui::hud_model::get_singleton()->publish();
+
+        LOG_TRACE("done restoring. return."sv);
     }
 
     void set_setting_data::set_new_item_count_if_needed(RE::TESBoundObject* a_object, int32_t a_count) {
-        set_new_item_count(a_object, a_count);
+        if (const auto* recorder = util::trace_recorder::get_singleton();
+            recorder->is_active() && a_object && handle::item_count_handle::is_tracked(a_object)) {
+            recorder->record_inventory(handle::item_count_handle::get_record(a_object, a_count));
+        }
+        handle::item_count_handle::get_singleton()->apply_delta(a_object, a_count);
+        //the ammo handle points into the index, so the counts it shows follow as well
+        handle::ammo_index::get_singleton()->apply_delta(a_object, a_count);
+        //most inventory changes are neither in a slot nor the current ammo, no need to build a snapshot for those
+        const auto* current_ammo = handle::ammo_handle::get_singleton()->get_current();
+        if (set_new_item_count(a_object, a_count) || (current_ammo && current_ammo->form == a_object)) {
+            ui::hud_model::get_singleton()->publish();
+        }
     }
 
     void set_setting_data::set_single_slot(const uint32_t a_page,
@@ -54,7 +129,7 @@ namespace processing {
                                                           handle::slot_setting::hand_equip::single;
             }
         }
-        logger::trace("calling init page for page {}, position {} ..."sv, a_page, static_cast<uint32_t>(a_position));
+        LOG_TRACE("calling init page for page {}, position {} ..."sv, a_page, static_cast<uint32_t>(a_position));
 
         std::vector<data_helper*> data;
         if (a_data.empty()) {
@@ -73,16 +148,17 @@ namespace processing {
             hand_equip,
             key_pos);
 
-        logger::debug("calling helper to write to file"sv);
+        LOG_DEBUG("calling helper to write to file"sv);
         util::helper::write_setting_to_file(a_page,
             static_cast<uint32_t>(a_position),
             a_data,
             static_cast<uint32_t>(hand_equip));
+        ui::hud_model::get_singleton()->publish();
     }
 
     void set_setting_data::set_queue_slot(position_type a_pos, const std::vector<data_helper*>& a_data) {
         //each data item will be a new page with this position
-        logger::trace("Got {} items to process"sv, a_data.size());
+        LOG_TRACE("Got {} items to process"sv, a_data.size());
         if (a_data.empty()) {
             return;
         }
@@ -95,34 +171,19 @@ namespace processing {
         for (auto* item : a_data) {
             auto hand =
                 item->two_handed ? handle::slot_setting::hand_equip::both : handle::slot_setting::hand_equip::single;
-            logger::trace("working page {}, pos {}"sv, page, pos);
+            LOG_TRACE("working page {}, pos {}"sv, page, pos);
             //for now make a vector with one item...
             std::vector<data_helper*> data;
             data.push_back(item);
             page_handle->init_page(page, a_pos, data, hand, key_pos);
 
-            logger::debug("calling helper to write to file, page {}, pos {}"sv, page, pos);
+            LOG_DEBUG("calling helper to write to file, page {}, pos {}"sv, page, pos);
             util::helper::write_setting_to_file(page, pos, data, static_cast<uint32_t>(hand));
 
             ++page;
         }
-        logger::trace("done with data items"sv);
-    }
-
-    void set_setting_data::set_empty_slot(const int a_page, int a_pos, handle::key_position_handle*& a_key_pos) {
-        logger::trace("setting empty config for page {}, position {}"sv, a_page, a_pos);
-        std::vector<data_helper*> data;
-        const auto item = new data_helper();
-        item->form = nullptr;
-        item->action_type = handle::slot_setting::action_type::default_action;
-        item->type = slot_type::empty;
-        data.push_back(item);
-
-        handle::page_handle::get_singleton()->init_page(a_page,
-            static_cast<position_type>(a_pos),
-            data,
-            handle::slot_setting::hand_equip::total,
-            a_key_pos);
+        ui::hud_model::get_singleton()->publish();
+        LOG_TRACE("done with data items"sv);
     }
 
     void set_setting_data::set_slot(const uint32_t a_page,
@@ -135,18 +196,18 @@ namespace processing {
         uint32_t a_type_left,
         const uint32_t a_action_left,
         RE::ActorValue a_actor_value,
-        handle::key_position_handle*& a_key_pos,
-        const std::string& a_section) {
+        handle::key_position_handle*& a_key_pos) {
         auto* form = util::helper::get_form_from_mod_id_string(a_form);
         auto* form_left = util::helper::get_form_from_mod_id_string(a_form_left);
 
         if (form == nullptr && form_left == nullptr && a_actor_value == RE::ActorValue::kNone) {
             //reset section here if allowed
             logger::info(
-                "section {}, form and form left are null as well as the actor value is non. resetting if allowed."sv,
-                a_section);
+                "page {}, position {}, form and form left are null as well as the actor value is non. resetting if allowed."sv,
+                a_page,
+                static_cast<uint32_t>(a_position));
             if (mcm::get_auto_cleanup()) {
-                custom::reset_section(a_section);
+                custom::reset_section(util::make_page_key(a_page, static_cast<uint32_t>(a_position)));
             }
             return;
         }
@@ -155,7 +216,7 @@ namespace processing {
         std::vector<data_helper*> data;
 
         auto action_check = config::mcm_setting::get_action_check();
-        logger::trace("page {}, pos {}, start working data hands {}, action_check {} ..."sv,
+        LOG_TRACE("page {}, pos {}, start working data hands {}, action_check {} ..."sv,
             a_page,
             static_cast<uint32_t>(a_position),
             a_hand,
@@ -187,7 +248,7 @@ namespace processing {
             logger::warn("Equipping shield on the Right hand might fail, or hand will be empty"sv);
         }
 
-        logger::trace("start building data pos {}, form {}, type {}, action {}, hand {}"sv,
+        LOG_TRACE("start building data pos {}, form {}, type {}, action {}, hand {}"sv,
             static_cast<uint32_t>(a_position),
             form ? util::string_util::int_to_hex(form->GetFormID()) : "null",
             static_cast<int>(type),
@@ -215,12 +276,12 @@ namespace processing {
         item->actor_value = a_actor_value;
         data.push_back(item);
 
-        logger::trace("checking if we need to build a second data set, already got {}"sv, data.size());
+        LOG_TRACE("checking if we need to build a second data set, already got {}"sv, data.size());
 
         if (hand == handle::slot_setting::hand_equip::single) {
             const auto type_left = static_cast<slot_type>(a_type_left);
             action = static_cast<handle::slot_setting::action_type>(a_action_left);
-            logger::trace("start building second set data pos {}, form {}, type {}, action {}, hand {}"sv,
+            LOG_TRACE("start building second set data pos {}, form {}, type {}, action {}, hand {}"sv,
                 static_cast<uint32_t>(a_position),
                 form_left ? util::string_util::int_to_hex(form_left->GetFormID()) : "null",
                 static_cast<int>(type_left),
@@ -248,51 +309,46 @@ namespace processing {
             data.push_back(item_left);
         }
 
-        logger::trace("build data, calling handler, data size {}"sv, data.size());
+        LOG_TRACE("build data, calling handler, data size {}"sv, data.size());
 
         if (!data.empty()) {
             handle::page_handle::get_singleton()->init_page(a_page, a_position, data, hand, a_key_pos);
         }
     }
 
-    void set_setting_data::set_new_item_count(RE::TESBoundObject* a_object, int32_t a_count) {
+    bool set_setting_data::set_new_item_count(RE::TESBoundObject* a_object, int32_t a_count) {
         //just consider magic items for now, that includes
+        auto changed = false;
+        auto need_reprocess = false;
         auto* page_handle = handle::page_handle::get_singleton();
-        for (auto pages = page_handle->get_pages(); auto& [page, page_settings] : pages) {
-            for (auto [position, page_setting] : page_settings) {
-                for (auto* setting : page_setting->slot_settings) {
-                    if ((setting->form && setting->form->formID == a_object->formID) ||
-                        (setting->actor_value != RE::ActorValue::kNone &&
-                            util::helper::get_actor_value_effect_from_potion(a_object) != RE::ActorValue::kNone)) {
-                        setting->item_count = setting->item_count + a_count;
-                        logger::trace("FormId {}, new count {}, change count {}"sv,
-                            util::string_util::int_to_hex(a_object->formID),
-                            setting->item_count,
-                            a_count);
-                        block_location(page_setting, setting->item_count == 0);
-                        if (setting->item_count == 0 && clean_type_allowed(setting->type)) {
-                            do_cleanup(page_setting, setting);
-                            if (mcm::get_elden_demon_souls()) {
-                                util::helper::rewrite_settings();
-                            }
-                            process_config_data();
-                        }
+        for (auto pages = page_handle->get_pages(); auto& [key, page_setting] : pages) {
+            for (auto* setting : page_setting->slot_settings) {
+                if ((setting->form && setting->form->formID == a_object->formID) ||
+                    (setting->actor_value != RE::ActorValue::kNone &&
+                        util::helper::get_actor_value_effect_from_potion(a_object) != RE::ActorValue::kNone)) {
+                    setting->item_count = setting->item_count + a_count;
+                    changed = true;
+                    LOG_TRACE("FormId {}, new count {}, change count {}"sv,
+                        util::string_util::int_to_hex(a_object->formID),
+                        setting->item_count,
+                        a_count);
+                    block_location(page_setting, setting->item_count == 0);
+                    if (setting->item_count == 0 && clean_type_allowed(setting->type)) {
+                        need_reprocess = true;
+                        do_cleanup(page_setting, setting);
                     }
                 }
             }
         }
 
-        if (mcm::get_elden_demon_souls()) {
-            //check if we have ammo to update
-            const auto* ammo_handle = handle::ammo_handle::get_singleton();
-            if (const auto ammo_list = ammo_handle->get_all(); !ammo_list.empty()) {
-                for (auto* ammo : ammo_list) {
-                    if (a_object->formID == ammo->form->formID) {
-                        ammo->item_count = ammo->item_count + a_count;
-                    }
-                }
+        //processing the config frees the pages, so it has to wait until the loop is done
+        if (need_reprocess) {
+            if (mcm::get_elden_demon_souls()) {
+                util::helper::rewrite_settings();
             }
+            process_config_data();
         }
+        return changed;
     }
 
 
@@ -305,11 +361,13 @@ namespace processing {
         }
 
         get_actives_and_equip();
-        logger::trace("processed actives and equip"sv);
+        LOG_TRACE("processed actives and equip"sv);
     }
 
-    void set_setting_data::process_config_data() {
-        custom::read_setting();
+    void set_setting_data::process_config_data(const bool a_custom_loaded) {
+        if (!a_custom_loaded) {
+            custom::read_setting();
+        }
         auto* key_position = handle::key_position_handle::get_singleton();
         auto* handler = handle::page_handle::get_singleton();
 
@@ -331,15 +389,15 @@ namespace processing {
                 custom::get_type_left_by_section(section),
                 custom::get_slot_action_left_by_section(section),
                 static_cast<RE::ActorValue>(custom::get_effect_actor_value(section)),
-                key_position,
-                section);
+                key_position);
         }
 
         //do not trigger reequip if config a config is set
         if (mcm::get_elden_demon_souls()) {
             set_active_and_equip(handler);
         }
-        logger::trace("processed config data"sv);
+        ui::hud_model::get_singleton()->publish();
+        LOG_TRACE("processed config data"sv);
     }
     void set_setting_data::write_empty_config_and_init_active() {
         //we start at 0, so it is max count -1
@@ -352,14 +410,9 @@ namespace processing {
         }
 
         auto* key_position = handle::key_position_handle::get_singleton();
-        //set empty for each position, it will be overwritten if it is configured
-        const auto max = static_cast<int>(config::mcm_setting::get_max_page_count());
-        for (auto i = 0; i < max; ++i) {
-            for (auto j = 0; j < static_cast<int>(position_type::total); ++j) {
-                set_empty_slot(i, j, key_position);
-            }
-        }
-        logger::trace("processed empty data"sv);
+        //pages that are not configured share one empty page per position, they get their own when cycled to
+        handle::page_handle::get_singleton()->init_empty_pages(key_position);
+        LOG_TRACE("processed empty data"sv);
     }
     void set_setting_data::get_actives_and_equip() {
         if (!mcm::get_elden_demon_souls() || mcm::get_disable_re_equip_of_actives()) {
@@ -368,7 +421,7 @@ namespace processing {
 
         clear_hands();
 
-        logger::trace("execute first setting for left/right/top"sv);
+        LOG_TRACE("execute first setting for left/right/top"sv);
 
         auto* page_handle = handle::page_handle::get_singleton();
         auto is_right_two_handed = false;
@@ -395,11 +448,11 @@ namespace processing {
             position_type::top);
         setting_execute::activate(position_setting->slot_settings, true);
 
-        logger::trace("done equip for first set"sv);
+        LOG_TRACE("done equip for first set"sv);
     }
 
     void set_setting_data::clear_hands() {
-        logger::trace("clear hands"sv);
+        LOG_TRACE("clear hands"sv);
         auto* player = RE::PlayerCharacter::GetSingleton();
         auto* equip_manager = RE::ActorEquipManager::GetSingleton();
         auto* right = equip::equip_slot::get_right_hand_slot();
@@ -408,11 +461,11 @@ namespace processing {
         //execute first setting for left, then right
         equip::equip_slot::un_equip_object_ft_dummy_dagger(right, player, equip_manager);
         equip::equip_slot::un_equip_object_ft_dummy_dagger(left, player, equip_manager);
-        logger::trace("clear hands done."sv);
+        LOG_TRACE("clear hands done."sv);
     }
 
     void set_setting_data::check_if_location_needs_block(RE::TESForm*& a_form, const bool a_equipped) {
-        logger::trace("checking if location needs block, form {}, equipped {}"sv,
+        LOG_TRACE("checking if location needs block, form {}, equipped {}"sv,
             a_form ? util::string_util::int_to_hex(a_form->formID) : "null",
             a_equipped);
         //is two-handed, if equipped
@@ -457,7 +510,8 @@ namespace processing {
                 processing::setting_execute::reequip_left_hand_if_needed(setting);
             }
         }
-        logger::trace("checking for block done. return."sv);
+        ui::hud_model::get_singleton()->publish();
+        LOG_TRACE("checking for block done. return."sv);
     }
 
     void set_setting_data::block_location(handle::position_setting* a_position_setting, bool a_condition) {
@@ -473,68 +527,11 @@ namespace processing {
     }
 
     void set_setting_data::look_for_ammo(const bool a_crossbow) {
-        bool only_favorite = config::mcm_setting::get_only_favorite_ammo();
-        bool sort_by_quantity = config::mcm_setting::get_sort_arrow_by_quantity();
-        const auto max_items = config::mcm_setting::get_max_ammunition_type();
-        auto* player = RE::PlayerCharacter::GetSingleton();
-        const auto inv = util::player::get_inventory(player, RE::FormType::Ammo);
-        std::multimap<uint32_t, handle::ammo_data*, std::greater<>> ammo_list;
-        for (const auto& [item, inv_data] : inv) {
-            const auto& [num_items, entry] = inv_data;
-            auto* ammo = item->As<RE::TESAmmo>();
-
-            if (!ammo->GetPlayable() || ammo->GetRuntimeData().data.flags.any(RE::AMMO_DATA::Flag::kNonPlayable)) {
-                continue;
-            }
-
-            if (ammo->formID == util::bound_arrow) {
-                continue;
-            }
-
-            if (only_favorite && !entry->IsFavorited()) {
-                continue;
-            }
-
-            if (a_crossbow && ammo->GetRuntimeData().data.flags.none(RE::AMMO_DATA::Flag::kNonBolt) && num_items != 0) {
-                logger::trace("found bolt {}, damage {}, count {}"sv,
-                    ammo->GetName(),
-                    ammo->GetRuntimeData().data.damage,
-                    num_items);
-                auto* ammo_data = new handle::ammo_data();
-                ammo_data->form = ammo;
-                ammo_data->item_count = num_items;
-                if (sort_by_quantity) {
-                    ammo_list.insert({ static_cast<uint32_t>(num_items), ammo_data });
-                } else {
-                    ammo_list.insert({ static_cast<uint32_t>(ammo->GetRuntimeData().data.damage), ammo_data });
-                }
-            } else if (!a_crossbow && num_items != 0 &&
-                       ammo->GetRuntimeData().data.flags.all(RE::AMMO_DATA::Flag::kNonBolt)) {
-                logger::trace("found arrow {}, damage {}, count {}"sv,
-                    ammo->GetName(),
-                    ammo->GetRuntimeData().data.damage,
-                    num_items);
-                auto* ammo_data = new handle::ammo_data();
-                ammo_data->form = ammo;
-                ammo_data->item_count = num_items;
-                if (sort_by_quantity) {
-                    ammo_list.insert({ static_cast<uint32_t>(num_items), ammo_data });
-                } else {
-                    ammo_list.insert({ static_cast<uint32_t>(ammo->GetRuntimeData().data.damage), ammo_data });
-                }
-            }
-        }
-        std::vector<handle::ammo_data*> sorted_ammo;
-        auto* ammo_handle = handle::ammo_handle::get_singleton();
-        for (auto [dmg, data] : ammo_list) {
-            sorted_ammo.push_back(data);
-            logger::trace("got {} count {}"sv, data->form->GetName(), data->item_count);
-            if (sorted_ammo.size() == max_items) {
-                break;
-            }
-        }
-        ammo_list.clear();
-        ammo_handle->init_ammo(sorted_ammo);
+        const auto& sorted_ammo = handle::ammo_index::get_singleton()->get_sorted(a_crossbow,
+            config::mcm_setting::get_sort_arrow_by_quantity(),
+            config::mcm_setting::get_only_favorite_ammo(),
+            config::mcm_setting::get_max_ammunition_type());
+        handle::ammo_handle::get_singleton()->init_ammo(sorted_ammo);
     }
 
     void set_setting_data::do_cleanup(handle::position_setting*& a_position_setting,
@@ -544,12 +541,11 @@ namespace processing {
             static_cast<uint32_t>(a_position_setting->position),
             a_slot_setting->form ? util::string_util::int_to_hex(a_slot_setting->form->formID) : "null");
         RE::DebugNotification(log_string.c_str());
-        logger::trace("{}"sv, log_string);
+        LOG_TRACE("{}"sv, log_string);
 
         if (mcm::get_elden_demon_souls()) {
             config::custom_setting::reset_section(
-                util::helper::get_section_name_for_page_position(a_position_setting->page,
-                    static_cast<uint32_t>(a_position_setting->position)));
+                util::make_page_key(a_position_setting->page, static_cast<uint32_t>(a_position_setting->position)));
         } else {
             a_slot_setting->form = nullptr;
             a_slot_setting->type = slot_type::empty;
@@ -581,7 +577,7 @@ namespace processing {
                 static_cast<uint32_t>(hand_equip));
         }
 
-        logger::trace("done with cleaning at page {}, position {}, form {}"sv,
+        LOG_TRACE("done with cleaning at page {}, position {}, form {}"sv,
             a_position_setting->page,
             static_cast<uint32_t>(a_position_setting->position),
             a_slot_setting->form ? util::string_util::int_to_hex(a_slot_setting->form->formID) : "null");
@@ -593,22 +589,20 @@ namespace processing {
         }
         auto* page_handle = handle::page_handle::get_singleton();
         auto need_reprocess = false;
-        for (auto pages = page_handle->get_pages(); auto& [page, page_settings] : pages) {
-            for (auto [position, page_setting] : page_settings) {
-                logger::trace("checking page {}, position {}"sv,
-                    page_setting->page,
-                    static_cast<uint32_t>(page_setting->position));
-                for (auto* setting : page_setting->slot_settings) {
-                    if (setting->form || (!setting->form && setting->actor_value != RE::ActorValue::kNone)) {
-                        if (clean_type_allowed(setting->type)) {
-                            auto has_it = util::player::has_item_or_spell(setting->form);
-                            if ((!setting->form && setting->actor_value != RE::ActorValue::kNone &&
-                                    setting->item_count == 0) ||
-                                !has_it) {
-                                //clean
-                                need_reprocess = true;
-                                do_cleanup(page_setting, setting);
-                            }
+        for (auto pages = page_handle->get_pages(); auto& [key, page_setting] : pages) {
+            LOG_TRACE("checking page {}, position {}"sv,
+                page_setting->page,
+                static_cast<uint32_t>(page_setting->position));
+            for (auto* setting : page_setting->slot_settings) {
+                if (setting->form || (!setting->form && setting->actor_value != RE::ActorValue::kNone)) {
+                    if (clean_type_allowed(setting->type)) {
+                        auto has_it = util::player::has_item_or_spell(setting->form);
+                        if ((!setting->form && setting->actor_value != RE::ActorValue::kNone &&
+                                setting->item_count == 0) ||
+                            !has_it) {
+                            //clean
+                            need_reprocess = true;
+                            do_cleanup(page_setting, setting);
                         }
                     }
                 }
@@ -630,23 +624,26 @@ namespace processing {
         }
 
         auto* page_handle = handle::page_handle::get_singleton();
-        for (auto pages = page_handle->get_pages(); auto& [page, page_settings] : pages) {
-            for (auto [position, page_setting] : page_settings) {
-                for (auto* setting : page_setting->slot_settings) {
-                    if ((setting->form && setting->form->formID == a_form->formID) ||
-                        (setting->actor_value != RE::ActorValue::kNone &&
-                            util::helper::get_actor_value_effect_from_potion(a_form) != RE::ActorValue::kNone)) {
-                        do_cleanup(page_setting, setting);
-                        if (config::mcm_setting::get_elden_demon_souls()) {
-                            util::helper::rewrite_settings();
-                        }
-                        write_empty_config_and_init_active();
-                        process_config_data();
-                        get_actives_and_equip();
-                    }
+        auto need_reprocess = false;
+        for (auto pages = page_handle->get_pages(); auto& [key, page_setting] : pages) {
+            for (auto* setting : page_setting->slot_settings) {
+                if ((setting->form && setting->form->formID == a_form->formID) ||
+                    (setting->actor_value != RE::ActorValue::kNone &&
+                        util::helper::get_actor_value_effect_from_potion(a_form) != RE::ActorValue::kNone)) {
+                    need_reprocess = true;
+                    do_cleanup(page_setting, setting);
                 }
             }
         }
+
+        if (need_reprocess) {
+            if (config::mcm_setting::get_elden_demon_souls()) {
+                util::helper::rewrite_settings();
+            }
+            write_empty_config_and_init_active();
+            process_config_data();
+            get_actives_and_equip();
+        }
     }
 
     bool set_setting_data::clean_type_allowed(slot_type a_type) {
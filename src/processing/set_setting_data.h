@@ -1,5 +1,7 @@
 ﻿#pragma once
+#include "handle/data/ammo_data.h"
 #include "handle/data/data_helper.h"
+#include "handle/data/page/page_snapshot.h"
 #include "handle/data/page/position_setting.h"
 #include "handle/key_position_handle.h"
 #include "handle/page_handle.h"
@@ -10,7 +12,13 @@ namespace processing {
         using position_type = handle::position_setting::position_type;
         using slot_type = handle::slot_setting::slot_type;
 
-        static void read_and_set_data();
+        //the custom config is read from disk unless the caller loaded it already
+        static void read_and_set_data(bool a_custom_loaded = false);
+        static void restore_data(const std::vector<handle::page_snapshot>& a_pages,
+            uint32_t a_active_page,
+            const std::map<position_type, uint32_t>& a_active_page_per_position,
+            const std::vector<handle::ammo_snapshot>& a_ammo,
+            RE::FormID a_current_ammo);
         static void set_new_item_count_if_needed(RE::TESBoundObject* a_object, int32_t a_count);
         static void set_single_slot(uint32_t a_page, position_type a_position, const std::vector<data_helper*>& a_data);
         static void set_queue_slot(position_type a_pos, const std::vector<data_helper*>& a_data);
@@ -20,7 +28,6 @@ namespace processing {
         static void default_remove(RE::TESForm* a_form);
 
     private:
-        static void set_empty_slot(int a_page, int a_pos, handle::key_position_handle*& a_key_pos);
         static void set_slot(uint32_t a_page,
             position_type a_position,
             const std::string& a_form,
@@ -31,11 +38,11 @@ namespace processing {
             uint32_t a_type_left,
             uint32_t a_action_left,
             RE::ActorValue a_actor_value,
-            handle::key_position_handle*& a_key_pos,
-            const std::string& a_section);
-        static void set_new_item_count(RE::TESBoundObject* a_object, int32_t a_count);
+            handle::key_position_handle*& a_key_pos);
+        //true if a slot holds the object, only then the hud shows something new
+        static bool set_new_item_count(RE::TESBoundObject* a_object, int32_t a_count);
         static void set_active_and_equip(handle::page_handle*& a_page_handle);
-        static void process_config_data();
+        static void process_config_data(bool a_custom_loaded = false);
         static void write_empty_config_and_init_active();
         static void clear_hands();
         static void block_location(handle::position_setting* a_position_setting, bool a_condition);
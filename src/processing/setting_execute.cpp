@@ -1,7 +1,6 @@
 ﻿#include "setting_execute.h"
+#include "action_queue.h"
 #include "equip/equip_slot.h"
-#include "equip/item.h"
-#include "equip/magic.h"
 #include "handle/data/page/position_setting.h"
 #include "handle/key_position_handle.h"
 #include "handle/page_handle.h"
@@ -19,17 +18,17 @@ namespace processing {
             logger::info("settings are empty. return.");
             return;
         }
-        logger::trace("got {} settings execute, only_equip {}, only_instant {}"sv,
+        LOG_TRACE("got {} settings execute, only_equip {}, only_instant {}"sv,
             a_slots.size(),
             a_only_equip,
             a_only_instant);
         std::vector<RE::BGSEquipSlot*> un_equip;
-        auto* player = RE::PlayerCharacter::GetSingleton();
+        auto* queue = action_queue::get_singleton();
         for (auto* slot : a_slots) {
             if (!slot->form && slot->type == slot_type::consumable && slot->actor_value != RE::ActorValue::kNone) {
-                logger::debug("form is null, but actor value is set to {}"sv, static_cast<int>(slot->actor_value));
+                LOG_DEBUG("form is null, but actor value is set to {}"sv, static_cast<int>(slot->actor_value));
             } else if (mcm::get_elden_demon_souls() && !slot->form) {
-                logger::debug("form is null and I am in elden mode, skipping."sv);
+                LOG_DEBUG("form is null and I am in elden mode, skipping."sv);
                 continue;
             } else if (!slot->form && slot->type != slot_type::empty) {
                 logger::warn("form is null and not type empty, skipping."sv);
@@ -42,36 +41,43 @@ namespace processing {
             }
 
             if (mcm::get_elden_demon_souls() && a_only_equip && slot->action != action_type::default_action) {
-                logger::trace("form {} does not need equip, skipping"sv,
+                LOG_TRACE("form {} does not need equip, skipping"sv,
                     slot->form ? util::string_util::int_to_hex(slot->form->GetFormID()) : "null");
-                equip::equip_slot::un_equip_shout_slot(player);
+                queue->add({ .kind = action_queue::action_kind::un_equip_voice });
                 continue;
             }
 
             if (mcm::get_elden_demon_souls() && a_only_instant && slot->action != action_type::instant) {
-                logger::trace("form {} does not need any work, skipping"sv,
+                LOG_TRACE("form {} does not need any work, skipping"sv,
                     slot->form ? util::string_util::int_to_hex(slot->form->GetFormID()) : "null");
                 continue;
             }
 
-            logger::trace("executing setting for type {}, action {}, form {}, left {} ..."sv,
+            LOG_TRACE("executing setting for type {}, action {}, form {}, left {} ..."sv,
                 static_cast<uint32_t>(slot->type),
                 static_cast<uint32_t>(slot->action),
                 slot->form ? util::string_util::int_to_hex(slot->form->GetFormID()) : "null",
                 slot->equip_slot == equip::equip_slot::get_left_hand_slot());
-            execute_setting(slot, player);
+            queue->add({ .kind = action_queue::action_kind::execute,
+                .type = slot->type,
+                .form = slot->form,
+                .action = slot->action,
+                .equip_slot = slot->equip_slot,
+                .actor_value = slot->actor_value });
         }
 
-        if (!un_equip.empty()) {
-            for (RE::BGSEquipSlot*& slot : un_equip) {
-                equip::equip_slot::un_equip_hand(slot, player, action_type::un_equip);
-            }
+        for (auto* slot : un_equip) {
+            queue->add({ .kind = action_queue::action_kind::un_equip_hand, .equip_slot = slot });
         }
     }
 
     handle::position_setting* setting_execute::get_position_setting_for_key(const uint32_t a_key) {
-        const auto position = handle::key_position_handle::get_singleton()->get_position_for_key(a_key);
-        if (position == position_type::total) {
+        return get_position_setting_for_position(
+            handle::key_position_handle::get_singleton()->get_position_for_key(a_key));
+    }
+
+    handle::position_setting* setting_execute::get_position_setting_for_position(const position_type a_position) {
+        if (a_position == position_type::total) {
             logger::warn("nothing to do, nothing set. return."sv);
             return nullptr;
         }
@@ -80,18 +86,19 @@ namespace processing {
         handle::position_setting* position_setting;
         uint32_t page;
         if (mcm::get_elden_demon_souls()) {
-            page = page_handle->get_active_page_id_position(position);
-            position_setting = page_handle->get_page_setting(page, position);
+            page = page_handle->get_active_page_id_position(a_position);
+            position_setting = page_handle->get_page_setting(page, a_position);
         } else {
             page = page_handle->get_active_page_id();
-            position_setting = page_handle->get_page_setting(page, position);
+            position_setting = page_handle->get_page_setting(page, a_position);
         }
         if (!position_setting) {
             logger::warn("nothing to do, nothing set. return."sv);
+            return nullptr;
         }
-        logger::debug("page {}, position is {}, setting count {}"sv,
+        LOG_DEBUG("page {}, position is {}, setting count {}"sv,
             page,
-            static_cast<uint32_t>(position),
+            static_cast<uint32_t>(a_position),
             position_setting->slot_settings.size());
 
         return position_setting;
@@ -99,8 +106,8 @@ namespace processing {
 
     void setting_execute::execute_ammo(const RE::TESForm* a_form) {
         if (a_form) {
-            auto* player = RE::PlayerCharacter::GetSingleton();
-            equip::item::equip_ammo(a_form, player);
+            action_queue::get_singleton()->add(
+                { .kind = action_queue::action_kind::ammo, .form = const_cast<RE::TESForm*>(a_form) });
         }
     }
 
@@ -108,7 +115,7 @@ namespace processing {
         if (!a_setting) {
             return;
         }
-        logger::trace("checking and calling re equip for setting {}, is setting empty {}"sv,
+        LOG_TRACE("checking and calling re equip for setting {}, is setting empty {}"sv,
             static_cast<uint32_t>(a_setting->position),
             a_setting->slot_settings.empty());
         auto* left_slot = equip::equip_slot::get_left_hand_slot();
@@ -119,45 +126,4 @@ namespace processing {
             processing::setting_execute::activate(a_setting->slot_settings);
         }
     }
-
-    void setting_execute::execute_setting(handle::slot_setting*& a_slot, RE::PlayerCharacter*& a_player) {
-        switch (a_slot->type) {
-            case slot_type::consumable:
-                if (a_slot->form) {
-                    equip::item::consume_potion(a_slot->form, a_player);
-                } else if (a_slot->actor_value != RE::ActorValue::kNone) {
-                    equip::item::find_and_consume_fitting_option(a_slot->actor_value, a_player);
-                }
-                break;
-            case slot_type::magic:
-                equip::magic::magic::cast_magic(a_slot->form, a_slot->action, a_slot->equip_slot, a_player);
-                break;
-            case slot_type::shout:
-                equip::magic::equip_shout(a_slot->form, a_player);
-                break;
-            case slot_type::power:
-                equip::magic::equip_or_cast_power(a_slot->form, a_slot->action, a_player);
-                break;
-            case slot_type::weapon:
-            case slot_type::shield:
-            case slot_type::light:
-                equip::item::equip_item(a_slot->form, a_slot->equip_slot, a_player, a_slot->type);
-                break;
-            case slot_type::armor:
-            case slot_type::lantern:
-            case slot_type::mask:
-                equip::item::equip_armor(a_slot->form, a_player);
-                break;
-            case slot_type::scroll:
-                equip::magic::cast_scroll(a_slot->form, a_slot->action, a_player);
-                break;
-            case slot_type::misc:
-                //TODO
-                logger::warn("ignoring misc-item."sv);
-                break;
-            case slot_type::empty:
-                equip::equip_slot::un_equip_hand(a_slot->equip_slot, a_player, a_slot->action);
-                break;
-        }
-    }
 }
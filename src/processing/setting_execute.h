@@ -13,10 +13,8 @@ namespace processing {
             bool a_only_equip = false,
             bool a_only_instant = false);
         static handle::position_setting* get_position_setting_for_key(uint32_t a_key);
+        static handle::position_setting* get_position_setting_for_position(position_type a_position);
         static void execute_ammo(const RE::TESForm* a_form);
         static void reequip_left_hand_if_needed(handle::position_setting* a_setting);
-
-    private:
-        static void execute_setting(handle::slot_setting*& a_slot, RE::PlayerCharacter*& a_player);
     };
 }
@@ -0,0 +1,292 @@
+#include "serialization.h"
+#include "equip/equip_slot.h"
+#include "handle/ammo_handle.h"
+#include "handle/data/page/page_snapshot.h"
+#include "handle/page_handle.h"
+#include "processing/set_setting_data.h"
+#include "setting/custom_setting.h"
+#include "setting/mcm_setting.h"
+#include "util/string_util.h"
+
+namespace serialization {
+    using mcm = config::mcm_setting;
+    using position_type = handle::position_setting::position_type;
+    using slot_type = handle::slot_setting::slot_type;
+
+    constexpr std::uint32_t serialization_id = 'LTHD';
+    constexpr std::uint32_t page_record_type = 'PAGE';
+    constexpr std::uint32_t page_record_version = 1;
+
+    //filled by the load callback, used up after the game is loaded
+    struct loaded_record {
+        std::vector<handle::page_snapshot> pages;
+        uint32_t active_page = 0;
+        std::map<position_type, uint32_t> active_page_per_position;
+        std::vector<handle::ammo_snapshot> ammo;
+        RE::FormID current_ammo = 0;
+    };
+
+    static std::optional<loaded_record> loaded;
+
+    void page_record::save_callback(SKSE::SerializationInterface* a_intfc) {
+        const auto* page_handle = handle::page_handle::get_singleton();
+        const auto* ammo_handle = handle::ammo_handle::get_singleton();
+
+        //pages that just got cycled to are still empty, no need to keep them
+        std::vector<handle::position_setting*> pages;
+        for (const auto& [key, page_setting] : page_handle->get_pages()) {
+            if (std::ranges::any_of(page_setting->slot_settings,
+                    [](const handle::slot_setting* a_slot) { return a_slot->type != slot_type::empty; })) {
+                pages.push_back(page_setting);
+            }
+        }
+
+        if (!a_intfc->OpenRecord(page_record_type, page_record_version)) {
+            logger::warn("could not open record for pages. return."sv);
+            return;
+        }
+
+        auto ok = true;
+        const auto write = [&](const auto& a_value) { ok = ok && a_intfc->WriteRecordData(a_value); };
+
+        uint64_t file_size = 0;
+        int64_t file_time = 0;
+        get_config_file_state(file_size, file_time);
+
+        write(static_cast<uint8_t>(mcm::get_elden_demon_souls()));
+        write(mcm::get_max_page_count());
+        write(file_size);
+        write(file_time);
+
+        write(page_handle->get_active_page_id());
+        for (auto i = 0; i < static_cast<int>(position_type::total); ++i) {
+            write(page_handle->get_active_page_id_position(static_cast<position_type>(i)));
+        }
+
+        write(static_cast<uint32_t>(pages.size()));
+        for (const auto* page : pages) {
+            const auto& slots = page->slot_settings;
+            write(page->page);
+            write(static_cast<uint32_t>(page->position));
+            write(static_cast<uint32_t>(slots.front()->equip));
+            write(static_cast<uint32_t>(page->icon_type));
+            write(static_cast<uint32_t>(slots.size()));
+            for (const auto* slot : slots) {
+                write(slot->form ? slot->form->GetFormID() : static_cast<RE::FormID>(0));
+                write(static_cast<uint32_t>(slot->type));
+                write(static_cast<uint32_t>(slot->action));
+                write(static_cast<int32_t>(slot->actor_value));
+                write(static_cast<uint8_t>(slot->equip_slot == equip::equip_slot::get_left_hand_slot()));
+                write(slot->item_count);
+            }
+        }
+
+        const auto ammo_list = ammo_handle->get_all();
+        const auto* current = ammo_handle->get_current();
+        auto current_index = -1;
+        write(static_cast<uint32_t>(ammo_list.size()));
+        for (auto i = 0; i < static_cast<int>(ammo_list.size()); ++i) {
+            write(ammo_list[i]->form->GetFormID());
+            write(ammo_list[i]->item_count);
+            if (ammo_list[i] == current) {
+                current_index = i;
+            }
+        }
+        write(current_index);
+
+        if (!ok) {
+            logger::warn("failed to write page record"sv);
+            return;
+        }
+        logger::info("wrote {} pages and {} ammo to the co-save"sv, pages.size(), ammo_list.size());
+    }
+
+    void page_record::load_callback(SKSE::SerializationInterface* a_intfc) {
+        loaded.reset();
+
+        std::uint32_t type;
+        std::uint32_t version;
+        std::uint32_t length;
+        while (a_intfc->GetNextRecordInfo(type, version, length)) {
+            if (type != page_record_type) {
+                logger::warn("unknown record type {}, skipping"sv, util::string_util::int_to_hex(type));
+                continue;
+            }
+            if (version != page_record_version) {
+                logger::warn("page record version {} does not match {}, using config"sv, version, page_record_version);
+                continue;
+            }
+            if (!read_record(a_intfc)) {
+                loaded.reset();
+            }
+        }
+    }
+
+    void page_record::revert_callback(SKSE::SerializationInterface*) { loaded.reset(); }
+
+    bool page_record::restore() {
+        if (!loaded) {
+            logger::info("no usable page record in co-save, reading config"sv);
+            return false;
+        }
+
+        processing::set_setting_data::restore_data(loaded->pages,
+            loaded->active_page,
+            loaded->active_page_per_position,
+            loaded->ammo,
+            loaded->current_ammo);
+        logger::info("restored {} pages from co-save"sv, loaded->pages.size());
+        loaded.reset();
+        return true;
+    }
+
+    bool page_record::read_record(SKSE::SerializationInterface* a_intfc) {
+        auto ok = true;
+        const auto read = [&](auto& a_value) {
+            ok = ok && a_intfc->ReadRecordData(a_value) == sizeof(a_value);
+        };
+        const auto resolve = [&](const RE::FormID a_form_id) -> RE::TESForm* {
+            RE::FormID new_form_id = 0;
+            if (!a_intfc->ResolveFormID(a_form_id, new_form_id)) {
+                logger::info("form {} could not be resolved"sv, util::string_util::int_to_hex(a_form_id));
+                return nullptr;
+            }
+            return RE::TESForm::LookupByID(new_form_id);
+        };
+
+        uint8_t elden = 0;
+        uint32_t max_page_count = 0;
+        uint64_t saved_size = 0;
+        int64_t saved_time = 0;
+        read(elden);
+        read(max_page_count);
+        read(saved_size);
+        read(saved_time);
+        if (!ok) {
+            logger::warn("failed to read page record header"sv);
+            return false;
+        }
+
+        uint64_t file_size = 0;
+        int64_t file_time = 0;
+        get_config_file_state(file_size, file_time);
+        if (static_cast<bool>(elden) != mcm::get_elden_demon_souls() || max_page_count != mcm::get_max_page_count() ||
+            saved_size != file_size || saved_time != file_time) {
+            logger::info("page record is stale, config or mode changed since the save. using config"sv);
+            return false;
+        }
+
+        loaded_record record;
+        read(record.active_page);
+        for (auto i = 0; i < static_cast<int>(position_type::total); ++i) {
+            uint32_t page = 0;
+            read(page);
+            record.active_page_per_position[static_cast<position_type>(i)] = page;
+        }
+
+        uint32_t page_count = 0;
+        read(page_count);
+        for (uint32_t i = 0; ok && i < page_count; ++i) {
+            handle::page_snapshot snapshot;
+            uint32_t position = 0;
+            uint32_t hand = 0;
+            uint32_t icon = 0;
+            uint32_t slot_count = 0;
+            read(snapshot.page);
+            read(position);
+            read(hand);
+            read(icon);
+            read(slot_count);
+            snapshot.position = static_cast<position_type>(position);
+            snapshot.hand = static_cast<handle::slot_setting::hand_equip>(hand);
+            snapshot.icon_type = static_cast<ui::icon_image_type>(icon);
+
+            for (uint32_t j = 0; ok && j < slot_count; ++j) {
+                RE::FormID form_id = 0;
+                uint32_t type = 0;
+                uint32_t action = 0;
+                int32_t actor_value = 0;
+                uint8_t left = 0;
+                int32_t item_count = 0;
+                read(form_id);
+                read(type);
+                read(action);
+                read(actor_value);
+                read(left);
+                read(item_count);
+
+                data_helper slot;
+                if (form_id) {
+                    slot.form = resolve(form_id);
+                    if (!slot.form) {
+                        logger::info("page {}, position {} holds a form that is gone. using config"sv,
+                            snapshot.page,
+                            position);
+                        return false;
+                    }
+                }
+                slot.type = static_cast<slot_type>(type);
+                slot.action_type = static_cast<handle::slot_setting::action_type>(action);
+                slot.actor_value = static_cast<RE::ActorValue>(actor_value);
+                slot.left = static_cast<bool>(left);
+                snapshot.slots.push_back(slot);
+                snapshot.item_counts.push_back(item_count);
+            }
+            record.pages.push_back(std::move(snapshot));
+        }
+
+        uint32_t ammo_count = 0;
+        read(ammo_count);
+        //the saved index counts the ammo that cannot be resolved anymore as well
+        std::vector<RE::FormID> saved_ammo;
+        for (uint32_t i = 0; ok && i < ammo_count; ++i) {
+            handle::ammo_snapshot ammo;
+            read(ammo.form_id);
+            read(ammo.item_count);
+            //ammo gets looked up again on the next bow equip anyway, so a missing one is not a reason to drop it all
+            const auto* form = ok ? resolve(ammo.form_id) : nullptr;
+            ammo.form_id = form ? form->GetFormID() : 0;
+            saved_ammo.push_back(ammo.form_id);
+            if (form) {
+                record.ammo.push_back(ammo);
+            }
+        }
+        int32_t current_ammo = -1;
+        read(current_ammo);
+        if (current_ammo >= 0 && current_ammo < static_cast<int32_t>(saved_ammo.size())) {
+            record.current_ammo = saved_ammo[current_ammo];
+        }
+
+        if (!ok) {
+            logger::warn("failed to read page record"sv);
+            return false;
+        }
+
+        LOG_TRACE("read {} pages and {} ammo from co-save"sv, record.pages.size(), record.ammo.size());
+        loaded = std::move(record);
+        return true;
+    }
+
+    void page_record::get_config_file_state(uint64_t& a_size, int64_t& a_time) {
+        a_size = 0;
+        a_time = 0;
+        const std::filesystem::path path = config::custom_setting::get_file_path();
+
+        std::error_code error;
+        if (const auto size = std::filesystem::file_size(path, error); !error) {
+            a_size = size;
+        }
+        if (const auto time = std::filesystem::last_write_time(path, error); !error) {
+            a_time = time.time_since_epoch().count();
+        }
+    }
+
+    void Register() {
+        auto* serialization = SKSE::GetSerializationInterface();
+        serialization->SetUniqueID(serialization_id);
+        serialization->SetSaveCallback(page_record::save_callback);
+        serialization->SetLoadCallback(page_record::load_callback);
+        serialization->SetRevertCallback(page_record::revert_callback);
+        logger::info("Registered serialization callbacks. return."sv);
+    }
+}
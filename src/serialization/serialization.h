@@ -0,0 +1,19 @@
+#pragma once
+
+namespace serialization {
+    class page_record {
+    public:
+        static void save_callback(SKSE::SerializationInterface* a_intfc);
+        static void load_callback(SKSE::SerializationInterface* a_intfc);
+        static void revert_callback(SKSE::SerializationInterface* a_intfc);
+
+        //sets the pages read from the co-save, false if there was none or it does not fit the config anymore
+        static bool restore();
+
+    private:
+        static bool read_record(SKSE::SerializationInterface* a_intfc);
+        static void get_config_file_state(uint64_t& a_size, int64_t& a_time);
+    };
+
+    void Register();
+}
@@ -1,95 +1,166 @@
 ﻿#include "custom_setting.h"
+#include "core/config/page_config.h"
 #include "file_setting.h"
 #include "mcm_setting.h"
+#include "setting_watcher.h"
 #include "util/constant.h"
 
 namespace config {
-    CSimpleIniA custom_ini;
+    std::unique_ptr<CSimpleIniA> custom_ini = std::make_unique<CSimpleIniA>(true);
+    //the main thread, the script vm and the watcher all get to the config and its file, one at a time
+    std::recursive_mutex custom_lock;
+
+    std::unique_lock<std::recursive_mutex> custom_setting::lock_setting() {
+        return std::unique_lock(custom_lock);
+    }
 
     void custom_setting::read_setting() {
-        custom_ini.Reset();
-        custom_ini.SetUnicode();
-        if (config::mcm_setting::get_elden_demon_souls()) {
-            custom_ini.LoadFile((util::ini_path + config::file_setting::get_config_elden()).c_str());
-        } else {
-            custom_ini.LoadFile((util::ini_path + config::file_setting::get_config_default()).c_str());
+        std::scoped_lock lock(custom_lock);
+        custom_ini->Reset();
+        custom_ini->SetUnicode();
+        custom_ini->LoadFile(get_file_path().c_str());
+    }
+
+    void custom_setting::load_setting(std::unique_ptr<CSimpleIniA> a_ini) {
+        std::scoped_lock lock(custom_lock);
+        if (a_ini) {
+            custom_ini = std::move(a_ini);
         }
     }
 
+    std::unique_ptr<CSimpleIniA> custom_setting::parse_setting(const std::string& a_path, const bool a_normalize) {
+        auto ini = std::make_unique<CSimpleIniA>(true);
+
+        //the normalized file is written over the one that was read, nobody may write it in between
+        std::scoped_lock lock(custom_lock);
+        std::string content;
+        if (std::ifstream file(a_path, std::ios::binary); file) {
+            std::stringstream stream;
+            stream << file.rdbuf();
+            content = stream.str();
+        }
+
+        if (a_normalize) {
+            core::ini_file file;
+            file.parse(content);
+            core::page_config config(core::page_config::config_mode::elden);
+            config.read(file);
+            //written in one go, instead of a read and a save for every section
+            if (const auto changed = config.normalize(); changed > 0) {
+                content = config.write();
+                std::ofstream out(a_path, std::ios::binary | std::ios::trunc);
+                out << content;
+                LOG_TRACE("wrote {} with consecutive pages, {} sections changed"sv, a_path, changed);
+            }
+        }
+
+        if (ini->LoadData(content) < 0) {
+            logger::warn("could not parse {}, using defaults for it"sv, a_path);
+        }
+        return ini;
+    }
+
+    std::string custom_setting::get_file_path() { return get_file_path(mcm_setting::get_elden_demon_souls()); }
+
+    std::string custom_setting::get_file_path(const bool a_elden) {
+        if (a_elden) {
+            return util::ini_path + config::file_setting::get_config_elden();
+        }
+        return util::ini_path + config::file_setting::get_config_default();
+    }
+
     CSimpleIniA::TNamesDepend custom_setting::get_sections() {
-        //just to be sure, after the reorder feature
-        read_setting();
+        std::scoped_lock lock(custom_lock);
+        //whoever needs the file as it is on disk reads it first, the writes here keep it in sync anyway
         CSimpleIniA::TNamesDepend sections;
-        custom_ini.GetAllSections(sections);
+        custom_ini->GetAllSections(sections);
 
         return sections;
     }
 
+    std::string custom_setting::get_section_name(const util::page_key a_key) {
+        //the only place the section names get generated, everything else works with the key
+        return fmt::format("Page{}Position{}", util::get_page_from_key(a_key), util::get_position_from_key(a_key));
+    }
+
     uint32_t custom_setting::get_page_by_section(const std::string& a_section) {
-        return static_cast<uint32_t>(custom_ini.GetLongValue(a_section.c_str(), "uPage", 0));
+        std::scoped_lock lock(custom_lock);
+        return static_cast<uint32_t>(custom_ini->GetLongValue(a_section.c_str(), "uPage", 0));
     }
 
     uint32_t custom_setting::get_position_by_section(const std::string& a_section) {
-        return static_cast<uint32_t>(custom_ini.GetLongValue(a_section.c_str(), "uPosition", 0));
+        std::scoped_lock lock(custom_lock);
+        return static_cast<uint32_t>(custom_ini->GetLongValue(a_section.c_str(), "uPosition", 0));
     }
 
     uint32_t custom_setting::get_type_by_section(const std::string& a_section) {
-        return static_cast<uint32_t>(custom_ini.GetLongValue(a_section.c_str(), "uType", 0));
+        std::scoped_lock lock(custom_lock);
+        return static_cast<uint32_t>(custom_ini->GetLongValue(a_section.c_str(), "uType", 0));
     }
 
     std::string custom_setting::get_item_form_by_section(const std::string& a_section) {
-        return custom_ini.GetValue(a_section.c_str(), "sSelectedItemForm", "");
+        std::scoped_lock lock(custom_lock);
+        return custom_ini->GetValue(a_section.c_str(), "sSelectedItemForm", "");
     }
 
     uint32_t custom_setting::get_slot_action_by_section(const std::string& a_section) {
-        return static_cast<uint32_t>(custom_ini.GetLongValue(a_section.c_str(), "uSlotAction", 0));
+        std::scoped_lock lock(custom_lock);
+        return static_cast<uint32_t>(custom_ini->GetLongValue(a_section.c_str(), "uSlotAction", 0));
     }
 
     uint32_t custom_setting::get_hand_selection_by_section(const std::string& a_section) {
-        return static_cast<uint32_t>(custom_ini.GetLongValue(a_section.c_str(), "uHandSelection", 1));
+        std::scoped_lock lock(custom_lock);
+        return static_cast<uint32_t>(custom_ini->GetLongValue(a_section.c_str(), "uHandSelection", 1));
     }
 
     int custom_setting::get_effect_actor_value(const std::string& a_section) {
-        return static_cast<int>(custom_ini.GetLongValue(a_section.c_str(), "iEffectActorValue", -1));
+        std::scoped_lock lock(custom_lock);
+        return static_cast<int>(custom_ini->GetLongValue(a_section.c_str(), "iEffectActorValue", -1));
     }
 
     uint32_t custom_setting::get_type_left_by_section(const std::string& a_section) {
-        return static_cast<uint32_t>(custom_ini.GetLongValue(a_section.c_str(), "uTypeLeft", 0));
+        std::scoped_lock lock(custom_lock);
+        return static_cast<uint32_t>(custom_ini->GetLongValue(a_section.c_str(), "uTypeLeft", 0));
     }
 
     std::string custom_setting::get_item_form_left_by_section(const std::string& a_section) {
-        return custom_ini.GetValue(a_section.c_str(), "sSelectedItemFormLeft", "");
+        std::scoped_lock lock(custom_lock);
+        return custom_ini->GetValue(a_section.c_str(), "sSelectedItemFormLeft", "");
     }
 
     uint32_t custom_setting::get_slot_action_left_by_section(const std::string& a_section) {
-        return static_cast<uint32_t>(custom_ini.GetLongValue(a_section.c_str(), "uSlotActionLeft", 0));
+        std::scoped_lock lock(custom_lock);
+        return static_cast<uint32_t>(custom_ini->GetLongValue(a_section.c_str(), "uSlotActionLeft", 0));
     }
 
     void custom_setting::reset_section(const std::string& a_section) {
+        std::scoped_lock lock(custom_lock);
         read_setting();
-        logger::trace("resetting section {}"sv, a_section);
-        custom_ini.Delete(a_section.c_str(), nullptr);
+        LOG_TRACE("resetting section {}"sv, a_section);
+        custom_ini->Delete(a_section.c_str(), nullptr);
 
         save_setting();
     }
 
+    void custom_setting::reset_section(const util::page_key a_key) { reset_section(get_section_name(a_key)); }
+
     void custom_setting::write_slot_action_by_section(const std::string& a_section, const uint32_t a_action) {
+        std::scoped_lock lock(custom_lock);
         read_setting();
-        custom_ini.SetLongValue(a_section.c_str(), "uSlotAction", static_cast<long>(a_action));
+        custom_ini->SetLongValue(a_section.c_str(), "uSlotAction", static_cast<long>(a_action));
 
         save_setting();
     }
 
     void custom_setting::write_slot_action_left_by_section(const std::string& a_section, const uint32_t a_action) {
+        std::scoped_lock lock(custom_lock);
         read_setting();
-        custom_ini.SetLongValue(a_section.c_str(), "uSlotActionLeft", static_cast<long>(a_action));
+        custom_ini->SetLongValue(a_section.c_str(), "uSlotActionLeft", static_cast<long>(a_action));
 
         save_setting();
     }
 
-    void custom_setting::write_section_setting(const std::string& a_section,
-        uint32_t a_page,
-        uint32_t a_position,
+    void custom_setting::write_section_setting(const util::page_key a_key,
         uint32_t a_type,
         const std::string& a_form,
         uint32_t a_action,
@@ -98,11 +169,15 @@ namespace config {
         const std::string& a_form_left,
         uint32_t a_action_left,
         int a_effect_actor_value) {
-        logger::trace(
+        std::scoped_lock lock(custom_lock);
+        const auto page = util::get_page_from_key(a_key);
+        const auto position = util::get_position_from_key(a_key);
+        const auto section_name = get_section_name(a_key);
+        LOG_TRACE(
             "writing section {}, page {}, position {}, type {}, form {}, action {}, hand {}, type_left {}, a_form_left {}, action_left {}, a_effect_actor_value {}"sv,
-            a_section,
-            a_page,
-            a_position,
+            section_name,
+            page,
+            position,
             a_type,
             a_form,
             a_action,
@@ -112,30 +187,28 @@ namespace config {
             a_action_left,
             a_effect_actor_value);
 
-        const auto section = a_section.c_str();
+        const auto section = section_name.c_str();
 
-        reset_section(section);
+        reset_section(section_name);
 
-        custom_ini.SetLongValue(section, "uPage", static_cast<long>(a_page));
-        custom_ini.SetLongValue(section, "uPosition", static_cast<long>(a_position));
-        custom_ini.SetLongValue(section, "uType", static_cast<long>(a_type));
-        custom_ini.SetValue(section, "sSelectedItemForm", a_form.c_str());
-        custom_ini.SetLongValue(section, "uSlotAction", static_cast<long>(a_action));
-        custom_ini.SetLongValue(section, "uHandSelection", static_cast<long>(a_hand));
-        custom_ini.SetLongValue(section, "iEffectActorValue", a_effect_actor_value);
-        custom_ini.SetLongValue(section, "uTypeLeft", static_cast<long>(a_type_left));
-        custom_ini.SetValue(section, "sSelectedItemFormLeft", a_form_left.c_str());
-        custom_ini.SetLongValue(section, "uSlotActionLeft", static_cast<long>(a_action_left));
+        custom_ini->SetLongValue(section, "uPage", static_cast<long>(page));
+        custom_ini->SetLongValue(section, "uPosition", static_cast<long>(position));
+        custom_ini->SetLongValue(section, "uType", static_cast<long>(a_type));
+        custom_ini->SetValue(section, "sSelectedItemForm", a_form.c_str());
+        custom_ini->SetLongValue(section, "uSlotAction", static_cast<long>(a_action));
+        custom_ini->SetLongValue(section, "uHandSelection", static_cast<long>(a_hand));
+        custom_ini->SetLongValue(section, "iEffectActorValue", a_effect_actor_value);
+        custom_ini->SetLongValue(section, "uTypeLeft", static_cast<long>(a_type_left));
+        custom_ini->SetValue(section, "sSelectedItemFormLeft", a_form_left.c_str());
+        custom_ini->SetLongValue(section, "uSlotActionLeft", static_cast<long>(a_action_left));
 
         save_setting();
     }
 
     void custom_setting::save_setting() {
-        if (config::mcm_setting::get_elden_demon_souls()) {
-            (void)custom_ini.SaveFile((util::ini_path + config::file_setting::get_config_elden()).c_str());
-        } else {
-            (void)custom_ini.SaveFile((util::ini_path + config::file_setting::get_config_default()).c_str());
-        }
+        std::scoped_lock lock(custom_lock);
+        (void)custom_ini->SaveFile(get_file_path().c_str());
+        setting_watcher::get_singleton()->sync(setting_watcher::watched_file::custom);
         read_setting();
     }
 }
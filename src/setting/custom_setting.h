@@ -1,9 +1,19 @@
 ﻿#pragma once
+#include "util/page_key.h"
 
 namespace config {
     class custom_setting {
     public:
+        //the calls here take it themselves, hold it to get several values of the same config
+        [[nodiscard]] static std::unique_lock<std::recursive_mutex> lock_setting();
         static void read_setting();
+        //takes over a config parse_setting built, so the main thread does not touch the file
+        static void load_setting(std::unique_ptr<CSimpleIniA> a_ini);
+        //does not touch the loaded config, so it can run on any thread. normalize writes the file with consecutive
+        //pages first, like rewrite_settings does it for elden
+        static std::unique_ptr<CSimpleIniA> parse_setting(const std::string& a_path, bool a_normalize);
+        static std::string get_file_path();
+        static std::string get_file_path(bool a_elden);
 
         static CSimpleIniA::TNamesDepend get_sections();
 
@@ -19,13 +29,12 @@ namespace config {
         static uint32_t get_slot_action_left_by_section(const std::string& a_section);
 
         static void reset_section(const std::string& a_section);
+        static void reset_section(util::page_key a_key);
 
         static void write_slot_action_by_section(const std::string& a_section, uint32_t a_action);
         static void write_slot_action_left_by_section(const std::string& a_section, uint32_t a_action);
 
-        static void write_section_setting(const std::string& a_section,
-            uint32_t a_page,
-            uint32_t a_position,
+        static void write_section_setting(util::page_key a_key,
             uint32_t a_type,
             const std::string& a_form,
             uint32_t a_action,
@@ -37,5 +46,6 @@ namespace config {
 
     private:
         static void save_setting();
+        static std::string get_section_name(util::page_key a_key);
     };
 }
@@ -1,4 +1,5 @@
 ﻿#include "file_setting.h"
+#include "setting_watcher.h"
 #include "util/constant.h"
 
 namespace config {
@@ -7,6 +8,8 @@ namespace config {
     CSimpleIniA ini;
 
     static bool is_debug;
+    static bool log_block_when_full;
+    static bool record_trace;
     static bool draw_key_background;
 
     static bool font_load;
@@ -28,34 +31,53 @@ namespace config {
     void file_setting::load_setting() {
         logger::info("reading dll ini files");
 
+        load_file();
+        read_values(ini);
+
+        logger::info("finished reading dll ini files. return.");
+    }
+
+    void file_setting::load_setting(const CSimpleIniA& a_ini) {
+        logger::info("applying parsed dll ini file");
+        read_values(a_ini);
+        logger::info("finished applying dll ini file. return.");
+    }
+
+    std::string file_setting::get_file_path() { return ini_path; }
+
+    void file_setting::load_file() {
         ini.Reset();
         ini.SetUnicode();
         ini.LoadFile(ini_path);
+    }
 
-        is_debug = ini.GetBoolValue("General", "bIsDebug", false);
-
-        draw_key_background = ini.GetBoolValue("Image", "bDrawKeyBackground", false);
+    void file_setting::read_values(const CSimpleIniA& a_ini) {
+        is_debug = a_ini.GetBoolValue("General", "bIsDebug", false);
+        log_block_when_full = a_ini.GetBoolValue("General", "bLogBlockWhenFull", false);
+        record_trace = a_ini.GetBoolValue("General", "bRecordTrace", false);
 
-        font_load = ini.GetBoolValue("Font", "bLoad", true);
-        font_file_name = ini.GetValue("Font", "sName", "");
-        font_size = static_cast<float>(ini.GetDoubleValue("Font", "fSize", 20));
-        font_chinese_full = ini.GetBoolValue("Font", "bChineseFull", false);
-        font_chinese_simplified_common = ini.GetBoolValue("Font", "bChineseSimplifiedCommon", false);
-        font_cyrillic = ini.GetBoolValue("Font", "bCyrillic", false);
-        font_japanese = ini.GetBoolValue("Font", "bJapanese", false);
-        font_korean = ini.GetBoolValue("Font", "bKorean", false);
-        font_thai = ini.GetBoolValue("Font", "bThai", false);
-        font_vietnamese = ini.GetBoolValue("Font", "bVietnamese", false);
+        draw_key_background = a_ini.GetBoolValue("Image", "bDrawKeyBackground", false);
 
-        default_config = ini.GetValue("Config", "sDefault", (util::ini_default_name + util::ini_ending).c_str());
-        elden_config = ini.GetValue("Config", "sElden", (util::ini_elden_name + util::ini_ending).c_str());
+        font_load = a_ini.GetBoolValue("Font", "bLoad", true);
+        font_file_name = a_ini.GetValue("Font", "sName", "");
+        font_size = static_cast<float>(a_ini.GetDoubleValue("Font", "fSize", 20));
+        font_chinese_full = a_ini.GetBoolValue("Font", "bChineseFull", false);
+        font_chinese_simplified_common = a_ini.GetBoolValue("Font", "bChineseSimplifiedCommon", false);
+        font_cyrillic = a_ini.GetBoolValue("Font", "bCyrillic", false);
+        font_japanese = a_ini.GetBoolValue("Font", "bJapanese", false);
+        font_korean = a_ini.GetBoolValue("Font", "bKorean", false);
+        font_thai = a_ini.GetBoolValue("Font", "bThai", false);
+        font_vietnamese = a_ini.GetBoolValue("Font", "bVietnamese", false);
 
-        show_ui = ini.GetBoolValue("Interface", "bShowUI", true);
+        default_config = a_ini.GetValue("Config", "sDefault", (util::ini_default_name + util::ini_ending).c_str());
+        elden_config = a_ini.GetValue("Config", "sElden", (util::ini_elden_name + util::ini_ending).c_str());
 
-        logger::info("finished reading dll ini files. return.");
+        show_ui = a_ini.GetBoolValue("Interface", "bShowUI", true);
     }
 
     bool file_setting::get_is_debug() { return is_debug; }
+    bool file_setting::get_log_block_when_full() { return log_block_when_full; }
+    bool file_setting::get_record_trace() { return record_trace; }
     bool file_setting::get_draw_key_background() { return draw_key_background; }
 
     bool file_setting::get_font_load() { return font_load; }
@@ -73,15 +95,18 @@ namespace config {
 
     void file_setting::save_setting() {
         (void)ini.SaveFile(ini_path);
+        setting_watcher::get_singleton()->sync(setting_watcher::watched_file::file);
         load_setting();
     }
 
     void file_setting::set_config_default(const std::string& a_config) {
+        load_file();
         ini.SetValue("Config", "sDefault", a_config.c_str());
         save_setting();
     }
 
     void file_setting::set_config_elden(const std::string& a_config) {
+        load_file();
         ini.SetValue("Config", "sElden", a_config.c_str());
         save_setting();
     }
@@ -89,6 +114,7 @@ namespace config {
     bool file_setting::get_show_ui() { return show_ui; }
 
     void file_setting::set_show_ui(bool a_show) {
+        load_file();
         ini.SetBoolValue("Interface", "bShowUI", a_show);
         save_setting();
     }
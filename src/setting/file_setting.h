@@ -4,8 +4,12 @@ namespace config {
     class file_setting {
     public:
         static void load_setting();
+        static void load_setting(const CSimpleIniA& a_ini);
+        static std::string get_file_path();
 
         static bool get_is_debug();
+        static bool get_log_block_when_full();
+        static bool get_record_trace();
         static bool get_draw_key_background();
 
         static bool get_font_load();
@@ -29,6 +33,8 @@ namespace config {
         static void set_show_ui(bool a_show);
 
     private:
+        static void load_file();
+        static void read_values(const CSimpleIniA& a_ini);
         static void save_setting();
     };
 }
@@ -15,6 +15,7 @@ namespace config {
     static uint32_t left_or_overwrite_edit_key;
     static uint32_t remove_key;
     static bool bottom_execute_key_combo_only;
+    static uint32_t cycle_commit_delay;
     static uint32_t controller_set;
 
     static float hud_image_scale_width;
@@ -118,149 +119,169 @@ namespace config {
             CSimpleIniA mcm;
             mcm.SetUnicode();
             mcm.LoadFile(path.string().c_str());
+            read_values(mcm);
+        };
+
+        read_mcm(mcm_default_setting);
+        read_mcm(mcm_config_setting);
+
+        logger::info("finished reading mcm ini files. return.");
+    }
 
-            top_action_key = static_cast<uint32_t>(mcm.GetLongValue("Controls", "uTopActionKey", 10));
-            right_action_key = static_cast<uint32_t>(mcm.GetLongValue("Controls", "uRightActionKey", 11));
-            bottom_action_key = static_cast<uint32_t>(mcm.GetLongValue("Controls", "uBottomActionKey", 12));
-            left_action_key = static_cast<uint32_t>(mcm.GetLongValue("Controls", "uLeftActionKey", 13));
-            toggle_key = static_cast<uint32_t>(mcm.GetLongValue("Controls", "uToggleKey", 27));
-            show_hide_key = static_cast<uint32_t>(mcm.GetLongValue("Controls", "uShowHideKey", 26));
-            key_press_to_enter_edit = mcm.GetBoolValue("Controls", "bKeyPressToEnterEdit", false);
-            edit_key = static_cast<uint32_t>(mcm.GetLongValue("Controls", "uKeyToEnterEdit", 22));
-            left_or_overwrite_edit_key =
-                static_cast<uint32_t>(mcm.GetLongValue("Controls", "uLeftOrOverwriteEditKey", 38));
-            remove_key = static_cast<uint32_t>(mcm.GetLongValue("Controls", "uRemoveKey", 37));
+    void mcm_setting::read_setting(const CSimpleIniA& a_default, const CSimpleIniA& a_config) {
+        logger::info("applying parsed mcm ini files");
+        read_values(a_default);
+        read_values(a_config);
+        logger::info("finished applying mcm ini files. return.");
+    }
 
-            bottom_execute_key_combo_only = mcm.GetBoolValue("Controls", "bBottomExecuteKeyComboOnly", false);
-            controller_set = static_cast<uint32_t>(mcm.GetLongValue("Controls", "uControllerSet", 0));
+    bool mcm_setting::read_elden_demon_souls(const CSimpleIniA& a_default, const CSimpleIniA& a_config) {
+        return a_config.GetBoolValue("MiscSetting",
+            "bEldenDemonSouls",
+            a_default.GetBoolValue("MiscSetting", "bEldenDemonSouls", false));
+    }
 
-            hud_image_scale_width = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fHudImageScaleWidth", 0.16));
-            hud_image_scale_height = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fHudImageScaleHeight", 0.16));
-            hud_image_position_width =
-                static_cast<float>(mcm.GetDoubleValue("HudSetting", "fHudImagePositionWidth", 200));
-            hud_image_position_height =
-                static_cast<float>(mcm.GetDoubleValue("HudSetting", "fHudImagePositionHeight", 775));
-            hud_slot_position_offset_x =
-                static_cast<float>(mcm.GetDoubleValue("HudSetting", "fHudSlotPositionOffsetX", 105));
-            hud_slot_position_offset_y =
-                static_cast<float>(mcm.GetDoubleValue("HudSetting", "fHudSlotPositionOffsetY", 105));
-            hud_key_position_offset = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fHudKeyPositionOffset", 38));
-            icon_scale_width = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fIconScaleWidth", 0.10));
-            icon_scale_height = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fIconScaleHeight", 0.10));
-            key_icon_scale_width = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fKeyIconScaleWidth", 0.28));
-            key_icon_scale_height = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fKeyIconScaleHeight", 0.28));
-            hud_arrow_image_scale_width =
-                static_cast<float>(mcm.GetDoubleValue("HudSetting", "fHudArrowImageScaleWidth", 0.09));
-            hud_arrow_image_scale_height =
-                static_cast<float>(mcm.GetDoubleValue("HudSetting", "fHudArrowImageScaleHeight", 0.09));
-            arrow_icon_scale_width = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fArrowIconScaleWidth", 0.05));
-            arrow_icon_scale_height =
-                static_cast<float>(mcm.GetDoubleValue("HudSetting", "fArrowIconScaleHeight", 0.05));
-            master_scale = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fMasterScale", 1));
-            toggle_key_offset_x = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fToggleKeyOffsetX", 115));
-            toggle_key_offset_y = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fToggleKeyOffsetY", 115));
-            current_items_offset_x = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fCurrentItemsOffsetX", -15));
-            current_items_offset_y = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fCurrentItemsOffsetY", 215));
-            slot_count_text_offset = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fSlotCountTextOffset", 20));
-            slot_item_name_offset_horizontal_x =
-                static_cast<float>(mcm.GetDoubleValue("HudSetting", "fSlotItemNameOffsetHorizontalX", -15));
-            slot_item_name_offset_horizontal_y =
-                static_cast<float>(mcm.GetDoubleValue("HudSetting", "fSlotItemNameOffsetHorizontalY", 100));
-            slot_item_name_offset_vertical_x =
-                static_cast<float>(mcm.GetDoubleValue("HudSetting", "fSlotItemNameOffsetVerticalX", 10));
-            slot_item_name_offset_vertical_y =
-                static_cast<float>(mcm.GetDoubleValue("HudSetting", "fSlotItemNameOffsetVerticalY", 65));
-            arrow_slot_offset_x = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fArrowSlotOffsetX", -125));
-            arrow_slot_offset_y = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fArrowSlotOffsetY", 125));
-            arrow_slot_count_text_offset =
-                static_cast<float>(mcm.GetDoubleValue("HudSetting", "fArrowSlotCountTextOffset", 12));
-            current_shout_offset_x = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fCurrentShoutOffsetX", -10));
-            current_shout_offset_y = static_cast<float>(mcm.GetDoubleValue("HudSetting", "fCurrentShoutOffsetY", -225));
+    std::string mcm_setting::get_default_file_path() { return mcm_default_setting; }
+    std::string mcm_setting::get_config_file_path() { return mcm_config_setting; }
 
-            background_transparency =
-                static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uBackgroundTransparency", 150));
-            background_icon_transparency =
-                static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uBackgroundIconTransparency", 175));
-            icon_transparency = static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uIconTransparency", 125));
-            key_transparency = static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uKeyTransparency", 225));
-            current_items_transparency =
-                static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uCurrentItemsTransparency", 255));
-            current_shout_transparency =
-                static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uCurrentShoutTransparency", 255));
-            slot_count_transparency =
-                static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uSlotCountTransparency", 255));
-            slot_item_name_transparency =
-                static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uSlotItemNameTransparency", 255));
-            icon_transparency_blocked =
-                static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uIconTransparencyBlocked", 50));
-            slot_count_text_font_size =
-                static_cast<float>(mcm.GetDoubleValue("GraphicSetting", "fSlotCountTextFontSize", 20));
-            current_items_font_size =
-                static_cast<float>(mcm.GetDoubleValue("GraphicSetting", "fCurrentItemsFontSize", 20));
-            arrow_count_font_size = static_cast<float>(mcm.GetDoubleValue("GraphicSetting", "fArrowCountFontSize", 20));
-            current_items_red = static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uCurrentItemsRed", 255));
-            current_items_green = static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uCurrentItemsGreen", 255));
-            current_items_blue = static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uCurrentItemsBlue", 255));
-            slot_count_red = static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uSlotCountRed", 255));
-            slot_count_green = static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uSlotCountGreen", 255));
-            slot_count_blue = static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uSlotCountBlue", 255));
-            slot_item_red = static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uSlotItemRed", 255));
-            slot_item_green = static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uSlotItemGreen", 255));
-            slot_item_blue = static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uSlotItemBlue", 255));
+    void mcm_setting::read_values(const CSimpleIniA& a_mcm) {
+        top_action_key = static_cast<uint32_t>(a_mcm.GetLongValue("Controls", "uTopActionKey", 10));
+        right_action_key = static_cast<uint32_t>(a_mcm.GetLongValue("Controls", "uRightActionKey", 11));
+        bottom_action_key = static_cast<uint32_t>(a_mcm.GetLongValue("Controls", "uBottomActionKey", 12));
+        left_action_key = static_cast<uint32_t>(a_mcm.GetLongValue("Controls", "uLeftActionKey", 13));
+        toggle_key = static_cast<uint32_t>(a_mcm.GetLongValue("Controls", "uToggleKey", 27));
+        show_hide_key = static_cast<uint32_t>(a_mcm.GetLongValue("Controls", "uShowHideKey", 26));
+        key_press_to_enter_edit = a_mcm.GetBoolValue("Controls", "bKeyPressToEnterEdit", false);
+        edit_key = static_cast<uint32_t>(a_mcm.GetLongValue("Controls", "uKeyToEnterEdit", 22));
+        left_or_overwrite_edit_key =
+            static_cast<uint32_t>(a_mcm.GetLongValue("Controls", "uLeftOrOverwriteEditKey", 38));
+        remove_key = static_cast<uint32_t>(a_mcm.GetLongValue("Controls", "uRemoveKey", 37));
 
-            slot_button_feedback =
-                static_cast<uint32_t>(mcm.GetLongValue("GraphicSetting", "uSlotButtonFeedback", 150));
-            draw_current_items_text = mcm.GetBoolValue("GraphicSetting", "bDrawCurrentItemsText", true);
-            draw_item_name_text = mcm.GetBoolValue("GraphicSetting", "bDrawItemNameText", true);
-            draw_toggle_button = mcm.GetBoolValue("GraphicSetting", "bDrawToggleButton", true);
-            draw_current_shout_text = mcm.GetBoolValue("GraphicSetting", "bDrawCurrentShoutText", false);
-            current_shout_font_size =
-                static_cast<float>(mcm.GetDoubleValue("GraphicSetting", "fCurrentShoutFontSize", 20));
-            item_name_font_size = static_cast<float>(mcm.GetDoubleValue("GraphicSetting", "fItemNameTextFontSize", 20));
-            draw_page_id = mcm.GetBoolValue("GraphicSetting", "bDrawPageId", false);
+        bottom_execute_key_combo_only = a_mcm.GetBoolValue("Controls", "bBottomExecuteKeyComboOnly", false);
+        cycle_commit_delay = static_cast<uint32_t>(a_mcm.GetLongValue("Controls", "uCycleCommitDelay", 0));
+        controller_set = static_cast<uint32_t>(a_mcm.GetLongValue("Controls", "uControllerSet", 0));
 
-            alpha_slot_animation =
-                static_cast<uint32_t>(mcm.GetLongValue("AnimationSetting", "uAlphaSlotAnimation", 51));
-            duration_slot_animation =
-                static_cast<float>(mcm.GetDoubleValue("AnimationSetting", "fDurationSlotAnimation", 0.1));
+        hud_image_scale_width = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fHudImageScaleWidth", 0.16));
+        hud_image_scale_height = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fHudImageScaleHeight", 0.16));
+        hud_image_position_width =
+            static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fHudImagePositionWidth", 200));
+        hud_image_position_height =
+            static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fHudImagePositionHeight", 775));
+        hud_slot_position_offset_x =
+            static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fHudSlotPositionOffsetX", 105));
+        hud_slot_position_offset_y =
+            static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fHudSlotPositionOffsetY", 105));
+        hud_key_position_offset = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fHudKeyPositionOffset", 38));
+        icon_scale_width = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fIconScaleWidth", 0.10));
+        icon_scale_height = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fIconScaleHeight", 0.10));
+        key_icon_scale_width = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fKeyIconScaleWidth", 0.28));
+        key_icon_scale_height = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fKeyIconScaleHeight", 0.28));
+        hud_arrow_image_scale_width =
+            static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fHudArrowImageScaleWidth", 0.09));
+        hud_arrow_image_scale_height =
+            static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fHudArrowImageScaleHeight", 0.09));
+        arrow_icon_scale_width = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fArrowIconScaleWidth", 0.05));
+        arrow_icon_scale_height =
+            static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fArrowIconScaleHeight", 0.05));
+        master_scale = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fMasterScale", 1));
+        toggle_key_offset_x = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fToggleKeyOffsetX", 115));
+        toggle_key_offset_y = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fToggleKeyOffsetY", 115));
+        current_items_offset_x = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fCurrentItemsOffsetX", -15));
+        current_items_offset_y = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fCurrentItemsOffsetY", 215));
+        slot_count_text_offset = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fSlotCountTextOffset", 20));
+        slot_item_name_offset_horizontal_x =
+            static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fSlotItemNameOffsetHorizontalX", -15));
+        slot_item_name_offset_horizontal_y =
+            static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fSlotItemNameOffsetHorizontalY", 100));
+        slot_item_name_offset_vertical_x =
+            static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fSlotItemNameOffsetVerticalX", 10));
+        slot_item_name_offset_vertical_y =
+            static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fSlotItemNameOffsetVerticalY", 65));
+        arrow_slot_offset_x = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fArrowSlotOffsetX", -125));
+        arrow_slot_offset_y = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fArrowSlotOffsetY", 125));
+        arrow_slot_count_text_offset =
+            static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fArrowSlotCountTextOffset", 12));
+        current_shout_offset_x = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fCurrentShoutOffsetX", -10));
+        current_shout_offset_y = static_cast<float>(a_mcm.GetDoubleValue("HudSetting", "fCurrentShoutOffsetY", -225));
 
-            action_check = mcm.GetBoolValue("MiscSetting", "bActionCheck", false);
-            empty_hand_setting = mcm.GetBoolValue("MiscSetting", "bEmptyHandSetting", false);
-            hide_outside_combat = mcm.GetBoolValue("MiscSetting", "bHideOutsideCombat", false);
-            fade_timer_outside_combat =
-                static_cast<float>(mcm.GetDoubleValue("MiscSetting", "fFadeTimerOutsideCombat", 5));
-            disable_input_quick_loot = mcm.GetBoolValue("MiscSetting", "bDisableInputQuickLoot", false);
-            elder_demon_souls = mcm.GetBoolValue("MiscSetting", "bEldenDemonSouls", false);
-            max_page_count = static_cast<uint32_t>(mcm.GetLongValue("MiscSetting", "uMaxPageCount", 4));
-            max_ammunition_type = static_cast<uint32_t>(mcm.GetLongValue("MiscSetting", "uMaxAmmunitionType", 3));
-            check_duplicate_items = mcm.GetBoolValue("MiscSetting", "bCheckDuplicateItems", true);
-            un_equip_ammo = mcm.GetBoolValue("MiscSetting", "bUnEquipAmmo", false);
-            only_favorite_ammo = mcm.GetBoolValue("MiscSetting", "bOnlyFavoriteAmmo", false);
-            prevent_consumption_of_last_dynamic_potion =
-                mcm.GetBoolValue("MiscSetting", "bPreventConsumptionOfLastDynamicPotion", true);
-            group_potions = mcm.GetBoolValue("MiscSetting", "bGroupPotions", false);
-            potion_min_perfect = static_cast<float>(mcm.GetDoubleValue("MiscSetting", "fPotionMinPerfect", 0.7));
-            potion_max_perfect = static_cast<float>(mcm.GetDoubleValue("MiscSetting", "fPotionMaxPerfect", 1.2));
-            disable_re_equip_of_actives = mcm.GetBoolValue("MiscSetting", "bDisableReEquipOfActives", false);
-            sort_arrow_by_quantity = mcm.GetBoolValue("MiscSetting", "bSortArrowByQuantity", false);
-            overwrite_poison_dose = mcm.GetBoolValue("MiscSetting", "bPoisonDoseOverwrite", false);
-            apply_poison_dose = static_cast<uint32_t>(mcm.GetLongValue("MiscSetting", "uApplyPoisonDose", 5));
-            try_dual_cast_top_spell = mcm.GetBoolValue("MiscSetting", "bTryDualCastTopSpell", false);
+        background_transparency =
+            static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uBackgroundTransparency", 150));
+        background_icon_transparency =
+            static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uBackgroundIconTransparency", 175));
+        icon_transparency = static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uIconTransparency", 125));
+        key_transparency = static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uKeyTransparency", 225));
+        current_items_transparency =
+            static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uCurrentItemsTransparency", 255));
+        current_shout_transparency =
+            static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uCurrentShoutTransparency", 255));
+        slot_count_transparency =
+            static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uSlotCountTransparency", 255));
+        slot_item_name_transparency =
+            static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uSlotItemNameTransparency", 255));
+        icon_transparency_blocked =
+            static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uIconTransparencyBlocked", 50));
+        slot_count_text_font_size =
+            static_cast<float>(a_mcm.GetDoubleValue("GraphicSetting", "fSlotCountTextFontSize", 20));
+        current_items_font_size =
+            static_cast<float>(a_mcm.GetDoubleValue("GraphicSetting", "fCurrentItemsFontSize", 20));
+        arrow_count_font_size = static_cast<float>(a_mcm.GetDoubleValue("GraphicSetting", "fArrowCountFontSize", 20));
+        current_items_red = static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uCurrentItemsRed", 255));
+        current_items_green = static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uCurrentItemsGreen", 255));
+        current_items_blue = static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uCurrentItemsBlue", 255));
+        slot_count_red = static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uSlotCountRed", 255));
+        slot_count_green = static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uSlotCountGreen", 255));
+        slot_count_blue = static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uSlotCountBlue", 255));
+        slot_item_red = static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uSlotItemRed", 255));
+        slot_item_green = static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uSlotItemGreen", 255));
+        slot_item_blue = static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uSlotItemBlue", 255));
 
-            auto_cleanup = mcm.GetBoolValue("CleanupSetting", "bAutoCleanup", false);
-            clean_armor = mcm.GetBoolValue("CleanupSetting", "bCleanArmor", true);
-            clean_weapon = mcm.GetBoolValue("CleanupSetting", "bCleanWeapon", true);
-            clean_spell = mcm.GetBoolValue("CleanupSetting", "bCleanSpell", true);
-            clean_alchemy_item = mcm.GetBoolValue("CleanupSetting", "bCleanAlchemyItem", false);
-            clean_shout = mcm.GetBoolValue("CleanupSetting", "bCleanShout", true);
-            clean_light = mcm.GetBoolValue("CleanupSetting", "bCleanLight", false);
-            clean_scroll = mcm.GetBoolValue("CleanupSetting", "bCleanScroll", false);
-        };
+        slot_button_feedback =
+            static_cast<uint32_t>(a_mcm.GetLongValue("GraphicSetting", "uSlotButtonFeedback", 150));
+        draw_current_items_text = a_mcm.GetBoolValue("GraphicSetting", "bDrawCurrentItemsText", true);
+        draw_item_name_text = a_mcm.GetBoolValue("GraphicSetting", "bDrawItemNameText", true);
+        draw_toggle_button = a_mcm.GetBoolValue("GraphicSetting", "bDrawToggleButton", true);
+        draw_current_shout_text = a_mcm.GetBoolValue("GraphicSetting", "bDrawCurrentShoutText", false);
+        current_shout_font_size =
+            static_cast<float>(a_mcm.GetDoubleValue("GraphicSetting", "fCurrentShoutFontSize", 20));
+        item_name_font_size = static_cast<float>(a_mcm.GetDoubleValue("GraphicSetting", "fItemNameTextFontSize", 20));
+        draw_page_id = a_mcm.GetBoolValue("GraphicSetting", "bDrawPageId", false);
 
-        read_mcm(mcm_default_setting);
-        read_mcm(mcm_config_setting);
+        alpha_slot_animation =
+            static_cast<uint32_t>(a_mcm.GetLongValue("AnimationSetting", "uAlphaSlotAnimation", 51));
+        duration_slot_animation =
+            static_cast<float>(a_mcm.GetDoubleValue("AnimationSetting", "fDurationSlotAnimation", 0.1));
 
-        logger::info("finished reading mcm ini files. return.");
+        action_check = a_mcm.GetBoolValue("MiscSetting", "bActionCheck", false);
+        empty_hand_setting = a_mcm.GetBoolValue("MiscSetting", "bEmptyHandSetting", false);
+        hide_outside_combat = a_mcm.GetBoolValue("MiscSetting", "bHideOutsideCombat", false);
+        fade_timer_outside_combat =
+            static_cast<float>(a_mcm.GetDoubleValue("MiscSetting", "fFadeTimerOutsideCombat", 5));
+        disable_input_quick_loot = a_mcm.GetBoolValue("MiscSetting", "bDisableInputQuickLoot", false);
+        elder_demon_souls = a_mcm.GetBoolValue("MiscSetting", "bEldenDemonSouls", false);
+        max_page_count = static_cast<uint32_t>(a_mcm.GetLongValue("MiscSetting", "uMaxPageCount", 4));
+        max_ammunition_type = static_cast<uint32_t>(a_mcm.GetLongValue("MiscSetting", "uMaxAmmunitionType", 3));
+        check_duplicate_items = a_mcm.GetBoolValue("MiscSetting", "bCheckDuplicateItems", true);
+        un_equip_ammo = a_mcm.GetBoolValue("MiscSetting", "bUnEquipAmmo", false);
+        only_favorite_ammo = a_mcm.GetBoolValue("MiscSetting", "bOnlyFavoriteAmmo", false);
+        prevent_consumption_of_last_dynamic_potion =
+            a_mcm.GetBoolValue("MiscSetting", "bPreventConsumptionOfLastDynamicPotion", true);
+        group_potions = a_mcm.GetBoolValue("MiscSetting", "bGroupPotions", false);
+        potion_min_perfect = static_cast<float>(a_mcm.GetDoubleValue("MiscSetting", "fPotionMinPerfect", 0.7));
+        potion_max_perfect = static_cast<float>(a_mcm.GetDoubleValue("MiscSetting", "fPotionMaxPerfect", 1.2));
+        disable_re_equip_of_actives = a_mcm.GetBoolValue("MiscSetting", "bDisableReEquipOfActives", false);
+        sort_arrow_by_quantity = a_mcm.GetBoolValue("MiscSetting", "bSortArrowByQuantity", false);
+        overwrite_poison_dose = a_mcm.GetBoolValue("MiscSetting", "bPoisonDoseOverwrite", false);
+        apply_poison_dose = static_cast<uint32_t>(a_mcm.GetLongValue("MiscSetting", "uApplyPoisonDose", 5));
+        try_dual_cast_top_spell = a_mcm.GetBoolValue("MiscSetting", "bTryDualCastTopSpell", false);
+
+        auto_cleanup = a_mcm.GetBoolValue("CleanupSetting", "bAutoCleanup", false);
+        clean_armor = a_mcm.GetBoolValue("CleanupSetting", "bCleanArmor", true);
+        clean_weapon = a_mcm.GetBoolValue("CleanupSetting", "bCleanWeapon", true);
+        clean_spell = a_mcm.GetBoolValue("CleanupSetting", "bCleanSpell", true);
+        clean_alchemy_item = a_mcm.GetBoolValue("CleanupSetting", "bCleanAlchemyItem", false);
+        clean_shout = a_mcm.GetBoolValue("CleanupSetting", "bCleanShout", true);
+        clean_light = a_mcm.GetBoolValue("CleanupSetting", "bCleanLight", false);
+        clean_scroll = a_mcm.GetBoolValue("CleanupSetting", "bCleanScroll", false);
     }
 
     uint32_t mcm_setting::get_top_action_key() { return top_action_key; }
@@ -274,6 +295,7 @@ namespace config {
     uint32_t mcm_setting::get_left_or_overwrite_edit_key() { return left_or_overwrite_edit_key; }
     uint32_t mcm_setting::get_remove_key() { return remove_key; }
     bool mcm_setting::get_bottom_execute_key_combo_only() { return bottom_execute_key_combo_only; }
+    uint32_t mcm_setting::get_cycle_commit_delay() { return cycle_commit_delay; }
     uint32_t mcm_setting::get_controller_set() { return controller_set; }
 
     float mcm_setting::get_hud_image_scale_width() { return hud_image_scale_width * master_scale; }
@@ -4,6 +4,11 @@ namespace config {
     class mcm_setting {
     public:
         static void read_setting();
+        static void read_setting(const CSimpleIniA& a_default, const CSimpleIniA& a_config);
+        //just the mode out of parsed files, without applying them
+        static bool read_elden_demon_souls(const CSimpleIniA& a_default, const CSimpleIniA& a_config);
+        static std::string get_default_file_path();
+        static std::string get_config_file_path();
 
         static uint32_t get_top_action_key();
         static uint32_t get_right_action_key();
@@ -16,6 +21,7 @@ namespace config {
         static uint32_t get_left_or_overwrite_edit_key();
         static uint32_t get_remove_key();
         static bool get_bottom_execute_key_combo_only();
+        static uint32_t get_cycle_commit_delay();
         static uint32_t get_controller_set();
 
         static float get_hud_image_scale_width();
@@ -112,5 +118,8 @@ namespace config {
         static bool get_clean_shout();
         static bool get_clean_light();
         static bool get_clean_scroll();
+
+    private:
+        static void read_values(const CSimpleIniA& a_mcm);
     };
 }
@@ -0,0 +1,320 @@
+#include "setting_watcher.h"
+#include "control/binding.h"
+#include "custom_setting.h"
+#include "file_setting.h"
+#include "handle/item_count_handle.h"
+#include "mcm_setting.h"
+#include "processing/set_setting_data.h"
+#include "ui/ui_renderer.h"
+#include "util/helper.h"
+#include "util/ring_buffer_sink.h"
+#include "util/trace_recorder.h"
+
+namespace config {
+    constexpr auto poll_interval = std::chrono::seconds(1);
+
+    setting_watcher* setting_watcher::get_singleton() {
+        static setting_watcher singleton;
+        return std::addressof(singleton);
+    }
+
+    void setting_watcher::start() {
+        if (this->data_) {
+            return;
+        }
+        this->data_ = new setting_watcher_data();
+        setting_watcher_data* data = this->data_;
+
+        data->file.path = file_setting::get_file_path();
+        data->mcm_default.path = mcm_setting::get_default_file_path();
+        data->mcm_config.path = mcm_setting::get_config_file_path();
+        data->elden = mcm_setting::get_elden_demon_souls();
+        data->custom_default_path = custom_setting::get_file_path(false);
+        data->custom_elden_path = custom_setting::get_file_path(true);
+        data->custom.path = data->elden ? data->custom_elden_path : data->custom_default_path;
+
+        //everything got read at startup already, so the current state is what we compare against
+        has_changed(data->file);
+        has_changed(data->mcm_default);
+        has_changed(data->mcm_config);
+        has_changed(data->custom);
+
+        data->thread = std::jthread([this](const std::stop_token& a_stop) { run(a_stop); });
+        logger::info("started watching setting files, interval {}s"sv, poll_interval.count());
+    }
+
+    void setting_watcher::set_custom_path(const bool a_elden) const {
+        if (!this->data_) {
+            return;
+        }
+        setting_watcher_data* data = this->data_;
+        auto default_path = custom_setting::get_file_path(false);
+        auto elden_path = custom_setting::get_file_path(true);
+        std::scoped_lock lock(data->lock);
+        data->elden = a_elden;
+        data->custom_default_path = std::move(default_path);
+        data->custom_elden_path = std::move(elden_path);
+        const auto& path = a_elden ? data->custom_elden_path : data->custom_default_path;
+        if (data->custom.path == path) {
+            return;
+        }
+        LOG_TRACE("watching custom config {} now"sv, path);
+        data->custom.path = path;
+        has_changed(data->custom);
+    }
+
+    void setting_watcher::sync(const watched_file a_file, const bool a_drop_pending) const {
+        if (!this->data_) {
+            return;
+        }
+        setting_watcher_data* data = this->data_;
+        {
+            //the others might have been edited since the last poll, that is still to be picked up
+            std::scoped_lock lock(data->lock);
+            switch (a_file) {
+                case watched_file::file:
+                    has_changed(data->file);
+                    break;
+                case watched_file::mcm_default:
+                    has_changed(data->mcm_default);
+                    break;
+                case watched_file::mcm_config:
+                    has_changed(data->mcm_config);
+                    break;
+                case watched_file::custom:
+                    has_changed(data->custom);
+                    break;
+            }
+        }
+
+        if (!a_drop_pending) {
+            return;
+        }
+        if (auto* pending = data->pending.exchange(nullptr)) {
+            //a rebuild is still to come, that needs all of it
+            if (pending->rebuild) {
+                publish(pending);
+            } else if (pending->file_ini) {
+                //mcm and custom config got read by the caller, just the dll ini might still be needed
+                pending->mcm_default_ini.reset();
+                pending->mcm_config_ini.reset();
+                pending->custom_ini.reset();
+                pending->custom_changed = false;
+                publish(pending);
+            } else {
+                delete pending;
+            }
+        }
+    }
+
+    void setting_watcher::request_rebuild() {
+        if (!this->data_) {
+            start();
+        }
+        setting_watcher_data* data = this->data_;
+        {
+            std::scoped_lock lock(data->lock);
+            data->rebuild_requested = true;
+        }
+        data->wake.notify_one();
+        LOG_TRACE("requested rebuild"sv);
+    }
+
+    void setting_watcher::run(const std::stop_token& a_stop) const {
+        setting_watcher_data* data = this->data_;
+        while (!a_stop.stop_requested()) {
+            std::unique_lock lock(data->lock);
+            data->wake.wait_for(lock, a_stop, poll_interval, [data] { return data->rebuild_requested; });
+            if (a_stop.stop_requested()) {
+                break;
+            }
+
+            const auto rebuild = std::exchange(data->rebuild_requested, false);
+
+            const auto file_changed = has_changed(data->file);
+            const auto mcm_default_changed = has_changed(data->mcm_default);
+            const auto mcm_config_changed = has_changed(data->mcm_config);
+            const auto custom_changed = has_changed(data->custom);
+            const auto file_path = data->file.path;
+            const auto mcm_default_path = data->mcm_default.path;
+            const auto mcm_config_path = data->mcm_config.path;
+            auto elden = data->elden;
+            const auto custom_default_path = data->custom_default_path;
+            const auto custom_elden_path = data->custom_elden_path;
+            lock.unlock();
+
+            if (!rebuild && !file_changed && !mcm_default_changed && !mcm_config_changed && !custom_changed) {
+                //it could not be applied last time, try again
+                if (data->pending.load()) {
+                    publish(data->pending.exchange(nullptr));
+                }
+                continue;
+            }
+
+            LOG_TRACE("setting files changed, dll {}, mcm {}, custom {}, rebuild {}"sv,
+                file_changed,
+                mcm_default_changed || mcm_config_changed,
+                custom_changed,
+                rebuild);
+
+            //parsing happens here, the main thread just has to read the values
+            auto* snapshot = new setting_snapshot();
+            if (file_changed) {
+                snapshot->file_ini = parse(file_path);
+            }
+            //the mcm might have saved before we looked, so a rebuild always takes the files as they are now
+            if (rebuild || mcm_default_changed || mcm_config_changed) {
+                snapshot->mcm_default_ini = parse(mcm_default_path);
+                snapshot->mcm_config_ini = parse(mcm_config_path);
+                elden = mcm_setting::read_elden_demon_souls(*snapshot->mcm_default_ini, *snapshot->mcm_config_ini);
+            }
+            //the pages are built from it on the main thread, everything up to the form lookup happens here
+            if (rebuild || custom_changed) {
+                const auto& custom_path = elden ? custom_elden_path : custom_default_path;
+                snapshot->custom_ini = custom_setting::parse_setting(custom_path, elden);
+                snapshot->elden = elden;
+                //renumbering the pages might have written it, that is no change to pick up next time
+                lock.lock();
+                if (data->custom.path == custom_path) {
+                    has_changed(data->custom);
+                }
+                lock.unlock();
+            }
+            snapshot->custom_changed = custom_changed;
+            snapshot->rebuild = rebuild;
+            publish(snapshot);
+        }
+    }
+
+    void setting_watcher::publish(setting_snapshot* a_snapshot) const {
+        if (!a_snapshot) {
+            return;
+        }
+        setting_watcher_data* data = this->data_;
+
+        //the watcher thread and sync both publish, the merge has to happen in one go or a snapshot gets lost
+        std::scoped_lock lock(data->lock);
+        //an older one did not get applied yet, keep what it got and the new one does not
+        if (auto* older = data->pending.exchange(nullptr)) {
+            if (!a_snapshot->file_ini) {
+                a_snapshot->file_ini = std::move(older->file_ini);
+            }
+            if (!a_snapshot->mcm_default_ini || !a_snapshot->mcm_config_ini) {
+                a_snapshot->mcm_default_ini = std::move(older->mcm_default_ini);
+                a_snapshot->mcm_config_ini = std::move(older->mcm_config_ini);
+            }
+            if (!a_snapshot->custom_ini) {
+                a_snapshot->custom_ini = std::move(older->custom_ini);
+                a_snapshot->elden = older->elden;
+            }
+            a_snapshot->custom_changed = a_snapshot->custom_changed || older->custom_changed;
+            a_snapshot->rebuild = a_snapshot->rebuild || older->rebuild;
+            delete older;
+        }
+        data->pending.store(a_snapshot);
+
+        if (auto* task = SKSE::GetTaskInterface(); task) {
+            task->AddTask([this]() { apply(); });
+        }
+    }
+
+    void setting_watcher::apply() const {
+        setting_watcher_data* data = this->data_;
+
+        //wait with the swap until we are back in the game, the watcher thread queues it again
+        const auto* player = RE::PlayerCharacter::GetSingleton();
+        if (!player || !player->Is3DLoaded() || RE::UI::GetSingleton()->GameIsPaused()) {
+            return;
+        }
+
+        auto* snapshot = data->pending.exchange(nullptr);
+        if (!snapshot) {
+            return;
+        }
+
+        logger::info("applying changed setting files, dll {}, mcm {}, custom {}, rebuild {}"sv,
+            snapshot->file_ini != nullptr,
+            snapshot->mcm_default_ini != nullptr,
+            snapshot->custom_changed,
+            snapshot->rebuild);
+
+        if (snapshot->file_ini) {
+            file_setting::load_setting(*snapshot->file_ini);
+            const auto level = file_setting::get_is_debug() ? spdlog::level::trace : spdlog::level::info;
+            spdlog::set_level(level);
+            spdlog::flush_on(level);
+            if (auto* ring = util::ring_buffer_sink::get_default(); ring) {
+                ring->set_block_when_full(file_setting::get_log_block_when_full());
+            }
+            if (auto* recorder = util::trace_recorder::get_singleton();
+                file_setting::get_record_trace() != recorder->is_active()) {
+                recorder->set_enabled(file_setting::get_record_trace());
+                control::binding::get_singleton()->trace_dispatch();
+            }
+            ui::ui_renderer::set_show_ui(file_setting::get_show_ui());
+        }
+
+        if (snapshot->mcm_default_ini && snapshot->mcm_config_ini) {
+            mcm_setting::read_setting(*snapshot->mcm_default_ini, *snapshot->mcm_config_ini);
+            control::binding::get_singleton()->set_all_keys();
+        }
+        const auto rebuild = snapshot->rebuild;
+        //the dll ini alone does not change any page
+        const auto pages_changed = rebuild || snapshot->custom_changed || snapshot->mcm_default_ini;
+
+        //the mode or the selected config might have changed with it
+        const auto elden = mcm_setting::get_elden_demon_souls();
+        set_custom_path(elden);
+        //parsed for the mode it is in now, otherwise it is the file of the other mode
+        const auto custom_loaded = snapshot->custom_ini && snapshot->elden == elden;
+        if (custom_loaded) {
+            custom_setting::load_setting(std::move(snapshot->custom_ini));
+        }
+        delete snapshot;
+
+        if (rebuild) {
+            if (elden && !custom_loaded) {
+                util::helper::rewrite_settings();
+            }
+            //potion grouping might have changed
+            handle::item_count_handle::get_singleton()->reset();
+        }
+        if (pages_changed) {
+            processing::set_setting_data::read_and_set_data(custom_loaded);
+        }
+        if (rebuild) {
+            //the equips go through the action queue, so they run in a task of their own
+            processing::set_setting_data::get_actives_and_equip();
+        }
+        ui::ui_renderer::set_fade(true, 1.f);
+        logger::info("done applying changed setting files. return."sv);
+    }
+
+    bool setting_watcher::has_changed(file_state& a_state) {
+        uint64_t size = 0;
+        int64_t time = 0;
+        std::error_code error;
+        if (const auto file_size = std::filesystem::file_size(a_state.path, error); !error) {
+            size = file_size;
+        }
+        if (const auto write_time = std::filesystem::last_write_time(a_state.path, error); !error) {
+            time = write_time.time_since_epoch().count();
+        }
+
+        if (size == a_state.size && time == a_state.time) {
+            return false;
+        }
+        a_state.size = size;
+        a_state.time = time;
+        return true;
+    }
+
+    std::unique_ptr<CSimpleIniA> setting_watcher::parse(const std::string& a_path) {
+        auto ini = std::make_unique<CSimpleIniA>();
+        ini->SetUnicode();
+        if (ini->LoadFile(a_path.c_str()) < 0) {
+            logger::warn("could not parse {}, using defaults for it"sv, a_path);
+        }
+        return ini;
+    }
+}
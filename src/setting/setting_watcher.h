@@ -0,0 +1,72 @@
+#pragma once
+
+namespace config {
+    //polls the ini files on its own thread, changed files get parsed there and are applied on the next frame
+    class setting_watcher {
+    public:
+        enum class watched_file { file, mcm_default, mcm_config, custom };
+
+        static setting_watcher* get_singleton();
+        void start();
+        //the custom config depends on the mode and the selected file, so the main thread tells us which one to watch
+        void set_custom_path(bool a_elden) const;
+        //the file was just written by us, take it as seen. drop what the caller already read again
+        void sync(watched_file a_file, bool a_drop_pending = false) const;
+        //the mcm got closed. its files get parsed on the watcher thread and the pages are rebuilt on the next frame,
+        //the current ones stay on screen until then
+        void request_rebuild();
+
+        setting_watcher(const setting_watcher&) = delete;
+        setting_watcher(setting_watcher&&) = delete;
+
+        setting_watcher& operator=(const setting_watcher&) const = delete;
+        setting_watcher& operator=(setting_watcher&&) const = delete;
+
+    private:
+        setting_watcher() : data_(nullptr) {}
+        ~setting_watcher() = default;
+
+        struct file_state {
+            std::string path;
+            uint64_t size = 0;
+            int64_t time = 0;
+        };
+
+        //built on the watcher thread, not changed anymore once it is handed over
+        struct setting_snapshot {
+            std::unique_ptr<CSimpleIniA> file_ini;
+            std::unique_ptr<CSimpleIniA> mcm_default_ini;
+            std::unique_ptr<CSimpleIniA> mcm_config_ini;
+            //for the mode in elden, its pages are already renumbered
+            std::unique_ptr<CSimpleIniA> custom_ini;
+            bool elden = false;
+            bool custom_changed = false;
+            bool rebuild = false;
+        };
+
+        void run(const std::stop_token& a_stop) const;
+        void publish(setting_snapshot* a_snapshot) const;
+        void apply() const;
+        static bool has_changed(file_state& a_state);
+        static std::unique_ptr<CSimpleIniA> parse(const std::string& a_path);
+
+        struct setting_watcher_data {
+            std::jthread thread;
+            std::mutex lock;
+            std::condition_variable_any wake;
+            file_state file;
+            file_state mcm_default;
+            file_state mcm_config;
+            file_state custom;
+            //the file for each mode, a rebuild might switch it before the main thread knows
+            std::string custom_default_path;
+            std::string custom_elden_path;
+            bool elden = false;
+            bool rebuild_requested = false;
+            //swapped out alone by apply, merged under the lock by publish
+            std::atomic<setting_snapshot*> pending = nullptr;
+        };
+
+        setting_watcher_data* data_;
+    };
+}
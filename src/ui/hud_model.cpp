@@ -0,0 +1,195 @@
+#include "hud_model.h"
+#include "handle/ammo_handle.h"
+#include "handle/page_handle.h"
+#include "setting/mcm_setting.h"
+#include "util/constant.h"
+
+namespace ui {
+    using mcm = config::mcm_setting;
+    using slot_type = handle::slot_setting::slot_type;
+    using action_type = handle::slot_setting::action_type;
+
+    hud_model* hud_model::get_singleton() {
+        static hud_model singleton;
+        return std::addressof(singleton);
+    }
+
+    void hud_model::publish() const {
+        hud_model_data* data = this->data_;
+        if (data->build_queued.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+
+        if (auto* task = SKSE::GetTaskInterface(); task) {
+            task->AddTask([this]() { build_and_publish(); });
+        } else {
+            data->build_queued.store(false, std::memory_order_release);
+        }
+    }
+
+    void hud_model::build_and_publish() const {
+        hud_model_data* data = this->data_;
+        //cleared first, a change while building asks for the next build
+        data->build_queued.store(false, std::memory_order_release);
+        build(data->snapshots.get_write_buffer());
+        data->snapshots.publish();
+    }
+
+    void hud_model::highlight(const position_type a_position) const {
+        if (!this->data_->highlights.push(a_position)) {
+            LOG_TRACE("highlight queue is full, drop highlight for position {}"sv,
+                static_cast<uint32_t>(a_position));
+        }
+    }
+
+    const hud_snapshot& hud_model::get_snapshot() const {
+        this->data_->snapshots.update();
+        return this->data_->snapshots.get_read_buffer();
+    }
+
+    bool hud_model::pop_highlight(position_type& a_position) const { return this->data_->highlights.pop(a_position); }
+
+    void hud_model::build(hud_snapshot& a_snapshot) {
+        const auto draw_page = mcm::get_draw_page_id();
+        const auto elden = mcm::get_elden_demon_souls();
+
+        //the buffer is reused, so are the strings in it
+        auto& positions = a_snapshot.positions;
+        size_t count = 0;
+        for (const auto& [position, page_setting] : handle::page_handle::get_singleton()->get_active_page()) {
+            if (!page_setting) {
+                continue;
+            }
+            if (positions.size() == count) {
+                positions.emplace_back();
+            }
+            auto& snapshot = positions[count++];
+            snapshot.position = position;
+            snapshot.icon_type = static_cast<uint32_t>(page_setting->icon_type);
+            snapshot.button_press_modify = page_setting->button_press_modify;
+            snapshot.key = page_setting->key;
+            snapshot.draw_setting =
+                page_setting->draw_setting ? *page_setting->draw_setting : handle::position_draw_setting();
+            snapshot.item_name_font_size = page_setting->item_name_font_size;
+            snapshot.count_font_size = page_setting->count_font_size;
+            snapshot.item_name = page_setting->item_name;
+            set_slot_name(*page_setting, snapshot.slot_name);
+            set_slot_text(*page_setting, draw_page, elden, snapshot.slot_text);
+        }
+        positions.resize(count);
+
+        a_snapshot.ammo = false;
+        if (const auto* current_ammo = handle::ammo_handle::get_singleton()->get_current(); current_ammo && elden) {
+            a_snapshot.ammo = true;
+            a_snapshot.ammo_button_press_modify = current_ammo->button_press_modify;
+            a_snapshot.ammo_count = std::to_string(current_ammo->item_count ? current_ammo->item_count : 0);
+            set_ammo_draw_setting(a_snapshot.ammo_setting);
+        }
+    }
+
+    void hud_model::set_ammo_draw_setting(core::ammo_draw_setting& a_setting) {
+        a_setting.icon_type = static_cast<uint32_t>(icon_image_type::arrow);
+        a_setting.image_scale_width = mcm::get_hud_arrow_image_scale_width();
+        a_setting.image_scale_height = mcm::get_hud_arrow_image_scale_height();
+        a_setting.icon_scale_width = mcm::get_arrow_icon_scale_width();
+        a_setting.icon_scale_height = mcm::get_arrow_icon_scale_height();
+        a_setting.offset_slot_x = mcm::get_arrow_slot_offset_x();
+        a_setting.offset_slot_y = mcm::get_arrow_slot_offset_y();
+        a_setting.offset_text = mcm::get_arrow_slot_count_text_offset();
+        a_setting.count_font_size = mcm::get_arrow_count_font_size();
+        a_setting.background_icon_transparency = mcm::get_background_icon_transparency();
+        a_setting.icon_transparency = mcm::get_icon_transparency();
+        a_setting.slot_count_transparency = mcm::get_slot_count_transparency();
+        a_setting.slot_count_red = mcm::get_slot_count_red();
+        a_setting.slot_count_green = mcm::get_slot_count_green();
+        a_setting.slot_count_blue = mcm::get_slot_count_blue();
+    }
+
+    void hud_model::set_slot_name(const handle::position_setting& a_page, std::string& a_name) {
+        a_name.clear();
+        if (!a_page.item_name || a_page.slot_settings.empty()) {
+            return;
+        }
+
+        const auto* slot_setting = a_page.slot_settings.front();
+        if (slot_setting && slot_setting->form) {
+            a_name = slot_setting->form->GetName();
+        } else if (slot_setting && slot_setting->actor_value != RE::ActorValue::kNone &&
+                   slot_setting->type == slot_type::consumable &&
+                   util::actor_value_to_base_potion_map_.contains(slot_setting->actor_value)) {
+            const auto* potion_form =
+                RE::TESForm::LookupByID(util::actor_value_to_base_potion_map_[slot_setting->actor_value]);
+            if (potion_form && potion_form->Is(RE::FormType::AlchemyItem)) {
+                a_name = potion_form->GetName();
+            }
+        }
+    }
+
+    void hud_model::set_slot_text(const handle::position_setting& a_page,
+        const bool a_draw_page,
+        const bool a_elden,
+        std::string& a_text) {
+        a_text.clear();
+        const auto& slot_settings = a_page.slot_settings;
+        if (slot_settings.empty()) {
+            return;
+        }
+
+        const auto position = a_page.position;
+        switch (slot_settings.front()->type) {
+            case slot_type::scroll:
+            case slot_type::consumable:
+                if (slot_settings.front()->display_item_count) {
+                    a_text = std::to_string(slot_settings.front()->item_count);
+                }
+                break;
+            case slot_type::shout:
+            case slot_type::power:
+                a_text = slot_settings.front()->action == action_type::instant ? "I" : "E";
+                break;
+            case slot_type::magic:
+                if ((position == position_type::top && a_elden) || !a_elden) {
+                    a_text = slot_settings.front()->action == action_type::instant ? "I" : "E";
+                } else if (a_draw_page) {
+                    a_text = std::to_string(a_page.page);
+                }
+                break;
+            case slot_type::weapon:
+            case slot_type::shield:
+            case slot_type::light:
+                if (a_draw_page) {
+                    a_text = std::to_string(a_page.page);
+                }
+                break;
+            case slot_type::armor:
+            case slot_type::empty:
+            case slot_type::misc:
+            case slot_type::lantern:
+            case slot_type::mask:
+                //Nothing, for now
+                break;
+        }
+
+        if (a_draw_page && a_elden && position == position_type::left && slot_settings.size() == 2) {
+            switch (slot_settings[1]->type) {
+                case slot_type::magic:
+                case slot_type::weapon:
+                case slot_type::shield:
+                case slot_type::light:
+                    a_text = std::to_string(a_page.page);
+                    break;
+                case slot_type::scroll:
+                case slot_type::consumable:
+                case slot_type::shout:
+                case slot_type::power:
+                case slot_type::armor:
+                case slot_type::empty:
+                case slot_type::misc:
+                case slot_type::lantern:
+                case slot_type::mask:
+                    //Nothing, for now
+                    break;
+            }
+        }
+    }
+}
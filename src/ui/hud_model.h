@@ -0,0 +1,59 @@
+#pragma once
+#include "core/hud_snapshot.h"
+#include "handle/data/page/position_setting.h"
+#include "image_path.h"
+#include "util/spsc_queue.h"
+#include "util/triple_buffer.h"
+
+namespace ui {
+    //the snapshot itself is part of the core, so it can be drawn without the game
+    using hud_position_snapshot = core::hud_position_snapshot;
+    using hud_snapshot = core::hud_snapshot;
+
+    //the pages are changed by input, the inventory hooks and config loads, the renderer reads them every frame.
+    //whoever changes them asks for a snapshot, it is built on the main thread, where the pages are changed and freed.
+    //the renderer takes the newest one at the start of a frame.
+    //highlights happen once, so they are handed over in a queue and not as part of the snapshot
+    class hud_model {
+    public:
+        using position_type = handle::position_setting::position_type;
+
+        static hud_model* get_singleton();
+        //call it after changing the pages, the ammo or the draw settings, from any thread
+        void publish() const;
+        //only the input thread, position total is the ammo slot
+        void highlight(position_type a_position) const;
+        //only the renderer, stays valid until its next call
+        [[nodiscard]] const hud_snapshot& get_snapshot() const;
+        //only the renderer
+        bool pop_highlight(position_type& a_position) const;
+
+        hud_model(const hud_model&) = delete;
+        hud_model(hud_model&&) = delete;
+
+        hud_model& operator=(const hud_model&) const = delete;
+        hud_model& operator=(hud_model&&) const = delete;
+
+    private:
+        //the renderer reads it from the first frame on, so it is not created lazily
+        hud_model() : data_(new hud_model_data()) {}
+        ~hud_model() = default;
+
+        //only the main thread
+        void build_and_publish() const;
+        static void build(hud_snapshot& a_snapshot);
+        static void set_ammo_draw_setting(core::ammo_draw_setting& a_setting);
+        static void set_slot_name(const handle::position_setting& a_page, std::string& a_name);
+        static void
+            set_slot_text(const handle::position_setting& a_page, bool a_draw_page, bool a_elden, std::string& a_text);
+
+        struct hud_model_data {
+            util::triple_buffer<hud_snapshot> snapshots;
+            util::spsc_queue<position_type, 16> highlights;
+            //requests until the queued build ran end up in that one build
+            std::atomic<bool> build_queued = false;
+        };
+
+        hud_model_data* data_;
+    };
+}
@@ -1,14 +1,14 @@
 ﻿#include "ui_renderer.h"
 #include "animation_handler.h"
 #include "control/common.h"
-#include "handle/ammo_handle.h"
+#include "core/hud_draw.h"
 #include "handle/name_handle.h"
-#include "handle/page_handle.h"
+#include "hud_model.h"
 #include "image_path.h"
 #include "key_path.h"
 #include "setting/file_setting.h"
 #include "setting/mcm_setting.h"
-#include "util/constant.h"
+#include "util/memory_stats.h"
 #pragma warning(push)
 #pragma warning(disable : 4702)
 #define NANOSVG_IMPLEMENTATION
@@ -115,6 +115,11 @@ namespace ui {
         }
 
         ImGui_ImplDX11_NewFrame();
+        //the backend builds the atlas with the first frame, a custom font is part of it by then
+        if (static bool atlas_counted = false; !atlas_counted) {
+            atlas_counted = true;
+            count_font_atlas();
+        }
         ImGui_ImplWin32_NewFrame();
         ImGui::NewFrame();
 
@@ -181,6 +186,10 @@ namespace ui {
         srv_desc.Texture2D.MostDetailedMip = 0;
         forwarder->CreateShaderResourceView(p_texture, &srv_desc, out_srv);
         p_texture->Release();
+        if (*out_srv) {
+            util::memory_stats::add(util::memory_stats::subsystem::texture,
+                static_cast<size_t>(image_width) * static_cast<size_t>(image_height) * 4);
+        }
 
         free(image_data);
 
@@ -192,6 +201,14 @@ namespace ui {
 
     ui_renderer::ui_renderer() = default;
 
+    void ui_renderer::count_font_atlas() {
+        const auto* atlas = ImGui::GetIO().Fonts;
+        //uploaded as rgba, imgui keeps a copy of the pixels in memory as well
+        const auto size = static_cast<size_t>(atlas->TexWidth) * static_cast<size_t>(atlas->TexHeight) * 4;
+        util::memory_stats::set(util::memory_stats::subsystem::font_atlas, 1, size);
+        logger::info("font atlas is {}x{}, {}KB"sv, atlas->TexWidth, atlas->TexHeight, size / 1024);
+    }
+
     void ui_renderer::draw_animations_frame() {
         auto it = animation_list.begin();
         while (it != animation_list.end()) {
@@ -336,7 +353,7 @@ namespace ui {
             return;
         }
 
-        logger::trace("starting inited animation");
+        LOG_TRACE("starting inited animation");
         constexpr auto angle = 0.0f;
 
         const auto size = static_cast<uint32_t>(animation_frame_map[animation_type].size());
@@ -354,202 +371,93 @@ namespace ui {
                 a_duration,
                 size);
         animation_list.emplace_back(static_cast<ui::animation_type>(animation_type), std::move(anim));
-        logger::trace("done inited animation. return.");
+        LOG_TRACE("done inited animation. return.");
     }
 
-    void ui_renderer::draw_slots(const float a_x,
-        const float a_y,
-        const std::map<position_type, page_setting*>& a_settings) {
-        auto draw_page = mcm::get_draw_page_id();
-        auto elden = mcm::get_elden_demon_souls();
-        for (auto [position, page_setting] : a_settings) {
-            if (!page_setting) {
-                continue;
-            }
-            const auto* draw_setting = page_setting->draw_setting;
-            draw_slot(a_x,
+    //the core decides what gets drawn where, this only puts it on screen
+    class ui_renderer::imgui_target final : public core::render_target {
+    public:
+        void draw_slot(const float a_x,
+            const float a_y,
+            const float a_scale_x,
+            const float a_scale_y,
+            const float a_offset_x,
+            const float a_offset_y,
+            const uint32_t a_modify,
+            const uint32_t a_alpha) override {
+            ui_renderer::draw_slot(a_x, a_y, a_scale_x, a_scale_y, a_offset_x, a_offset_y, a_modify, a_alpha);
+        }
+
+        void draw_icon(const float a_x,
+            const float a_y,
+            const float a_scale_x,
+            const float a_scale_y,
+            const float a_offset_x,
+            const float a_offset_y,
+            const uint32_t a_icon_type,
+            const uint32_t a_alpha) override {
+            ui_renderer::draw_icon(a_x,
                 a_y,
-                draw_setting->hud_image_scale_width,
-                draw_setting->hud_image_scale_height,
-                draw_setting->offset_slot_x,
-                draw_setting->offset_slot_y,
-                page_setting->button_press_modify,
-                draw_setting->background_icon_transparency);
-            draw_icon(a_x,
+                a_scale_x,
+                a_scale_y,
+                a_offset_x,
+                a_offset_y,
+                static_cast<icon_image_type>(a_icon_type),
+                a_alpha);
+        }
+
+        void draw_text(const float a_x,
+            const float a_y,
+            const float a_offset_x,
+            const float a_offset_y,
+            const float a_offset_extra_x,
+            const float a_offset_extra_y,
+            const char* a_text,
+            const uint32_t a_alpha,
+            const uint32_t a_red,
+            const uint32_t a_green,
+            const uint32_t a_blue,
+            const float a_font_size,
+            const bool a_center_text,
+            const bool a_deduct_text_x,
+            const bool a_deduct_text_y,
+            const bool a_add_text_x,
+            const bool a_add_text_y) override {
+            ui_renderer::draw_text(a_x,
                 a_y,
-                page_setting->draw_setting->icon_scale_width,
-                page_setting->draw_setting->icon_scale_height,
-                draw_setting->offset_slot_x,
-                draw_setting->offset_slot_y,
-                page_setting->icon_type,
-                draw_setting->icon_transparency);
-            if (page_setting->highlight_slot) {
-                page_setting->highlight_slot = false;
-                init_animation(animation_type::highlight,
-                    a_x,
-                    a_y,
-                    draw_setting->hud_image_scale_width,
-                    draw_setting->hud_image_scale_height,
-                    draw_setting->offset_slot_x,
-                    draw_setting->offset_slot_y,
-                    draw_full,
-                    draw_setting->alpha_slot_animation,
-                    draw_setting->duration_slot_animation);
-            }
-
-            if (page_setting->item_name && !page_setting->slot_settings.empty()) {
-                auto* slot_setting = page_setting->slot_settings.front();
-                auto slot_name = "";
-                if (slot_setting && slot_setting->form) {
-                    slot_name = page_setting->slot_settings.front()->form->GetName();
-                } else if (slot_setting && slot_setting->actor_value != RE::ActorValue::kNone &&
-                           slot_setting->type == slot_type::consumable &&
-                           util::actor_value_to_base_potion_map_.contains(slot_setting->actor_value)) {
-                    auto* potion_form =
-                        RE::TESForm::LookupByID(util::actor_value_to_base_potion_map_[slot_setting->actor_value]);
-                    if (potion_form->Is(RE::FormType::AlchemyItem)) {
-                        slot_name = potion_form->GetName();
-                    }
-                }
-
-                if (slot_name) {
-                    auto center_text = (page_setting->position == position_type::top ||
-                                        page_setting->position == position_type::bottom);
-                    auto deduct_text_x = page_setting->position == position_type::left;
-                    auto deduct_text_y = page_setting->position == position_type::bottom;
-                    auto add_text_x = false;
-                    auto add_text_y = page_setting->position == position_type::top;
-                    draw_text(draw_setting->width_setting,
-                        draw_setting->height_setting,
-                        draw_setting->offset_slot_x,
-                        draw_setting->offset_slot_y,
-                        draw_setting->offset_name_text_x,
-                        draw_setting->offset_name_text_y,
-                        slot_name,
-                        draw_setting->slot_item_name_transparency,
-                        draw_setting->slot_item_red,
-                        draw_setting->slot_item_green,
-                        draw_setting->slot_item_blue,
-                        page_setting->item_name_font_size,
-                        center_text,
-                        deduct_text_x,
-                        deduct_text_y,
-                        add_text_x,
-                        add_text_y);
-                }
-            }
-
-            if (auto slot_settings = page_setting->slot_settings; !slot_settings.empty()) {
-                const auto first_type = slot_settings.front()->type;
-                std::string slot_text;
-                switch (first_type) {
-                    case slot_type::scroll:
-                    case slot_type::consumable:
-                        if (slot_settings.front()->display_item_count) {
-                            slot_text = std::to_string(slot_settings.front()->item_count);
-                        }
-                        break;
-                    case slot_type::shout:
-                    case slot_type::power:
-                        slot_text =
-                            slot_settings.front()->action == handle::slot_setting::action_type::instant ? "I" : "E";
-                        break;
-                    case slot_type::magic:
-                        if ((position == position_type::top && elden) || !elden) {
-                            slot_text =
-                                slot_settings.front()->action == handle::slot_setting::action_type::instant ? "I" : "E";
-                        } else if (draw_page) {
-                            slot_text = std::to_string(page_setting->page);
-                        }
-                        break;
-                    case slot_type::weapon:
-                    case slot_type::shield:
-                    case slot_type::light:
-                        if (draw_page) {
-                            slot_text = std::to_string(page_setting->page);
-                        }
-                        break;
-                    case slot_type::armor:
-                    case slot_type::empty:
-                    case slot_type::misc:
-                    case slot_type::lantern:
-                    case slot_type::mask:
-                        //Nothing, for now
-                        break;
-                }
-
-                if (draw_page && elden && position == position_type::left && slot_settings.size() == 2) {
-                    const auto second_type = slot_settings[1]->type;
-                    switch (second_type) {
-                        case slot_type::magic:
-                        case slot_type::weapon:
-                        case slot_type::shield:
-                        case slot_type::light:
-                            slot_text = std::to_string(page_setting->page);
-                            break;
-                        case slot_type::scroll:
-                        case slot_type::consumable:
-                        case slot_type::shout:
-                        case slot_type::power:
-                        case slot_type::armor:
-                        case slot_type::empty:
-                        case slot_type::misc:
-                        case slot_type::lantern:
-                        case slot_type::mask:
-                            //Nothing, for now
-                            break;
-                    }
-                }
+                a_offset_x,
+                a_offset_y,
+                a_offset_extra_x,
+                a_offset_extra_y,
+                a_text,
+                a_alpha,
+                a_red,
+                a_green,
+                a_blue,
+                a_font_size,
+                a_center_text,
+                a_deduct_text_x,
+                a_deduct_text_y,
+                a_add_text_x,
+                a_add_text_y);
+        }
+    };
+
+    void ui_renderer::draw_slots(const float a_x, const float a_y, const hud_snapshot& a_snapshot) {
+        imgui_target target;
+        core::draw_slots(a_x, a_y, a_snapshot, target);
+        draw_highlights(a_x, a_y, a_snapshot);
+        draw_animations_frame();
+    }
 
-                if (!slot_text.empty()) {
-                    draw_text(draw_setting->width_setting,
-                        draw_setting->height_setting,
-                        draw_setting->offset_slot_x,
-                        draw_setting->offset_slot_y,
-                        draw_setting->offset_text_x,
-                        draw_setting->offset_text_y,
-                        slot_text.c_str(),
-                        draw_setting->slot_count_transparency,
-                        draw_setting->slot_count_red,
-                        draw_setting->slot_count_green,
-                        draw_setting->slot_count_blue,
-                        page_setting->count_font_size);
+    void ui_renderer::draw_highlights(const float a_x, const float a_y, const hud_snapshot& a_snapshot) {
+        const auto* model = hud_model::get_singleton();
+        auto highlight = position_type::total;
+        while (model->pop_highlight(highlight)) {
+            if (highlight == position_type::total) {
+                if (!a_snapshot.ammo) {
+                    continue;
                 }
-            }
-        }
-        const auto* ammo_handle = handle::ammo_handle::get_singleton();
-        if (auto* current_ammo = ammo_handle->get_current(); current_ammo && mcm::get_elden_demon_souls()) {
-            draw_slot(a_x,
-                a_y,
-                mcm::get_hud_arrow_image_scale_width(),
-                mcm::get_hud_arrow_image_scale_height(),
-                mcm::get_arrow_slot_offset_x(),
-                mcm::get_arrow_slot_offset_y(),
-                current_ammo->button_press_modify,
-                mcm::get_background_icon_transparency());
-            draw_icon(a_x,
-                a_y,
-                mcm::get_arrow_icon_scale_width(),
-                mcm::get_arrow_icon_scale_height(),
-                mcm::get_arrow_slot_offset_x(),
-                mcm::get_arrow_slot_offset_y(),
-                icon_image_type::arrow,
-                mcm::get_icon_transparency());
-            draw_text(a_x,
-                a_y,
-                mcm::get_arrow_slot_offset_x(),
-                mcm::get_arrow_slot_offset_y(),
-                mcm::get_arrow_slot_count_text_offset(),
-                mcm::get_arrow_slot_count_text_offset(),
-                std::to_string(current_ammo->item_count ? current_ammo->item_count : 0).c_str(),
-                mcm::get_slot_count_transparency(),
-                mcm::get_slot_count_red(),
-                mcm::get_slot_count_green(),
-                mcm::get_slot_count_blue(),
-                mcm::get_arrow_count_font_size());
-
-            if (current_ammo->highlight_slot) {
-                current_ammo->highlight_slot = false;
                 init_animation(animation_type::highlight,
                     a_x,
                     a_y,
@@ -560,9 +468,25 @@ namespace ui {
                     draw_full,
                     mcm::get_alpha_slot_animation(),
                     mcm::get_duration_slot_animation());
+                continue;
+            }
+
+            const auto position = std::ranges::find(a_snapshot.positions, highlight, &hud_position_snapshot::position);
+            if (position == a_snapshot.positions.end()) {
+                continue;
             }
+            const auto& draw_setting = position->draw_setting;
+            init_animation(animation_type::highlight,
+                a_x,
+                a_y,
+                draw_setting.hud_image_scale_width,
+                draw_setting.hud_image_scale_height,
+                draw_setting.offset_slot_x,
+                draw_setting.offset_slot_y,
+                draw_full,
+                draw_setting.alpha_slot_animation,
+                draw_setting.duration_slot_animation);
         }
-        draw_animations_frame();
     }
 
     void ui_renderer::draw_key(const float a_x,
@@ -586,30 +510,25 @@ namespace ui {
         draw_element(texture, center, size, angle, color);
     }
 
-    void ui_renderer::draw_keys(const float a_x,
-        const float a_y,
-        const std::map<position_type, page_setting*>& a_settings) {
-        for (auto [position, page_setting] : a_settings) {
-            if (!page_setting) {
-                continue;
-            }
-            const auto* draw_setting = page_setting->draw_setting;
+    void ui_renderer::draw_keys(const float a_x, const float a_y, const hud_snapshot& a_snapshot) {
+        for (const auto& position : a_snapshot.positions) {
+            const auto& draw_setting = position.draw_setting;
             if (config::file_setting::get_draw_key_background()) {
                 draw_key(a_x,
                     a_y,
-                    draw_setting->key_icon_scale_width,
-                    draw_setting->key_icon_scale_height,
-                    draw_setting->offset_key_x,
-                    draw_setting->offset_key_y);
+                    draw_setting.key_icon_scale_width,
+                    draw_setting.key_icon_scale_height,
+                    draw_setting.offset_key_x,
+                    draw_setting.offset_key_y);
             }
             draw_key_icon(a_x,
                 a_y,
-                draw_setting->key_icon_scale_width,
-                draw_setting->key_icon_scale_height,
-                draw_setting->offset_key_x,
-                draw_setting->offset_key_y,
-                page_setting->key,
-                draw_setting->key_transparency);
+                draw_setting.key_icon_scale_width,
+                draw_setting.key_icon_scale_height,
+                draw_setting.offset_key_x,
+                draw_setting.offset_key_y,
+                position.key,
+                draw_setting.key_transparency);
         }
 
         if (mcm::get_draw_toggle_button()) {
@@ -712,7 +631,7 @@ namespace ui {
 
         ImGui::Begin(hud_name, nullptr, window_flag);
 
-        if (const auto settings = handle::page_handle::get_singleton()->get_active_page(); !settings.empty()) {
+        if (const auto& snapshot = hud_model::get_singleton()->get_snapshot(); !snapshot.positions.empty()) {
             auto x = mcm::get_hud_image_position_width();
             auto y = mcm::get_hud_image_position_height();
             const auto scale_x = mcm::get_hud_image_scale_width();
@@ -724,8 +643,8 @@ namespace ui {
             }
 
             draw_hud(x, y, scale_x, scale_y, alpha);
-            draw_slots(x, y, settings);
-            draw_keys(x, y, settings);
+            draw_slots(x, y, snapshot);
+            draw_keys(x, y, snapshot);
             if (mcm::get_draw_current_items_text() || mcm::get_draw_current_shout_text()) {
                 if (mcm::get_draw_current_items_text()) {
                     draw_text(x,
@@ -796,7 +715,7 @@ namespace ui {
                         &a_struct[index].texture,
                         a_struct[index].width,
                         a_struct[index].height)) {
-                    logger::trace("loading texture {}, type: {}, width: {}, height: {}"sv,
+                    LOG_TRACE("loading texture {}, type: {}, width: {}, height: {}"sv,
                         entry.path().filename().string().c_str(),
                         entry.path().filename().extension().string().c_str(),
                         a_struct[index].width,
@@ -824,7 +743,7 @@ namespace ui {
 
             load_texture_from_file(entry.path().string().c_str(), &texture, width, height);
 
-            logger::trace("loading animation frame: {}"sv, entry.path().string().c_str());
+            LOG_TRACE("loading animation frame: {}"sv, entry.path().string().c_str());
             image img;
             img.texture = texture;
             img.width = static_cast<int32_t>(width * get_resolution_scale_width());
@@ -870,7 +789,7 @@ namespace ui {
     void ui_renderer::load_font() {
         std::string path = R"(Data\SKSE\Plugins\resources\font\)" + config::file_setting::get_font_file_name();
         auto file_path = std::filesystem::path(path);
-        logger::trace("Need to load font {} from file {}"sv, config::file_setting::get_font_load(), path);
+        LOG_TRACE("Need to load font {} from file {}"sv, config::file_setting::get_font_load(), path);
         tried_font_load = true;
         if (config::file_setting::get_font_load() && std::filesystem::is_regular_file(file_path) &&
             ((file_path.extension() == ".ttf") || (file_path.extension() == ".otf"))) {
@@ -920,7 +839,7 @@ namespace ui {
             show_ui_ = true;
         }
         config::file_setting::set_show_ui(show_ui_);
-        logger::trace("Show UI is now {}"sv, show_ui_);
+        LOG_TRACE("Show UI is now {}"sv, show_ui_);
     }
 
     void ui_renderer::set_show_ui(bool a_show) { show_ui_ = a_show; }
@@ -934,6 +853,6 @@ namespace ui {
         load_images(gamepad_xbox_icon_name_map, xbox_key_struct, key_directory);
 
         load_animation_frames(highlight_animation_directory, animation_frame_map[animation_type::highlight]);
-        logger::trace("frame length is {}"sv, animation_frame_map[animation_type::highlight].size());
+        LOG_TRACE("frame length is {}"sv, animation_frame_map[animation_type::highlight].size());
     }
 }
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "animation_handler.h"
 #include "handle/data/page/position_setting.h"
+#include "hud_model.h"
 #include "image_path.h"
 
 namespace ui {
@@ -11,10 +12,10 @@ namespace ui {
     };
 
     class ui_renderer {
-        using page_setting = handle::position_setting;
-        using slot_type = handle::slot_setting::slot_type;
         using position_type = handle::position_setting::position_type;
 
+        class imgui_target;
+
         struct wnd_proc_hook {
             static LRESULT thunk(HWND h_wnd, UINT u_msg, WPARAM w_param, LPARAM l_param);
             static inline WNDPROC func;
@@ -64,7 +65,8 @@ namespace ui {
             uint32_t a_modify,
             uint32_t a_alpha,
             float a_duration);
-        static void draw_slots(float a_x, float a_y, const std::map<position_type, page_setting*>& a_settings);
+        static void draw_slots(float a_x, float a_y, const hud_snapshot& a_snapshot);
+        static void draw_highlights(float a_x, float a_y, const hud_snapshot& a_snapshot);
         static void draw_key(float a_x,
             float a_y,
             float a_scale_x,
@@ -72,7 +74,7 @@ namespace ui {
             float a_offset_x,
             float a_offset_y,
             uint32_t a_alpha = 255);
-        static void draw_keys(float a_x, float a_y, const std::map<position_type, page_setting*>& a_settings);
+        static void draw_keys(float a_x, float a_y, const hud_snapshot& a_snapshot);
         static void draw_icon(float a_x,
             float a_y,
             float a_scale_x,
@@ -108,6 +110,7 @@ namespace ui {
 
         static image get_key_icon(uint32_t a_key);
         static void load_font();
+        static void count_font_atlas();
 
     public:
         static float get_resolution_scale_width();
@@ -0,0 +1,224 @@
+#include "form_cache.h"
+#include "string_util.h"
+
+namespace util {
+    //same order as keyword_type
+    static constexpr std::array<std::string_view, static_cast<size_t>(form_cache::keyword_type::total)>
+        keyword_names = { "WeapTypeRapier",
+            "WeapTypeKatana",
+            "WeapTypeClaw",
+            "WeapTypeWhip",
+            "WeapTypePike",
+            "WeapTypeHalberd",
+            "WeapTypeQtrStaff",
+            "_WL_Lantern",
+            "BOS_DisplayMaskKeyword" };
+
+    form_cache* form_cache::get_singleton() {
+        static form_cache singleton;
+        return std::addressof(singleton);
+    }
+
+    void form_cache::init_keywords() {
+        if (!this->data_) {
+            this->data_ = new form_cache_data();
+        }
+        form_cache_data* data = this->data_;
+
+        std::scoped_lock lock(data->lock);
+        for (auto i = 0; i < static_cast<int>(keyword_names.size()); ++i) {
+            //mods that add them might not be there, nullptr is never found then
+            data->keywords[i] = RE::TESForm::LookupByEditorID<RE::BGSKeyword>(keyword_names[i]);
+            LOG_TRACE("keyword {} is {}"sv,
+                keyword_names[i],
+                data->keywords[i] ? string_util::int_to_hex(data->keywords[i]->GetFormID()) : "not loaded");
+        }
+        data->keywords_resolved = true;
+        data->forms.clear();
+    }
+
+    void form_cache::reset() const {
+        if (!this->data_) {
+            return;
+        }
+        form_cache_data* data = this->data_;
+
+        std::scoped_lock lock(data->lock);
+        LOG_TRACE("dropping {} cached forms"sv, data->forms.size());
+        data->forms.clear();
+    }
+
+    form_cache::form_info form_cache::get(RE::TESForm* a_form) {
+        if (!a_form) {
+            return {};
+        }
+        if (!this->data_) {
+            this->data_ = new form_cache_data();
+        }
+        form_cache_data* data = this->data_;
+
+        {
+            std::scoped_lock lock(data->lock);
+            if (const auto it = data->forms.find(a_form->GetFormID()); it != data->forms.end()) {
+                return it->second;
+            }
+        }
+
+        //worked out without the lock, at worst two threads do it both and store the same
+        const auto info = classify(a_form);
+        std::scoped_lock lock(data->lock);
+        return data->forms.try_emplace(a_form->GetFormID(), info).first->second;
+    }
+
+    std::optional<form_cache::icon_type> form_cache::get_icon(const RE::TESForm* a_form, const slot_type a_type) {
+        if (!a_form) {
+            return std::nullopt;
+        }
+        //makes sure there is an entry to store the icon in later
+        get(const_cast<RE::TESForm*>(a_form));
+        form_cache_data* data = this->data_;
+
+        std::scoped_lock lock(data->lock);
+        if (const auto it = data->forms.find(a_form->GetFormID());
+            it != data->forms.end() && it->second.has_icon && it->second.icon_slot_type == a_type) {
+            return it->second.icon;
+        }
+        return std::nullopt;
+    }
+
+    void form_cache::set_icon(const RE::TESForm* a_form, const slot_type a_type, const icon_type a_icon) const {
+        if (!a_form || !this->data_) {
+            return;
+        }
+        form_cache_data* data = this->data_;
+
+        std::scoped_lock lock(data->lock);
+        if (const auto it = data->forms.find(a_form->GetFormID()); it != data->forms.end()) {
+            it->second.has_icon = true;
+            it->second.icon_slot_type = a_type;
+            it->second.icon = a_icon;
+        }
+    }
+
+    bool form_cache::has_keyword(const RE::BGSKeywordForm* a_keyword_form, const keyword_type a_keyword) {
+        if (!a_keyword_form || a_keyword == keyword_type::total) {
+            return false;
+        }
+        if (!this->data_ || !this->data_->keywords_resolved) {
+            init_keywords();
+        }
+
+        const auto* keyword = this->data_->keywords[static_cast<size_t>(a_keyword)];
+        return keyword && a_keyword_form->HasKeyword(keyword);
+    }
+
+    form_cache::form_info form_cache::classify(RE::TESForm* a_form) {
+        form_info info;
+        info.type = get_type(a_form);
+        info.two_handed = is_two_handed(a_form);
+        get_potion_effect(a_form, info);
+        LOG_TRACE("classified form {}, type {}, two handed {}, potion actor value {}"sv,
+            string_util::int_to_hex(a_form->GetFormID()),
+            static_cast<uint32_t>(info.type),
+            info.two_handed,
+            static_cast<int>(info.potion_actor_value));
+        return info;
+    }
+
+    bool form_cache::is_two_handed(RE::TESForm* a_form) {
+        auto two_handed = false;
+        if (a_form->Is(RE::FormType::Spell)) {
+            if (const auto* spell = a_form->As<RE::SpellItem>(); spell->IsTwoHanded()) {
+                two_handed = true;
+            }
+        } else if (a_form->IsWeapon()) {
+            if (const auto* weapon = a_form->As<RE::TESObjectWEAP>();
+                weapon->IsTwoHandedAxe() || weapon->IsTwoHandedSword() || weapon->IsBow() || weapon->IsCrossbow()) {
+                two_handed = true;
+            }
+        }
+        return two_handed;
+    }
+
+    form_cache::slot_type form_cache::get_type(RE::TESForm* a_form) {
+        if (a_form->IsWeapon()) {
+            if (const auto* weapon = a_form->As<RE::TESObjectWEAP>(); !weapon->IsBound()) {
+                return slot_type::weapon;
+            }
+        }
+
+        if (a_form->IsArmor()) {
+            const auto* armor = a_form->As<RE::TESObjectARMO>();
+            //GetSlotMask 49
+            if (armor->IsShield()) {
+                return slot_type::shield;
+            } else if (armor->IsClothing() &&
+                       (has_keyword(armor, keyword_type::lantern) &&
+                               armor->HasPartOf(RE::BIPED_MODEL::BipedObjectSlot::kNone) &&
+                               !armor->HasPartOf(RE::BIPED_MODEL::BipedObjectSlot::kModFaceJewelry) ||
+                           armor->HasPartOf(RE::BIPED_MODEL::BipedObjectSlot::kModPelvisPrimary))) {
+                //Wearable Lanterns got keyword _WL_Lantern
+                //Simple Wearable Lanterns do not have a keyword, but will be equipped on 49 (30+19)
+                return slot_type::lantern;
+            } else if (armor->IsClothing() && has_keyword(armor, keyword_type::mask)) {
+                return slot_type::mask;
+            }
+            return slot_type::armor;
+        }
+
+        if (a_form->Is(RE::FormType::Spell)) {
+            const auto spell_type = a_form->As<RE::SpellItem>()->GetSpellType();
+            if (spell_type == RE::MagicSystem::SpellType::kSpell ||
+                spell_type == RE::MagicSystem::SpellType::kLeveledSpell) {
+                return slot_type::magic;
+            }
+            if (spell_type == RE::MagicSystem::SpellType::kLesserPower ||
+                spell_type == RE::MagicSystem::SpellType::kPower) {
+                return slot_type::power;
+            }
+        }
+
+        if (a_form->Is(RE::FormType::Shout)) {
+            return slot_type::shout;
+        }
+
+        if (a_form->Is(RE::FormType::AlchemyItem)) {
+            return slot_type::consumable;
+        }
+
+        if (a_form->Is(RE::FormType::Scroll)) {
+            return slot_type::scroll;
+        }
+
+        if (a_form->Is(RE::FormType::Ammo)) {
+            return slot_type::misc;
+        }
+
+        if (a_form->Is(RE::FormType::Light)) {
+            return slot_type::light;
+        }
+
+        return slot_type::misc;
+    }
+
+    void form_cache::get_potion_effect(RE::TESForm* a_form, form_info& a_info) {
+        if (!a_form->Is(RE::FormType::AlchemyItem)) {
+            return;
+        }
+
+        auto* alchemy_potion = a_form->As<RE::AlchemyItem>();
+        if (alchemy_potion->IsFood() || alchemy_potion->IsPoison()) {
+            return;
+        }
+
+        const auto* effect = alchemy_potion->GetCostliestEffectItem()->baseEffect;
+        auto actor_value = effect->GetMagickSkill();
+        if (actor_value == RE::ActorValue::kNone) {
+            actor_value = effect->data.primaryAV;
+        }
+        a_info.potion_actor_value = actor_value;
+        a_info.potion_groupable = (actor_value == RE::ActorValue::kHealth || actor_value == RE::ActorValue::kStamina ||
+                                      actor_value == RE::ActorValue::kMagicka) &&
+                                  effect->data.flags.none(RE::EffectSetting::EffectSettingData::Flag::kRecover);
+    }
+}
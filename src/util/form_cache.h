@@ -0,0 +1,72 @@
+#pragma once
+#include "handle/data/page/slot_setting.h"
+#include "ui/image_path.h"
+
+namespace util {
+    //what the hud wants to know about a form does not change while a game is running, so it is worked out once per
+    //form id. keywords are looked up once after the data is loaded and compared by pointer
+    class form_cache {
+    public:
+        using slot_type = handle::slot_setting::slot_type;
+        using icon_type = ui::icon_image_type;
+
+        enum class keyword_type : std::uint32_t {
+            rapier = 0,
+            katana = 1,
+            claw = 2,
+            whip = 3,
+            pike = 4,
+            halberd = 5,
+            quarter_staff = 6,
+            lantern = 7,
+            mask = 8,
+            total = 9
+        };
+
+        struct form_info {
+            slot_type type = slot_type::empty;
+            bool two_handed = false;
+            //effect of the costliest effect, none for anything but potions
+            RE::ActorValue potion_actor_value = RE::ActorValue::kNone;
+            //health, stamina or magicka that is not over time, those get grouped
+            bool potion_groupable = false;
+            //the icon depends on the type of the slot, it is kept for the type it was asked for
+            bool has_icon = false;
+            slot_type icon_slot_type = slot_type::empty;
+            icon_type icon = icon_type::icon_default;
+        };
+
+        static form_cache* get_singleton();
+        void init_keywords();
+        //forms with a dynamic id get reused for other things in the next game
+        void reset() const;
+        form_info get(RE::TESForm* a_form);
+        std::optional<icon_type> get_icon(const RE::TESForm* a_form, slot_type a_type);
+        void set_icon(const RE::TESForm* a_form, slot_type a_type, icon_type a_icon) const;
+        bool has_keyword(const RE::BGSKeywordForm* a_keyword_form, keyword_type a_keyword);
+
+        form_cache(const form_cache&) = delete;
+        form_cache(form_cache&&) = delete;
+
+        form_cache& operator=(const form_cache&) const = delete;
+        form_cache& operator=(form_cache&&) const = delete;
+
+    private:
+        form_cache() : data_(nullptr) {}
+        ~form_cache() = default;
+
+        form_info classify(RE::TESForm* a_form);
+        static bool is_two_handed(RE::TESForm* a_form);
+        slot_type get_type(RE::TESForm* a_form);
+        static void get_potion_effect(RE::TESForm* a_form, form_info& a_info);
+
+        struct form_cache_data {
+            std::mutex lock;
+            bool keywords_resolved = false;
+            std::array<RE::BGSKeyword*, static_cast<size_t>(keyword_type::total)> keywords{};
+            std::unordered_map<RE::FormID, form_info> forms;
+        };
+
+        form_cache_data* data_;
+    };
+}
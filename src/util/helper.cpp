@@ -1,10 +1,12 @@
 ﻿#include "helper.h"
 #include "constant.h"
-#include "data/config_writer_helper.h"
 #include "equip/equip_slot.h"
+#include "form_cache.h"
 #include "handle/data/page/position_setting.h"
+#include "page_key.h"
 #include "setting/custom_setting.h"
 #include "setting/mcm_setting.h"
+#include "setting/setting_watcher.h"
 #include "string_util.h"
 #include "util/player/player.h"
 
@@ -16,7 +18,7 @@ namespace util {
         }
 
         const auto* form = RE::TESForm::LookupByID(a_form_id);
-        logger::trace("Item is {}, formid {}, formid not translated {}. return."sv,
+        LOG_TRACE("Item is {}, formid {}, formid not translated {}. return."sv,
             form->GetName(),
             string_util::int_to_hex(form->GetFormID()),
             form->GetFormID());
@@ -28,7 +30,7 @@ namespace util {
             auto* source_file = form->sourceFiles.array->front()->fileName;
             auto local_form = form->GetLocalFormID();
 
-            logger::trace("form is from {}, local id is {}, translated {}"sv,
+            LOG_TRACE("form is from {}, local id is {}, translated {}"sv,
                 source_file,
                 local_form,
                 string_util::int_to_hex(local_form));
@@ -42,6 +44,7 @@ namespace util {
     std::vector<std::string> helper::get_configured_section_page_names(uint32_t a_position) {
         //4 is all
         std::vector<std::string> names;
+        const auto lock = config::custom_setting::lock_setting();
         for (const auto entries = config::custom_setting::get_sections(); const auto& entry : entries) {
             if (a_position == static_cast<uint32_t>(handle::position_setting::position_type::total)) {
                 names.emplace_back(entry.pItem);
@@ -52,7 +55,7 @@ namespace util {
                 }
             }
         }
-        logger::trace("got {} sections, for position {}"sv, names.size(), a_position);
+        LOG_TRACE("got {} sections, for position {}"sv, names.size(), a_position);
         return names;
     }
 
@@ -77,14 +80,14 @@ namespace util {
         if (plugin == dynamic_name) {
             form = RE::TESForm::LookupByID(form_id);
         } else {
-            logger::trace("checking mod {} for form {}"sv, plugin, form_id);
+            LOG_TRACE("checking mod {} for form {}"sv, plugin, form_id);
 
             const auto data_handler = RE::TESDataHandler::GetSingleton();
             form = data_handler->LookupForm(form_id, plugin);
         }
 
         if (form != nullptr) {
-            logger::trace("got form id {}, name {}", string_util::int_to_hex(form->GetFormID()), form->GetName());
+            LOG_TRACE("got form id {}, name {}", string_util::int_to_hex(form->GetFormID()), form->GetName());
         }
 
         return form;
@@ -95,174 +98,31 @@ namespace util {
             logger::warn("return false, form is null."sv);
             return false;
         }
-
-        auto two_handed = false;
-        if (a_form->Is(RE::FormType::Spell)) {
-            if (const auto* spell = a_form->As<RE::SpellItem>(); spell->IsTwoHanded()) {
-                two_handed = true;
-            }
-        } else if (a_form->IsWeapon()) {
-            if (const auto* weapon = a_form->As<RE::TESObjectWEAP>();
-                weapon->IsTwoHandedAxe() || weapon->IsTwoHandedSword() || weapon->IsBow() || weapon->IsCrossbow()) {
-                two_handed = true;
-            }
-        }
-
-        //logger::trace("form {}, two handed {}"sv, a_form->GetName(), two_handed);
-        return two_handed;
+        return form_cache::get_singleton()->get(a_form).two_handed;
     }
 
     handle::slot_setting::slot_type helper::get_type(RE::TESForm*& a_form) {
-        if (!a_form) {
-            return slot_type::empty;
-        }
-
-        if (a_form->IsWeapon()) {
-            if (const auto* weapon = a_form->As<RE::TESObjectWEAP>(); !weapon->IsBound()) {
-                return slot_type::weapon;
-            }
-        }
-
-        if (a_form->IsArmor()) {
-            const auto* armor = a_form->As<RE::TESObjectARMO>();
-            //GetSlotMask 49
-            if (armor->IsShield()) {
-                return slot_type::shield;
-            } else if (armor->IsClothing() &&
-                       (armor->HasKeywordString("_WL_Lantern") &&
-                               armor->HasPartOf(RE::BIPED_MODEL::BipedObjectSlot::kNone) &&
-                               !armor->HasPartOf(RE::BIPED_MODEL::BipedObjectSlot::kModFaceJewelry) ||
-                           armor->HasPartOf(RE::BIPED_MODEL::BipedObjectSlot::kModPelvisPrimary))) {
-                //Wearable Lanterns got keyword _WL_Lantern
-                //Simple Wearable Lanterns do not have a keyword, but will be equipped on 49 (30+19)
-                return slot_type::lantern;
-            } else if (armor->IsClothing() && armor->HasKeywordString("BOS_DisplayMaskKeyword")) {
-                return slot_type::mask;
-            }
-            return slot_type::armor;
-        }
-
-        if (a_form->Is(RE::FormType::Spell)) {
-            const auto spell_type = a_form->As<RE::SpellItem>()->GetSpellType();
-            if (spell_type == RE::MagicSystem::SpellType::kSpell ||
-                spell_type == RE::MagicSystem::SpellType::kLeveledSpell) {
-                return slot_type::magic;
-            }
-            if (spell_type == RE::MagicSystem::SpellType::kLesserPower ||
-                spell_type == RE::MagicSystem::SpellType::kPower) {
-                return slot_type::power;
-            }
-        }
-
-        if (a_form->Is(RE::FormType::Shout)) {
-            return slot_type::shout;
-        }
-
-        if (a_form->Is(RE::FormType::AlchemyItem)) {
-            return slot_type::consumable;
-        }
-
-        if (a_form->Is(RE::FormType::Scroll)) {
-            return slot_type::scroll;
-        }
-
-        if (a_form->Is(RE::FormType::Ammo)) {
-            return slot_type::misc;
-        }
-
-        if (a_form->Is(RE::FormType::Light)) {
-            return slot_type::light;
-        }
-
-        return slot_type::misc;
+        return form_cache::get_singleton()->get(a_form).type;
     }
 
     void helper::rewrite_settings() {
-        logger::trace("rewriting config ..."sv);
-        std::map<uint32_t, uint32_t> next_page_for_position;
-
-        for (auto i = 0; i < static_cast<int>(handle::position_setting::position_type::total); ++i) {
-            next_page_for_position[i] = 0;
-        }
-        std::vector<config_writer_helper*> configs;
-        const auto sections = get_configured_section_page_names();
-        logger::trace("got {} sections, rewrite that they are in consecutive pages"sv, sections.size());
-        for (const auto& section : sections) {
-            auto position = config::custom_setting::get_position_by_section(section);
-            const auto next_page = next_page_for_position[position];
-
-            auto* config = new config_writer_helper();
-            config->section = section;
-            config->page = next_page;
-            config->position = position;
-            config->form = config::custom_setting::get_item_form_by_section(section);
-            config->type = config::custom_setting::get_type_by_section(section);
-            config->hand = config::custom_setting::get_hand_selection_by_section(section);
-            config->action = config::custom_setting::get_slot_action_by_section(section);
-            config->form_left = config::custom_setting::get_item_form_left_by_section(section);
-            config->type_left = config::custom_setting::get_type_left_by_section(section);
-            config->action_left = config::custom_setting::get_slot_action_left_by_section(section);
-            config->actor_value = config::custom_setting::get_effect_actor_value(section);
-
-            configs.push_back(config);
-            next_page_for_position[position] = next_page + 1;
-        }
-
-        logger::trace("start writing config, got {} items"sv, configs.size());
-
-        for (const auto config : configs) {
-            config::custom_setting::reset_section(config->section);
-            const auto section = get_section_name_for_page_position(config->page, config->position);
-
-            config::custom_setting::write_section_setting(section,
-                config->page,
-                config->position,
-                config->type,
-                config->form,
-                config->action,
-                config->hand,
-                config->type_left,
-                config->form_left,
-                config->action_left,
-                config->actor_value);
-        }
-
-        next_page_for_position.clear();
-        configs.clear();
-        logger::trace("done rewriting."sv);
-    }
-
-    std::string helper::get_section_name_for_page_position(const uint32_t a_page, const uint32_t a_position) {
-        //for now, I will just generate it
-        return fmt::format("Page{}Position{}", a_page, a_position);
+        LOG_TRACE("rewriting config ..."sv);
+        //the core parser renumbers the pages, the file is written once instead of once per section
+        const auto path = config::custom_setting::get_file_path();
+        config::custom_setting::load_setting(config::custom_setting::parse_setting(path, true));
+        config::setting_watcher::get_singleton()->sync(config::setting_watcher::watched_file::custom);
+        LOG_TRACE("done rewriting."sv);
     }
 
     RE::ActorValue helper::get_actor_value_effect_from_potion(RE::TESForm* a_form, bool a_check) {
-        if (!a_form->Is(RE::FormType::AlchemyItem) || (!config::mcm_setting::get_group_potions() && a_check)) {
-            return RE::ActorValue::kNone;
-        }
-
-        auto* alchemy_potion = a_form->As<RE::AlchemyItem>();
-        if (alchemy_potion->IsFood() || alchemy_potion->IsPoison()) {
+        if (!a_form || (!config::mcm_setting::get_group_potions() && a_check)) {
             return RE::ActorValue::kNone;
         }
 
-        const auto* effect = alchemy_potion->GetCostliestEffectItem()->baseEffect;
-        auto actor_value = effect->GetMagickSkill();
-        if (actor_value == RE::ActorValue::kNone) {
-            actor_value = effect->data.primaryAV;
+        const auto info = form_cache::get_singleton()->get(a_form);
+        if (!a_check || info.potion_groupable) {
+            return info.potion_actor_value;
         }
-
-        if (!a_check) {
-            return actor_value;
-        }
-
-        if ((actor_value == RE::ActorValue::kHealth || actor_value == RE::ActorValue::kStamina ||
-                actor_value == RE::ActorValue::kMagicka) &&
-            effect->data.flags.none(RE::EffectSetting::EffectSettingData::Flag::kRecover)) {
-            return actor_value;
-        }
-
         return RE::ActorValue::kNone;
     }
 
@@ -270,7 +130,6 @@ namespace util {
         const uint32_t a_position,
         const std::vector<data_helper*>& a_data,
         const uint32_t a_hand) {
-        const auto section = get_section_name_for_page_position(a_page, a_position);
         auto type = static_cast<uint32_t>(slot_type::empty);
         std::string form_string;
         uint32_t action = 0;
@@ -331,9 +190,7 @@ namespace util {
         }
         config::mcm_setting::read_setting();
 
-        config::custom_setting::write_section_setting(section,
-            a_page,
-            a_position,
+        config::custom_setting::write_section_setting(make_page_key(a_page, a_position),
             type,
             form_string,
             action,
@@ -15,7 +15,6 @@ namespace util {
         static bool is_two_handed(RE::TESForm*& a_form);
         static slot_type get_type(RE::TESForm*& a_form);
         static void rewrite_settings();
-        static std::string get_section_name_for_page_position(uint32_t a_page, uint32_t a_position);
         static RE::ActorValue get_actor_value_effect_from_potion(RE::TESForm* a_form, bool a_check = true);
         static void write_setting_to_file(uint32_t a_page,
             uint32_t a_position,
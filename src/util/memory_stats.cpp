@@ -0,0 +1,81 @@
+#include "memory_stats.h"
+
+namespace util {
+    constexpr std::array<std::string_view, static_cast<size_t>(memory_stats::subsystem::total)> subsystem_names = {
+        "textures (vram)",
+        "font atlas (vram)",
+        "page model",
+        "data helper",
+        "extra data"
+    };
+
+    struct subsystem_usage {
+        std::atomic<size_t> count = 0;
+        std::atomic<size_t> bytes = 0;
+        std::atomic<size_t> peak_bytes = 0;
+        //at the last log, the next one shows the change
+        std::atomic<size_t> logged_bytes = 0;
+    };
+
+    //constant initialized, the counted new can run before anything else is set up
+    static std::array<subsystem_usage, static_cast<size_t>(memory_stats::subsystem::total)> usages;
+
+    static void update_peak(subsystem_usage& a_usage, const size_t a_bytes) {
+        auto peak = a_usage.peak_bytes.load(std::memory_order_relaxed);
+        while (a_bytes > peak && !a_usage.peak_bytes.compare_exchange_weak(peak, a_bytes, std::memory_order_relaxed)) {}
+    }
+
+    void memory_stats::add(const subsystem a_subsystem, const size_t a_bytes) {
+        auto& usage = usages[static_cast<size_t>(a_subsystem)];
+        usage.count.fetch_add(1, std::memory_order_relaxed);
+        update_peak(usage, usage.bytes.fetch_add(a_bytes, std::memory_order_relaxed) + a_bytes);
+    }
+
+    void memory_stats::remove(const subsystem a_subsystem, const size_t a_bytes) {
+        auto& usage = usages[static_cast<size_t>(a_subsystem)];
+        usage.count.fetch_sub(1, std::memory_order_relaxed);
+        usage.bytes.fetch_sub(a_bytes, std::memory_order_relaxed);
+    }
+
+    void memory_stats::set(const subsystem a_subsystem, const size_t a_count, const size_t a_bytes) {
+        auto& usage = usages[static_cast<size_t>(a_subsystem)];
+        usage.count.store(a_count, std::memory_order_relaxed);
+        usage.bytes.store(a_bytes, std::memory_order_relaxed);
+        update_peak(usage, a_bytes);
+    }
+
+    void memory_stats::log_report() {
+        size_t total = 0;
+        for (size_t i = 0; i < usages.size(); ++i) {
+            logger::info("memory {}"sv, get_line(static_cast<subsystem>(i)));
+            auto& usage = usages[i];
+            const auto bytes = usage.bytes.load(std::memory_order_relaxed);
+            usage.logged_bytes.store(bytes, std::memory_order_relaxed);
+            total += bytes;
+        }
+        logger::info("memory total {:.1f}KB"sv, static_cast<double>(total) / 1024.0);
+    }
+
+    std::vector<std::string> memory_stats::get_report() {
+        std::vector<std::string> lines;
+        lines.reserve(usages.size());
+        for (size_t i = 0; i < usages.size(); ++i) {
+            lines.push_back(get_line(static_cast<subsystem>(i)));
+        }
+        return lines;
+    }
+
+    std::string memory_stats::get_line(const subsystem a_subsystem) {
+        const auto& usage = usages[static_cast<size_t>(a_subsystem)];
+        const auto kb = [](const size_t a_bytes) { return static_cast<double>(a_bytes) / 1024.0; };
+        const auto bytes = usage.bytes.load(std::memory_order_relaxed);
+        const auto logged = usage.logged_bytes.load(std::memory_order_relaxed);
+        return fmt::format("{}: {} objects, {:.1f}KB, peak {:.1f}KB, {}{:.1f}KB since the last load"sv,
+            subsystem_names[static_cast<size_t>(a_subsystem)],
+            usage.count.load(std::memory_order_relaxed),
+            kb(bytes),
+            kb(usage.peak_bytes.load(std::memory_order_relaxed)),
+            bytes >= logged ? "+" : "-",
+            kb(bytes >= logged ? bytes - logged : logged - bytes));
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+namespace util {
+    //what the plugin holds, per part of it, so growth over a long session shows where it comes from. heap numbers
+    //are the objects themselves without what they point to, textures are width * height * 4, they have no mips
+    class memory_stats {
+    public:
+        enum class subsystem : std::uint32_t {
+            texture = 0,
+            font_atlas = 1,
+            page_model = 2,
+            data_helper = 3,
+            extra_data = 4,
+            total = 5
+        };
+
+        static void add(subsystem a_subsystem, size_t a_bytes);
+        static void remove(subsystem a_subsystem, size_t a_bytes);
+        //for the parts that are easier to count again than to follow
+        static void set(subsystem a_subsystem, size_t a_count, size_t a_bytes);
+
+        //with the change since the last log, that is done at each load
+        static void log_report();
+        [[nodiscard]] static std::vector<std::string> get_report();
+
+    private:
+        static std::string get_line(subsystem a_subsystem);
+    };
+
+    //class specific new and delete that count the heap objects of the deriving class
+    template <memory_stats::subsystem Subsystem>
+    class memory_counted {
+    public:
+        static void* operator new(const size_t a_size) {
+            memory_stats::add(Subsystem, a_size);
+            return ::operator new(a_size);
+        }
+
+        static void operator delete(void* a_memory, const size_t a_size) {
+            memory_stats::remove(Subsystem, a_size);
+            ::operator delete(a_memory);
+        }
+    };
+}
@@ -0,0 +1,22 @@
+#pragma once
+//also built into the config compiler, which has no PCH
+#include <cstdint>
+
+namespace util {
+    //page and position packed into one integer, the lower bits are the position (0-3), the rest is the page
+    //section names like Page0Position1 are only generated when reading or writing the custom config
+    using page_key = uint32_t;
+
+    constexpr uint32_t page_key_position_bits = 2;
+    constexpr uint32_t page_key_position_mask = (1u << page_key_position_bits) - 1;
+    //total is not a real position, so it is never part of a key
+    constexpr uint32_t page_key_position_count = 4;
+
+    constexpr page_key make_page_key(const uint32_t a_page, const uint32_t a_position) {
+        return a_page << page_key_position_bits | (a_position & page_key_position_mask);
+    }
+
+    constexpr uint32_t get_page_from_key(const page_key a_key) { return a_key >> page_key_position_bits; }
+
+    constexpr uint32_t get_position_from_key(const page_key a_key) { return a_key & page_key_position_mask; }
+}
@@ -7,7 +7,7 @@ namespace util {
         const auto* entry_point = static_cast<RE::BGSEntryPointPerkEntry*>(perk_entry);
         const auto* perk = entry_point->perk;
 
-        logger::trace("form id {}, name {}"sv, string_util::int_to_hex(perk->formID), perk->GetName());
+        LOG_TRACE("form id {}, name {}"sv, string_util::int_to_hex(perk->formID), perk->GetName());
 
         if (entry_point->functionData) {
             const RE::BGSEntryPointFunctionDataOneValue* value =
@@ -27,7 +27,7 @@ namespace util {
                 }
             }
 
-            logger::trace("Got value {} for Perk, total now is {}"sv, value->data, result_);
+            LOG_TRACE("Got value {} for Perk, total now is {}"sv, value->data, result_);
         }
 
         return ReturnType::kContinue;
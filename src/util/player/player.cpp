@@ -1,19 +1,43 @@
-#include "player.h"
-#include "setting/mcm_setting.h"
-#include "util/helper.h"
+﻿#include "player.h"
 #include "util/offset.h"
 #include "util/string_util.h"
 
 namespace util {
-    using slot_type = handle::slot_setting::slot_type;
-    using action_type = handle::slot_setting::action_type;
 
 
-    std::map<RE::TESBoundObject*, std::pair<int, std::unique_ptr<RE::InventoryEntryData>>>
-        player::get_inventory(RE::PlayerCharacter*& a_player, RE::FormType a_type) {
+    player::inventory player::get_inventory(RE::PlayerCharacter*& a_player, RE::FormType a_type) {
         return a_player->GetInventory([a_type](const RE::TESBoundObject& a_object) { return a_object.Is(a_type); });
     }
 
+    player::inventory_item player::get_inventory_item(RE::PlayerCharacter*& a_player, const RE::TESForm* a_form) {
+        inventory_item item;
+        if (!a_player || !a_form || !a_form->IsBoundObject()) {
+            return item;
+        }
+        item.object = static_cast<RE::TESBoundObject*>(const_cast<RE::TESForm*>(a_form));
+
+        //same as GetInventory does it, base container plus the changes on top, just for the one object
+        if (const auto* container = a_player->GetContainer(); container) {
+            for (uint32_t i = 0; i < container->numContainerObjects; ++i) {
+                if (const auto* container_object = container->containerObjects[i];
+                    container_object && container_object->obj == item.object) {
+                    item.count += container_object->count;
+                }
+            }
+        }
+
+        if (auto* changes = a_player->GetInventoryChanges(); changes && changes->entryList) {
+            for (auto* entry : *changes->entryList) {
+                if (entry && entry->object == item.object) {
+                    item.count += entry->countDelta;
+                    item.entry = entry;
+                    break;
+                }
+            }
+        }
+        return item;
+    }
+
     uint32_t player::get_inventory_count(const RE::TESForm* a_form) {
         uint32_t count = 0;
         if (!a_form) {
@@ -27,71 +51,11 @@ namespace util {
             count = get_inventory_count(a_form, RE::FormType::Armor, player);
         }
 
-        logger::trace("got {} in inventory for item {}"sv, count, a_form->GetName());
+        LOG_TRACE("got {} in inventory for item {}"sv, count, a_form->GetName());
 
         return count;
     }
 
-    std::vector<data_helper*> player::get_hand_assignment(bool a_two_handed) {
-        std::vector<data_helper*> data;
-        const auto* player = RE::PlayerCharacter::GetSingleton();
-        auto right_obj = player->GetActorRuntimeData().currentProcess->GetEquippedRightHand();
-        auto left_obj = player->GetActorRuntimeData().currentProcess->GetEquippedLeftHand();
-
-        const auto empty_handle = config::mcm_setting::get_empty_hand_setting();
-
-        const auto item = new data_helper();
-        item->form = nullptr;
-        item->left = false;
-        item->type = slot_type::empty;
-        item->action_type = empty_handle ? action_type::un_equip : action_type::default_action;
-        data.push_back(item);
-
-        const auto item2 = new data_helper();
-        item2->form = nullptr;
-        item2->left = true;
-        item2->type = slot_type::empty;
-        item2->action_type = empty_handle ? action_type::un_equip : action_type::default_action;
-        data.push_back(item2);
-
-        if (!a_two_handed) {
-            a_two_handed = right_obj && util::helper::is_two_handed(right_obj);
-        }
-
-        logger::trace("got form {}, name {} on both/right hand"sv,
-            right_obj ? string_util::int_to_hex(right_obj->GetFormID()) : "null",
-            right_obj ? right_obj->GetName() : "null");
-
-        logger::trace("got form {}, name {} on left hand"sv,
-            left_obj ? string_util::int_to_hex(left_obj->GetFormID()) : "null",
-            left_obj ? left_obj->GetName() : "null");
-
-        if (a_two_handed && right_obj && left_obj && right_obj->formID == left_obj->formID) {
-            data[0]->form = right_obj;
-            data[0]->left = false;
-            data[0]->type = util::helper::get_type(right_obj);
-            data[0]->action_type = action_type::default_action;
-            data.erase(data.begin() + 1);
-        }
-
-        if (right_obj) {
-            data[0]->form = right_obj;
-            data[0]->left = false;
-            data[0]->type = util::helper::get_type(right_obj);
-            data[0]->action_type = action_type::default_action;
-        }
-
-        if (left_obj) {
-            data[1]->form = left_obj;
-            data[1]->left = true;
-            data[1]->type = util::helper::get_type(left_obj);
-            data[1]->action_type = action_type::default_action;
-        }
-
-        logger::trace("got {} items in List now. return."sv, data.size());
-        return data;
-    }
-
     bool player::has_item_or_spell(RE::TESForm* a_form) {
         auto has_it = false;
         if (!a_form) {
@@ -118,7 +82,7 @@ namespace util {
             has_it = has_shout(player, shout);
         }
 
-        logger::trace("Player has item/spell/shout {}, name {}, form {} "sv,
+        LOG_TRACE("Player has item/spell/shout {}, name {}, form {} "sv,
             has_it,
             a_form->GetName(),
             util::string_util::int_to_hex(a_form->formID));
@@ -128,15 +92,11 @@ namespace util {
 
     uint32_t
         player::get_inventory_count(const RE::TESForm* a_form, RE::FormType a_type, RE::PlayerCharacter*& a_player) {
-        auto count = 0;
-        auto inventory = get_inventory(a_player, a_type);
-        for (const auto& [item, inv_data] : inventory) {
-            if (const auto& [num_items, entry] = inv_data; entry->object->formID == a_form->formID) {
-                count = num_items;
-                break;
-            }
+        if (!a_form->Is(a_type)) {
+            return 0;
         }
-        return count;
+        const auto count = get_inventory_item(a_player, a_form).count;
+        return count > 0 ? static_cast<uint32_t>(count) : 0;
     }
 
     bool player::has_shout(RE::Actor* a_actor, RE::TESShout* a_shout) {
@@ -153,7 +113,7 @@ namespace util {
             sound_handle.SetObjectToFollow(a_player->Get3D());
             sound_handle.SetVolume(1.0);
             sound_handle.Play();
-            logger::trace("played sound"sv);
+            LOG_TRACE("played sound"sv);
         }
     }
 }  // util
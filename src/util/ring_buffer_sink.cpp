@@ -0,0 +1,164 @@
+#include "ring_buffer_sink.h"
+
+namespace util {
+    //the drain thread could have been killed while it held the consumer, on process exit
+    constexpr auto hold_timeout = std::chrono::milliseconds(500);
+
+    ring_buffer_sink::ring_buffer_sink(const spdlog::filename_t& a_file, const bool a_truncate, const size_t a_capacity)
+        : lines_(std::bit_ceil(std::max<size_t>(a_capacity, 2)))
+        , mask_(lines_.size() - 1)
+        , file_(std::make_unique<spdlog::sinks::basic_file_sink_st>(a_file, a_truncate)) {
+        for (size_t i = 0; i < lines_.size(); ++i) {
+            lines_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        thread_ = std::jthread([this](const std::stop_token& a_stop) { run(a_stop); });
+    }
+
+    ring_buffer_sink::~ring_buffer_sink() {
+        thread_.request_stop();
+        wake();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        drain_now(hold_timeout);
+    }
+
+    ring_buffer_sink* ring_buffer_sink::get_default() {
+        const auto* log = spdlog::default_logger_raw();
+        if (!log) {
+            return nullptr;
+        }
+        for (const auto& sink : log->sinks()) {
+            if (auto* ring = dynamic_cast<ring_buffer_sink*>(sink.get()); ring) {
+                return ring;
+            }
+        }
+        return nullptr;
+    }
+
+    void ring_buffer_sink::log(const spdlog::details::log_msg& a_msg) {
+        auto position = enqueue_position_.load(std::memory_order_relaxed);
+        queued_line* line;
+        while (true) {
+            line = &lines_[position & mask_];
+            const auto sequence = line->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (difference == 0) {
+                if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                //full
+                if (!block_when_full_.load(std::memory_order_relaxed)) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                wake();
+                std::this_thread::yield();
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            } else {
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+
+        line->time = a_msg.time;
+        line->source = a_msg.source;
+        line->logger_name = a_msg.logger_name;
+        line->level = a_msg.level;
+        line->thread_id = a_msg.thread_id;
+        //keeps its capacity, after a while nothing gets allocated here anymore
+        line->payload.assign(a_msg.payload.data(), a_msg.payload.size());
+        line->sequence.store(position + 1, std::memory_order_release);
+        wake();
+    }
+
+    void ring_buffer_sink::flush() {
+        flush_requested_.store(true, std::memory_order_relaxed);
+        wake();
+    }
+
+    void ring_buffer_sink::set_pattern(const std::string& a_pattern) {
+        //rare, just at startup. the formatter must not change while the drain thread uses it
+        if (try_hold_consumer(hold_timeout)) {
+            file_->set_pattern(a_pattern);
+            release_consumer();
+        }
+    }
+
+    void ring_buffer_sink::set_formatter(std::unique_ptr<spdlog::formatter> a_formatter) {
+        if (try_hold_consumer(hold_timeout)) {
+            file_->set_formatter(std::move(a_formatter));
+            release_consumer();
+        }
+    }
+
+    void ring_buffer_sink::set_block_when_full(const bool a_block) {
+        block_when_full_.store(a_block, std::memory_order_relaxed);
+    }
+
+    void ring_buffer_sink::drain_now(const std::chrono::milliseconds a_timeout) {
+        if (!try_hold_consumer(a_timeout)) {
+            return;
+        }
+        drain();
+        file_->flush();
+        release_consumer();
+    }
+
+    void ring_buffer_sink::run(const std::stop_token& a_stop) {
+        while (!a_stop.stop_requested()) {
+            if (!wake_.exchange(false, std::memory_order_acq_rel)) {
+                wake_.wait(false, std::memory_order_acquire);
+                continue;
+            }
+            if (!try_hold_consumer(hold_timeout)) {
+                continue;
+            }
+            drain();
+            if (flush_requested_.exchange(false, std::memory_order_relaxed)) {
+                file_->flush();
+            }
+            release_consumer();
+        }
+    }
+
+    void ring_buffer_sink::drain() {
+        if (const auto dropped = dropped_.exchange(0, std::memory_order_relaxed); dropped > 0) {
+            const auto text = fmt::format("log queue was full, dropped {} lines", dropped);
+            spdlog::details::log_msg message(spdlog::source_loc{}, "", spdlog::level::warn, text);
+            file_->log(message);
+        }
+
+        while (true) {
+            auto& line = lines_[dequeue_position_ & mask_];
+            if (line.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1) {
+                break;
+            }
+            spdlog::details::log_msg message(line.time, line.source, line.logger_name, line.level, line.payload);
+            message.thread_id = line.thread_id;
+            file_->log(message);
+
+            line.sequence.store(dequeue_position_ + mask_ + 1, std::memory_order_release);
+            ++dequeue_position_;
+        }
+    }
+
+    bool ring_buffer_sink::try_hold_consumer(const std::chrono::milliseconds a_timeout) {
+        const auto until = std::chrono::steady_clock::now() + a_timeout;
+        while (consumer_.test_and_set(std::memory_order_acquire)) {
+            if (std::chrono::steady_clock::now() > until) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    void ring_buffer_sink::release_consumer() { consumer_.clear(std::memory_order_release); }
+
+    void ring_buffer_sink::wake() {
+        if (!wake_.exchange(true, std::memory_order_acq_rel)) {
+            wake_.notify_one();
+        }
+    }
+}
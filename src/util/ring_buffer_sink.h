@@ -0,0 +1,62 @@
+#pragma once
+
+namespace util {
+    //a log line costs the game thread a copy into a fixed ring, formatting and file io happen on a thread of its own.
+    //what does not fit is dropped and counted, or the caller waits for room if block is set
+    class ring_buffer_sink final : public spdlog::sinks::sink {
+    public:
+        ring_buffer_sink(const spdlog::filename_t& a_file, bool a_truncate, size_t a_capacity);
+        ~ring_buffer_sink() override;
+
+        //the one behind the default logger, null if it writes somewhere else
+        static ring_buffer_sink* get_default();
+
+        void log(const spdlog::details::log_msg& a_msg) override;
+        //does not wait, the drain thread flushes once it caught up
+        void flush() override;
+        void set_pattern(const std::string& a_pattern) override;
+        void set_formatter(std::unique_ptr<spdlog::formatter> a_formatter) override;
+
+        void set_block_when_full(bool a_block);
+        //writes out everything queued so far from the calling thread, for a crash or the unload
+        void drain_now(std::chrono::milliseconds a_timeout);
+
+        ring_buffer_sink(const ring_buffer_sink&) = delete;
+        ring_buffer_sink(ring_buffer_sink&&) = delete;
+
+        ring_buffer_sink& operator=(const ring_buffer_sink&) const = delete;
+        ring_buffer_sink& operator=(ring_buffer_sink&&) const = delete;
+
+    private:
+        //the text is copied, the rest points to static data or the logger that outlives us
+        struct queued_line {
+            std::atomic<size_t> sequence = 0;
+            spdlog::log_clock::time_point time;
+            spdlog::source_loc source;
+            spdlog::string_view_t logger_name;
+            spdlog::level::level_enum level = spdlog::level::off;
+            size_t thread_id = 0;
+            std::string payload;
+        };
+
+        void run(const std::stop_token& a_stop);
+        //expects the consumer to be held
+        void drain();
+        bool try_hold_consumer(std::chrono::milliseconds a_timeout);
+        void release_consumer();
+        void wake();
+
+        std::vector<queued_line> lines_;
+        size_t mask_;
+        alignas(64) std::atomic<size_t> enqueue_position_ = 0;
+        alignas(64) size_t dequeue_position_ = 0;
+        std::atomic<size_t> dropped_ = 0;
+        std::atomic<bool> block_when_full_ = false;
+        std::atomic<bool> wake_ = false;
+        std::atomic<bool> flush_requested_ = false;
+        //whoever holds it reads the ring and writes the file, the drain thread or drain_now
+        std::atomic_flag consumer_ = ATOMIC_FLAG_INIT;
+        std::unique_ptr<spdlog::sinks::basic_file_sink_st> file_;
+        std::jthread thread_;
+    };
+}
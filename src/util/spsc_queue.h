@@ -0,0 +1,37 @@
+#pragma once
+
+namespace util {
+    //a fixed ring for one producer and one consumer thread, neither of them ever waits. a full queue drops the push
+    template <typename T, size_t N>
+    class spsc_queue {
+    public:
+        static_assert(N > 1 && (N & (N - 1)) == 0, "the size has to be a power of two");
+
+        //only the producer
+        bool push(const T& a_item) {
+            const auto tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_.load(std::memory_order_acquire) == N) {
+                return false;
+            }
+            items_[tail & (N - 1)] = a_item;
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        //only the consumer
+        bool pop(T& a_item) {
+            const auto head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            a_item = items_[head & (N - 1)];
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        std::array<T, N> items_;
+        alignas(64) std::atomic<size_t> head_ = 0;
+        alignas(64) std::atomic<size_t> tail_ = 0;
+    };
+}
@@ -0,0 +1,160 @@
+#include "trace_recorder.h"
+#include "control/common.h"
+
+namespace util {
+    constexpr size_t flush_size = 64 * 1024;
+
+    trace_recorder* trace_recorder::get_singleton() {
+        static trace_recorder singleton;
+        return std::addressof(singleton);
+    }
+
+    trace_recorder::~trace_recorder() {
+        //the logger might be gone already on exit, so just the file
+        if (trace_recorder_data* data = this->data_; data) {
+            std::scoped_lock lock(data->lock);
+            active_.store(false, std::memory_order_release);
+            write_out(data);
+        }
+    }
+
+    void trace_recorder::set_enabled(const bool a_enabled) {
+        if (a_enabled == is_active()) {
+            return;
+        }
+        if (!this->data_) {
+            if (!a_enabled) {
+                return;
+            }
+            this->data_ = new trace_recorder_data();
+        }
+        trace_recorder_data* data = this->data_;
+
+        std::scoped_lock lock(data->lock);
+        if (!a_enabled) {
+            active_.store(false, std::memory_order_release);
+            write_out(data);
+            data->file.close();
+            logger::info("stopped recording the trace"sv);
+            return;
+        }
+
+        auto path = logger::log_directory();
+        if (!path) {
+            logger::warn("no log directory, can not record a trace"sv);
+            return;
+        }
+        *path /= fmt::format("{}.trace"sv, Version::PROJECT);
+        //a second start in the same session keeps adding to it, the times in there go on from the first
+        if (!data->started) {
+            data->file.open(*path, std::ios::binary | std::ios::trunc);
+            data->started = true;
+            data->start = clock::now();
+            core::trace_writer::write_header(data->buffer);
+        } else {
+            data->file.open(*path, std::ios::binary | std::ios::app);
+        }
+        if (!data->file) {
+            logger::warn("could not open trace file {}"sv, path->string());
+            return;
+        }
+        data->buffer.reserve(flush_size * 2);
+        active_.store(true, std::memory_order_release);
+        logger::info("recording the trace to {}"sv, path->string());
+    }
+
+    bool trace_recorder::is_active() const { return active_.load(std::memory_order_acquire); }
+
+    void trace_recorder::flush() const {
+        if (!is_active()) {
+            return;
+        }
+        std::scoped_lock lock(this->data_->lock);
+        LOG_TRACE("writing {} bytes of trace"sv, this->data_->buffer.size());
+        write_out(this->data_);
+    }
+
+    void trace_recorder::record_key(const RE::ButtonEvent* a_button) const {
+        //held comes each frame, the hud only acts on the edges
+        if (!is_active() || !a_button || (!a_button->IsDown() && !a_button->IsUp())) {
+            return;
+        }
+        core::trace_event event;
+        event.type = core::trace_event_type::key;
+        event.device = control::common::get_device(a_button->device.get());
+        event.id_code = a_button->idCode;
+        event.state = a_button->IsDown() ? core::key_state::down : core::key_state::up;
+        record(event);
+    }
+
+    void trace_recorder::record_inventory(const core::item_record& a_item) const {
+        if (!is_active()) {
+            return;
+        }
+        core::trace_event event;
+        event.type = core::trace_event_type::inventory;
+        event.item = a_item;
+        record(event);
+    }
+
+    void trace_recorder::record_equip(const RE::FormID a_form, const bool a_equipped) const {
+        if (!is_active()) {
+            return;
+        }
+        core::trace_event event;
+        event.type = core::trace_event_type::equip;
+        event.form = a_form;
+        event.equipped = a_equipped;
+        record(event);
+    }
+
+    void trace_recorder::record_menu(const std::string_view a_menu, const bool a_opening) const {
+        if (!is_active()) {
+            return;
+        }
+        core::trace_event event;
+        event.type = core::trace_event_type::menu;
+        event.menu_name = a_menu;
+        event.opening = a_opening;
+        record(event);
+    }
+
+    void trace_recorder::record_binding(const uint32_t a_key,
+        const uint32_t a_roles,
+        const core::position_type a_position) const {
+        if (!is_active()) {
+            return;
+        }
+        core::trace_event event;
+        event.type = core::trace_event_type::binding;
+        event.key = a_key;
+        event.roles = a_roles;
+        event.position = a_position;
+        record(event);
+    }
+
+    void trace_recorder::record(core::trace_event& a_event) const {
+        trace_recorder_data* data = this->data_;
+        std::scoped_lock lock(data->lock);
+        //it could have been turned off while we waited
+        if (!is_active()) {
+            return;
+        }
+        a_event.time = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - data->start).count());
+        data->writer.write(a_event, data->buffer);
+        if (data->buffer.size() >= flush_size) {
+            write_out(data);
+        }
+    }
+
+    void trace_recorder::write_out(trace_recorder_data* a_data) {
+        if (a_data->buffer.empty() || !a_data->file.is_open()) {
+            return;
+        }
+        a_data->file.write(reinterpret_cast<const char*>(a_data->buffer.data()),
+            static_cast<std::streamsize>(a_data->buffer.size()));
+        a_data->file.flush();
+        a_data->buffer.clear();
+    }
+}
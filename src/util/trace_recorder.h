@@ -0,0 +1,53 @@
+#pragma once
+#include "core/trace.h"
+
+namespace util {
+    //writes what the plugin gets from the game into a trace file, tools/trace_replay plays it through the core again.
+    //off unless bRecordTrace is set, then each event costs a lock and a few bytes, the file is written in chunks
+    class trace_recorder {
+    public:
+        static trace_recorder* get_singleton();
+
+        //the file in the log directory starts over each session, turning it off writes out what is left
+        void set_enabled(bool a_enabled);
+        [[nodiscard]] bool is_active() const;
+        //a load is a good point, a crash after it loses little
+        void flush() const;
+
+        void record_key(const RE::ButtonEvent* a_button) const;
+        //count is the change, tracked forms only
+        void record_inventory(const core::item_record& a_item) const;
+        void record_equip(RE::FormID a_form, bool a_equipped) const;
+        void record_menu(std::string_view a_menu, bool a_opening) const;
+        void record_binding(uint32_t a_key, uint32_t a_roles, core::position_type a_position) const;
+
+        trace_recorder(const trace_recorder&) = delete;
+        trace_recorder(trace_recorder&&) = delete;
+
+        trace_recorder& operator=(const trace_recorder&) const = delete;
+        trace_recorder& operator=(trace_recorder&&) const = delete;
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        trace_recorder() : data_(nullptr) {}
+        ~trace_recorder();
+
+        //stamps the time and writes to the buffer, the buffer goes to the file once it is big enough
+        void record(core::trace_event& a_event) const;
+
+        struct trace_recorder_data {
+            std::mutex lock;
+            std::ofstream file;
+            core::trace_writer writer;
+            std::vector<uint8_t> buffer;
+            clock::time_point start;
+            bool started = false;
+        };
+
+        static void write_out(trace_recorder_data* a_data);
+
+        std::atomic<bool> active_ = false;
+        trace_recorder_data* data_;
+    };
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+namespace util {
+    //one writer and one reader hand over whole values without waiting on each other. the writer fills its buffer
+    //and swaps it with the middle one, the reader swaps its buffer with the middle one if that got newer
+    template <typename T>
+    class triple_buffer {
+    public:
+        //only the writer, stays its own until publish
+        [[nodiscard]] T& get_write_buffer() { return buffers_[write_]; }
+
+        void publish() { write_ = middle_.exchange(write_ | fresh_bit, std::memory_order_acq_rel) & index_mask; }
+
+        //only the reader, false if nothing got published since the last call
+        bool update() {
+            if ((middle_.load(std::memory_order_relaxed) & fresh_bit) == 0) {
+                return false;
+            }
+            read_ = middle_.exchange(read_, std::memory_order_acq_rel) & index_mask;
+            return true;
+        }
+
+        //only the reader, stays valid until its next update
+        [[nodiscard]] const T& get_read_buffer() const { return buffers_[read_]; }
+
+    private:
+        static constexpr uint8_t index_mask = 0x3;
+        static constexpr uint8_t fresh_bit = 0x4;
+
+        std::array<T, 3> buffers_;
+        uint8_t write_ = 0;
+        std::atomic<uint8_t> middle_ = 1;
+        uint8_t read_ = 2;
+    };
+}
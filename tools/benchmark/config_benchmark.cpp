@@ -0,0 +1,34 @@
+#include "core/config/page_config.h"
+#include "scenario.h"
+#include <benchmark/benchmark.h>
+
+//what loading a custom config costs apart from the form lookups: parse, merge, validate and bring the pages in order
+static void config_load(benchmark::State& a_state) {
+    const auto content = scenario::make_custom_config(static_cast<uint32_t>(a_state.range(0)));
+    for ([[maybe_unused]] auto _ : a_state) {
+        core::ini_file file;
+        file.parse(content);
+        core::page_config config(core::page_config::config_mode::elden);
+        config.read(file);
+        config.validate();
+        benchmark::DoNotOptimize(config.normalize());
+        benchmark::DoNotOptimize(config.get_entries().data());
+    }
+    a_state.SetBytesProcessed(static_cast<int64_t>(a_state.iterations()) * static_cast<int64_t>(content.size()));
+    a_state.SetItemsProcessed(static_cast<int64_t>(a_state.iterations()) * a_state.range(0));
+}
+BENCHMARK(config_load)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+//writing it back, like rewrite_settings does after the pages got renumbered
+static void config_write(benchmark::State& a_state) {
+    core::ini_file file;
+    file.parse(scenario::make_custom_config(static_cast<uint32_t>(a_state.range(0))));
+    core::page_config config(core::page_config::config_mode::elden);
+    config.read(file);
+    config.normalize();
+    for ([[maybe_unused]] auto _ : a_state) {
+        benchmark::DoNotOptimize(config.write());
+    }
+    a_state.SetItemsProcessed(static_cast<int64_t>(a_state.iterations()) * a_state.range(0));
+}
+BENCHMARK(config_write)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
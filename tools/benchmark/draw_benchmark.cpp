@@ -0,0 +1,18 @@
+#include "core/hud_draw.h"
+#include "counting_render_target.h"
+#include "scenario.h"
+#include <benchmark/benchmark.h>
+
+//one frame of the slots with nothing changed, what the renderer does every present
+static void draw_slots_steady_state(benchmark::State& a_state) {
+    const auto snapshot = scenario::make_snapshot();
+    stand_in::counting_render_target target;
+    for ([[maybe_unused]] auto _ : a_state) {
+        core::draw_slots(960.f, 540.f, snapshot, target);
+    }
+    benchmark::DoNotOptimize(target.get_counts().checksum);
+    const auto& counts = target.get_counts();
+    a_state.counters["draw_calls"] = benchmark::Counter(static_cast<double>(counts.slots + counts.icons + counts.texts),
+        benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(draw_slots_steady_state);
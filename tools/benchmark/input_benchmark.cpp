@@ -0,0 +1,39 @@
+#include "core/key_table.h"
+#include "core/page_cycle.h"
+#include "scenario.h"
+#include <benchmark/benchmark.h>
+
+//what ProcessEvent does with a list of button events before it has to ask the game: normalize the key, look it up
+//and cycle the page of a position button
+static void process_event_burst(benchmark::State& a_state) {
+    using key_role = core::key_table::key_role;
+    constexpr uint32_t max_page_count = 10;
+    const auto events = scenario::make_key_burst(static_cast<uint32_t>(a_state.range(0)));
+    core::key_table table;
+    scenario::fill_key_table(table);
+    core::page_cycle cycle;
+    for (uint32_t i = 0; i < core::position_count; ++i) {
+        cycle.set_active_page_position(0, static_cast<core::position_type>(i));
+        cycle.set_highest_page_position(4, static_cast<core::position_type>(i));
+    }
+
+    for ([[maybe_unused]] auto _ : a_state) {
+        uint32_t handled = 0;
+        for (const auto& event : events) {
+            const auto key = core::get_key_id(event.device, event.id_code);
+            const auto& dispatch = table.get(key);
+            if (dispatch.roles == key_role::none) {
+                continue;
+            }
+            ++handled;
+            if (event.down && (dispatch.roles & key_role::position_button) != 0) {
+                cycle.set_active_page_position(
+                    cycle.get_next_non_empty_page_position(dispatch.position, max_page_count),
+                    dispatch.position);
+            }
+        }
+        benchmark::DoNotOptimize(handled);
+    }
+    a_state.SetItemsProcessed(static_cast<int64_t>(a_state.iterations()) * a_state.range(0));
+}
+BENCHMARK(process_event_burst)->Arg(100);
@@ -0,0 +1,220 @@
+#include "core/item_counts.h"
+#include "scenario.h"
+#include <benchmark/benchmark.h>
+#include <forward_list>
+#include <map>
+#include <memory>
+#include <random>
+
+namespace {
+    //what the game keeps for the player, reduced to what a lookup touches: the base container is an array,
+    //InventoryChanges a singly linked list of entries that each own their extra data
+    struct form_stand_in {
+        core::form_id id = 0;
+        uint32_t type = 0;
+    };
+
+    struct entry_stand_in {
+        const form_stand_in* object = nullptr;
+        int32_t count_delta = 0;
+        std::vector<uint32_t> extra_lists;
+    };
+
+    struct actor_inventory_stand_in {
+        std::vector<form_stand_in> forms;
+        std::vector<std::pair<const form_stand_in*, int32_t>> container;
+        std::forward_list<std::unique_ptr<entry_stand_in>> changes;
+    };
+
+    //weapons, armor, potions, ammo, scrolls and misc items, the last two are filtered out like they were before
+    constexpr uint32_t form_types = 6;
+    constexpr uint32_t filtered_types = 4;
+
+    actor_inventory_stand_in make_actor_inventory(const uint32_t a_items) {
+        actor_inventory_stand_in inventory;
+        inventory.forms.reserve(a_items);
+        for (uint32_t i = 0; i < a_items; ++i) {
+            inventory.forms.push_back({ 0x1000 + i, i % form_types });
+        }
+        //the base container holds a few of them, everything picked up since is in the changes
+        for (uint32_t i = 0; i < a_items; i += 10) {
+            inventory.container.emplace_back(&inventory.forms[i], 1);
+        }
+        for (const auto& form : inventory.forms) {
+            auto entry = std::make_unique<entry_stand_in>();
+            entry->object = &form;
+            entry->count_delta = static_cast<int32_t>(form.id % 7) + 1;
+            entry->extra_lists.resize(form.type < 2 ? 2 : 0);
+            inventory.changes.push_front(std::move(entry));
+        }
+        return inventory;
+    }
+
+    std::vector<const form_stand_in*> pick_forms(const actor_inventory_stand_in& a_inventory, const size_t a_count) {
+        std::mt19937 random(static_cast<uint32_t>(a_inventory.forms.size()));
+        std::vector<const form_stand_in*> picked;
+        while (picked.size() < a_count) {
+            //only the types the hud equips get asked for
+            if (const auto& form = a_inventory.forms[random() % a_inventory.forms.size()]; form.type < filtered_types) {
+                picked.push_back(&form);
+            }
+        }
+        return picked;
+    }
+}
+
+//the one look at the inventory after a load, reset or config change
+static void item_counts_build(benchmark::State& a_state) {
+    stand_in::memory_inventory inventory;
+    scenario::fill_inventory(inventory, static_cast<uint32_t>(a_state.range(0)), 0x1000);
+    core::item_counts counts;
+    for ([[maybe_unused]] auto _ : a_state) {
+        counts.build(inventory);
+        benchmark::DoNotOptimize(counts.get_tracked_form_count());
+    }
+    a_state.SetItemsProcessed(static_cast<int64_t>(a_state.iterations()) * a_state.range(0));
+}
+BENCHMARK(item_counts_build)->Arg(100)->Arg(1000)->Arg(10000);
+
+//a slot asking item_counts for the count of its item, what used to be a walk over the whole inventory
+static void item_counts_lookup(benchmark::State& a_state) {
+    constexpr size_t lookups = 64;
+    const auto items = static_cast<uint32_t>(a_state.range(0));
+    stand_in::memory_inventory inventory;
+    scenario::fill_inventory(inventory, items, 0x1000);
+    core::item_counts counts;
+    counts.build(inventory);
+
+    std::mt19937 random(items);
+    std::vector<core::form_id> forms(lookups);
+    //some of them are not in the inventory
+    for (auto& form : forms) {
+        form = static_cast<core::form_id>(0x1000 + random() % (items + items / 8));
+    }
+    for ([[maybe_unused]] auto _ : a_state) {
+        int32_t total = 0;
+        for (const auto form : forms) {
+            total += counts.get_count(form);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    a_state.SetItemsProcessed(static_cast<int64_t>(a_state.iterations()) * static_cast<int64_t>(lookups));
+}
+BENCHMARK(item_counts_lookup)->Arg(100)->Arg(1000)->Arg(10000);
+
+//a batch of four equips like the action queue ran it before: GetInventory with a type filter builds a map of the
+//matching objects, each with a copy of its entry, and every equip finds its object in there
+static void inventory_lookup_filtered_map(benchmark::State& a_state) {
+    constexpr size_t lookups = 4;
+    const auto inventory = make_actor_inventory(static_cast<uint32_t>(a_state.range(0)));
+    const auto forms = pick_forms(inventory, lookups);
+    using inventory_map = std::map<const form_stand_in*, std::pair<int32_t, std::unique_ptr<entry_stand_in>>>;
+
+    for ([[maybe_unused]] auto _ : a_state) {
+        inventory_map map;
+        for (const auto& entry : inventory.changes) {
+            if (entry->object->type < filtered_types) {
+                map.emplace(entry->object,
+                    std::make_pair(entry->count_delta, std::make_unique<entry_stand_in>(*entry)));
+            }
+        }
+        for (const auto& [object, count] : inventory.container) {
+            if (object->type >= filtered_types) {
+                continue;
+            }
+            if (const auto it = map.find(object); it != map.end()) {
+                it->second.first += count;
+            } else {
+                map.emplace(object, std::make_pair(count, std::make_unique<entry_stand_in>()));
+            }
+        }
+
+        int32_t total = 0;
+        for (const auto* form : forms) {
+            if (const auto it = map.find(form); it != map.end()) {
+                total += it->second.first + static_cast<int32_t>(it->second.second->extra_lists.size());
+            }
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    a_state.SetItemsProcessed(static_cast<int64_t>(a_state.iterations()) * static_cast<int64_t>(lookups));
+}
+BENCHMARK(inventory_lookup_filtered_map)->Arg(100)->Arg(1000)->Arg(10000);
+
+//the same batch with util::player::get_inventory_item: each equip walks the base container and the changes until it
+//finds its entry, nothing gets copied
+static void inventory_lookup_direct(benchmark::State& a_state) {
+    constexpr size_t lookups = 4;
+    const auto inventory = make_actor_inventory(static_cast<uint32_t>(a_state.range(0)));
+    const auto forms = pick_forms(inventory, lookups);
+
+    for ([[maybe_unused]] auto _ : a_state) {
+        int32_t total = 0;
+        for (const auto* form : forms) {
+            int32_t count = 0;
+            for (const auto& [object, base_count] : inventory.container) {
+                if (object == form) {
+                    count += base_count;
+                }
+            }
+            for (const auto& entry : inventory.changes) {
+                if (entry->object == form) {
+                    count += entry->count_delta + static_cast<int32_t>(entry->extra_lists.size());
+                    break;
+                }
+            }
+            total += count;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    a_state.SetItemsProcessed(static_cast<int64_t>(a_state.iterations()) * static_cast<int64_t>(lookups));
+}
+BENCHMARK(inventory_lookup_direct)->Arg(100)->Arg(1000)->Arg(10000);
+
+//take all on a container with 1000 items. every change goes into the counts, the four shown slots look at theirs
+//like set_new_item_count_if_needed does
+static void set_new_item_count_loot_transfer(benchmark::State& a_state) {
+    constexpr uint32_t owned = 500;
+    const auto transfer = static_cast<uint32_t>(a_state.range(0));
+    stand_in::memory_inventory inventory;
+    scenario::fill_inventory(inventory, owned, 0x1000);
+    //half of the loot is already owned, the other half is new
+    stand_in::memory_inventory loot;
+    scenario::fill_inventory(loot, transfer, 0x1000 + owned / 2);
+    const std::array<core::form_id, core::position_count> shown = { 0x1000, 0x1004, 0x1000 + owned, 0x1011 };
+
+    core::item_counts counts;
+    for ([[maybe_unused]] auto _ : a_state) {
+        a_state.PauseTiming();
+        counts.build(inventory);
+        a_state.ResumeTiming();
+
+        int32_t shown_total = 0;
+        for (const auto& item : loot.get_items()) {
+            counts.apply_delta(item);
+            for (const auto form : shown) {
+                if (form == item.id) {
+                    shown_total += counts.get_count(form);
+                }
+            }
+        }
+        benchmark::DoNotOptimize(shown_total);
+    }
+    a_state.SetItemsProcessed(static_cast<int64_t>(a_state.iterations()) * transfer);
+}
+BENCHMARK(set_new_item_count_loot_transfer)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+//drinking from a group, the pick between the potions of the group
+static void fitting_potion(benchmark::State& a_state) {
+    stand_in::memory_inventory inventory;
+    scenario::fill_inventory(inventory, static_cast<uint32_t>(a_state.range(0)), 0x1000);
+    core::item_counts counts;
+    counts.build(inventory);
+    float missing = 5.f;
+    for ([[maybe_unused]] auto _ : a_state) {
+        missing = missing > 400.f ? 5.f : missing + 7.f;
+        benchmark::DoNotOptimize(
+            counts.get_fitting_potion(scenario::potion_groups[0], missing, 0.8f, 1.2f, true));
+    }
+}
+BENCHMARK(fitting_potion)->Arg(100)->Arg(1000)->Arg(10000);
@@ -0,0 +1,134 @@
+#include "scenario.h"
+#include <fmt/format.h>
+#include <random>
+
+namespace scenario {
+    //keyboard scan codes of the default mcm keys, 1 to 4 on the number row, 5 for toggle, 6 for hide
+    constexpr std::array<uint32_t, 4> position_keys = { 2, 3, 4, 5 };
+    constexpr uint32_t toggle_key = 6;
+    constexpr uint32_t hide_show_key = 7;
+    //z, the default shout key
+    constexpr uint32_t shout_key = 44;
+
+    std::string make_custom_config(const uint32_t a_sections) {
+        std::mt19937 random(a_sections);
+        std::string out = "\xEF\xBB\xBF";
+        for (uint32_t i = 0; i < a_sections; ++i) {
+            const auto page = i / core::position_count;
+            const auto position = i % core::position_count;
+            //weapons, spells and potions, with a left hand entry now and then
+            const auto type = random() % 3 == 0 ? 5u : random() % 2;
+            fmt::format_to(std::back_inserter(out),
+                "[Page{0}Position{1}]\n"
+                "uPage = {0}\n"
+                "uPosition = {1}\n"
+                "uType = {2}\n"
+                "sSelectedItemForm = Skyrim.esm|{3:X}\n"
+                "uSlotAction = 0\n"
+                "uHandSelection = 1\n"
+                "iEffectActorValue = -1\n"
+                "uTypeLeft = {4}\n"
+                "sSelectedItemFormLeft = {5}\n"
+                "uSlotActionLeft = 0\n\n",
+                page,
+                position,
+                type,
+                0x12EB7 + i,
+                i % 5 == 0 ? 2 : 8,
+                i % 5 == 0 ? fmt::format("Skyrim.esm|{:X}", 0x1A4CC + i) : "");
+        }
+        return out;
+    }
+
+    void fill_inventory(stand_in::memory_inventory& a_inventory,
+        const uint32_t a_items,
+        const core::form_id a_first_form) {
+        std::mt19937 random(a_items);
+        std::uniform_int_distribution count(1, 12);
+        std::uniform_real_distribution amount(10.f, 400.f);
+        for (uint32_t i = 0; i < a_items; ++i) {
+            core::item_record item;
+            item.id = a_first_form + i;
+            item.count = count(random);
+            if (i % 4 == 0) {
+                item.potion_group = potion_groups[(i / 4) % potion_groups.size()];
+                item.restore_amount = amount(random);
+                item.dynamic = i % 16 == 0;
+            }
+            a_inventory.add(item);
+        }
+    }
+
+    void fill_key_table(core::key_table& a_table) {
+        using key_role = core::key_table::key_role;
+        a_table.clear();
+        a_table.add(position_keys[0], key_role::position_button | key_role::scroll, core::position_type::top);
+        a_table.add(position_keys[1], key_role::position_button, core::position_type::right);
+        a_table.add(position_keys[2],
+            key_role::position_button | key_role::scroll | key_role::utility,
+            core::position_type::bottom);
+        a_table.add(position_keys[3], key_role::position_button, core::position_type::left);
+        a_table.add(toggle_key, key_role::toggle);
+        a_table.add(hide_show_key, key_role::hide_show);
+        a_table.add(core::get_key_id(core::input_device::keyboard, shout_key), key_role::top_execute);
+        a_table.add(core::get_key_id(core::input_device::gamepad, core::gamepad_right_shoulder),
+            key_role::top_execute);
+    }
+
+    std::vector<key_event> make_key_burst(const uint32_t a_events) {
+        //w, a, s, d and the mouse buttons
+        constexpr std::array<uint32_t, 4> movement_keys = { 17, 30, 31, 32 };
+        std::mt19937 random(a_events);
+        std::vector<key_event> events;
+        events.reserve(a_events);
+        for (uint32_t i = 0; i < a_events; ++i) {
+            key_event event;
+            event.down = i % 2 == 0;
+            switch (i % 8) {
+                case 0:
+                    event.id_code = position_keys[random() % position_keys.size()];
+                    break;
+                case 4:
+                    event.device = core::input_device::gamepad;
+                    event.id_code = core::gamepad_right_shoulder;
+                    break;
+                case 6:
+                    event.device = core::input_device::mouse;
+                    event.id_code = static_cast<uint32_t>(random() % 2);
+                    break;
+                default:
+                    event.id_code = movement_keys[random() % movement_keys.size()];
+                    break;
+            }
+            events.push_back(event);
+        }
+        return events;
+    }
+
+    core::hud_snapshot make_snapshot() {
+        core::hud_snapshot snapshot;
+        for (uint32_t i = 0; i < core::position_count; ++i) {
+            auto& position = snapshot.positions.emplace_back();
+            position.position = static_cast<core::position_type>(i);
+            position.icon_type = i;
+            position.key = position_keys[i];
+            position.draw_setting.hud_image_scale_width = 0.23f;
+            position.draw_setting.hud_image_scale_height = 0.23f;
+            position.draw_setting.icon_scale_width = 0.1f;
+            position.draw_setting.icon_scale_height = 0.1f;
+            position.draw_setting.offset_slot_x = i % 2 == 1 ? (i == 1 ? 90.f : -90.f) : 0.f;
+            position.draw_setting.offset_slot_y = i % 2 == 0 ? (i == 0 ? -90.f : 90.f) : 0.f;
+            position.item_name_font_size = 20.f;
+            position.count_font_size = 20.f;
+            position.item_name = i % 2 == 0;
+            position.slot_name = position.item_name ? "Ebony Blade of the Inferno" : "";
+            position.slot_text = std::to_string(i * 7 + 1);
+        }
+        snapshot.ammo = true;
+        snapshot.ammo_count = "57";
+        snapshot.ammo_setting.image_scale_width = 0.1f;
+        snapshot.ammo_setting.image_scale_height = 0.1f;
+        snapshot.ammo_setting.offset_slot_x = 140.f;
+        return snapshot;
+    }
+}
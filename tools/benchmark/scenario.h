@@ -0,0 +1,30 @@
+#pragma once
+#include "core/hud_snapshot.h"
+#include "core/key_code.h"
+#include "core/key_table.h"
+#include "memory_inventory.h"
+#include <string>
+#include <vector>
+
+//synthetic data that looks like what the game hands the plugin, the same for every run so results can be compared
+namespace scenario {
+    //actor values of restore health, magicka and stamina, the groups the hud sorts potions into
+    constexpr std::array<uint32_t, 3> potion_groups = { 24, 25, 26 };
+
+    struct key_event {
+        core::input_device device = core::input_device::keyboard;
+        uint32_t id_code = 0;
+        bool down = false;
+    };
+
+    //a custom config with that many sections, spread over the four positions
+    std::string make_custom_config(uint32_t a_sections);
+    //every fourth item is a potion, the amounts are spread so the potion pick has something to choose from
+    void fill_inventory(stand_in::memory_inventory& a_inventory, uint32_t a_items, core::form_id a_first_form);
+    //the keys of the default mcm, bound like the plugin binds them
+    void fill_key_table(core::key_table& a_table);
+    //a quarter of the events are bound keys, the rest is movement and mouse look
+    std::vector<key_event> make_key_burst(uint32_t a_events);
+    //four positions with name and count text and the ammo slot, like the elden layout
+    core::hud_snapshot make_snapshot();
+}
@@ -0,0 +1,163 @@
+#include "core/config/page_config.h"
+#include <chrono>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <fstream>
+
+//reads the custom configs outside of the game, reports what is wrong with them and writes them in the form
+//the plugin loads them. in elden mode that is what rewrite_settings leaves, so it is not needed at runtime
+namespace tool {
+    using clock = std::chrono::steady_clock;
+    using core::ini_file;
+    using core::page_config;
+
+    constexpr std::string_view config_prefix = "LamasTinyHUD_Custom";
+    constexpr std::string_view config_ending = ".ini";
+
+    enum class exit_code : int { ok = 0, warnings = 1, errors = 2, usage = 3 };
+
+    struct options {
+        std::vector<std::filesystem::path> inputs;
+        std::filesystem::path output_directory;
+        page_config::config_mode mode = page_config::config_mode::default_mode;
+        bool in_place = false;
+        bool quiet = false;
+    };
+
+    static double get_ms(const clock::time_point a_start, const clock::time_point a_end) {
+        return std::chrono::duration<double, std::milli>(a_end - a_start).count();
+    }
+
+    static void print_usage() {
+        fmt::print(
+            "usage: config_compiler [--mode <default|elden>] [--output <dir>] [--in-place] [--quiet]\n"
+            "                       <file or directory>...\n"
+            "  checks LamasTinyHUD_Custom*.ini files, directories are searched for them\n"
+            "  --mode <mode>   the mode the hud runs in, elden gets consecutive pages. default is default\n"
+            "  --output <dir>  write the normalized config with the same name into dir\n"
+            "  --in-place      overwrite the input with the normalized config\n"
+            "  --quiet         only print errors and the summary\n"
+            "exit code 0 if all is fine, 1 for warnings, 2 for errors, 3 for wrong usage\n");
+    }
+
+    static bool is_config_file(const std::filesystem::path& a_path) {
+        const auto name = a_path.filename().string();
+        return name.starts_with(config_prefix) && name.ends_with(config_ending);
+    }
+
+    static bool parse_options(const int a_argc, char* a_argv[], options& a_options) {
+        for (auto i = 1; i < a_argc; ++i) {
+            const std::string_view arg = a_argv[i];
+            if (arg == "--mode" && i + 1 < a_argc) {
+                const std::string_view mode = a_argv[++i];
+                if (mode == "elden") {
+                    a_options.mode = page_config::config_mode::elden;
+                } else if (mode != "default") {
+                    return false;
+                }
+            } else if (arg == "--output" && i + 1 < a_argc) {
+                a_options.output_directory = a_argv[++i];
+            } else if (arg == "--in-place") {
+                a_options.in_place = true;
+            } else if (arg == "--quiet") {
+                a_options.quiet = true;
+            } else if (arg.starts_with("--")) {
+                return false;
+            } else if (std::filesystem::is_directory(arg)) {
+                for (const auto& file : std::filesystem::directory_iterator(arg)) {
+                    if (file.is_regular_file() && is_config_file(file.path())) {
+                        a_options.inputs.push_back(file.path());
+                    }
+                }
+            } else {
+                a_options.inputs.emplace_back(arg);
+            }
+        }
+        return !a_options.inputs.empty() && !(a_options.in_place && !a_options.output_directory.empty());
+    }
+
+    static exit_code process(const std::filesystem::path& a_path, const options& a_options) {
+        fmt::print("{}\n", a_path.string());
+
+        const auto start = clock::now();
+        ini_file file;
+        if (std::string error; !file.load(a_path, error)) {
+            fmt::print("  error: {}\n", error);
+            return exit_code::errors;
+        }
+        const auto parsed = clock::now();
+
+        page_config config(a_options.mode);
+        config.read(file);
+        config.validate();
+        const auto validated = clock::now();
+
+        for (const auto& [level, line, message] : config.get_issues()) {
+            if (a_options.quiet && level != page_config::severity::error) {
+                continue;
+            }
+            const auto* label = level == page_config::severity::error ? "error" : "warning";
+            if (line) {
+                fmt::print("  {}:{}: {}: {}\n", a_path.filename().string(), line, label, message);
+            } else {
+                fmt::print("  {}: {}: {}\n", a_path.filename().string(), label, message);
+            }
+        }
+
+        const auto changed = config.normalize();
+        const auto output = config.write();
+        const auto normalized = clock::now();
+
+        fmt::print("  {} bytes, {} lines, {} sections, pages per position {}, {} get a new page or name or are dropped\n",
+            file.size,
+            file.line_count,
+            config.get_entries().size(),
+            config.get_page_counts(),
+            changed);
+        fmt::print("  parse {:.3f}ms, validate {:.3f}ms, normalize and write {:.3f}ms, total {:.3f}ms\n",
+            get_ms(start, parsed),
+            get_ms(parsed, validated),
+            get_ms(validated, normalized),
+            get_ms(start, normalized));
+
+        if (config.has_errors()) {
+            if (a_options.in_place || !a_options.output_directory.empty()) {
+                fmt::print("  not written, fix the errors first\n");
+            }
+            return exit_code::errors;
+        }
+
+        std::filesystem::path target;
+        if (a_options.in_place) {
+            target = a_path;
+        } else if (!a_options.output_directory.empty()) {
+            std::filesystem::create_directories(a_options.output_directory);
+            target = a_options.output_directory / a_path.filename();
+        }
+        if (!target.empty()) {
+            std::ofstream out(target, std::ios::binary | std::ios::trunc);
+            out << output;
+            if (!out) {
+                fmt::print("  error: could not write {}\n", target.string());
+                return exit_code::errors;
+            }
+            fmt::print("  wrote {}\n", target.string());
+        }
+
+        return config.get_issues().empty() ? exit_code::ok : exit_code::warnings;
+    }
+}
+
+int main(const int a_argc, char* a_argv[]) {
+    tool::options options;
+    if (!tool::parse_options(a_argc, a_argv, options)) {
+        tool::print_usage();
+        return static_cast<int>(tool::exit_code::usage);
+    }
+
+    auto result = tool::exit_code::ok;
+    for (const auto& input : options.inputs) {
+        result = std::max(result, tool::process(input, options));
+    }
+    return static_cast<int>(result);
+}
@@ -0,0 +1,89 @@
+#include "core/item_counts.h"
+#include "memory_inventory.h"
+#include "test.h"
+
+namespace {
+    constexpr uint32_t health = 24;
+    constexpr float min_perfect = 0.8f;
+    constexpr float max_perfect = 1.2f;
+
+    //three health potions that restore 25, 50 and 100, the big one is a dynamic one with just one left
+    stand_in::memory_inventory make_inventory() {
+        stand_in::memory_inventory inventory;
+        inventory.add({ 0x10, 3, health, 25.f, false });
+        inventory.add({ 0x11, 2, health, 50.f, false });
+        inventory.add({ 0x12, 1, health, 100.f, true });
+        inventory.add({ 0x20, 5, core::no_potion_group, 0.f, false });
+        inventory.add({ 0x21, 0, core::no_potion_group, 0.f, false });
+        return inventory;
+    }
+}
+
+TEST_CASE(item_counts_build) {
+    core::item_counts counts;
+    CHECK(!counts.is_built());
+    counts.build(make_inventory());
+    CHECK(counts.is_built());
+    CHECK_EQ(counts.get_count(0x10), 3);
+    CHECK_EQ(counts.get_count(0x20), 5);
+    CHECK_EQ(counts.get_count(0x21), 0);
+    CHECK_EQ(counts.get_count(0x99), 0);
+    CHECK_EQ(counts.get_group_count(health), 6);
+    CHECK_EQ(counts.get_tracked_form_count(), 4u);
+    CHECK_EQ(counts.get_tracked_group_count(), 1u);
+}
+
+TEST_CASE(item_counts_apply_delta) {
+    core::item_counts counts;
+    counts.apply_delta({ 0x10, 5, health, 25.f, false });
+    CHECK_EQ(counts.get_count(0x10), 0);
+
+    counts.build(make_inventory());
+    counts.apply_delta({ 0x10, -1, health, 25.f, false });
+    counts.apply_delta({ 0x20, -10, core::no_potion_group, 0.f, false });
+    counts.apply_delta({ 0x30, 4, core::no_potion_group, 0.f, false });
+    CHECK_EQ(counts.get_count(0x10), 2);
+    CHECK_EQ(counts.get_count(0x20), 0);
+    CHECK_EQ(counts.get_count(0x30), 4);
+    CHECK_EQ(counts.get_group_count(health), 5);
+
+    counts.reset();
+    CHECK(!counts.is_built());
+    CHECK_EQ(counts.get_count(0x30), 0);
+}
+
+TEST_CASE(item_counts_fitting_potion) {
+    core::item_counts counts;
+    counts.build(make_inventory());
+
+    //inside the range
+    CHECK_EQ(counts.get_fitting_potion(health, 60.f, min_perfect, max_perfect, false), 0x11u);
+    CHECK_EQ(counts.get_fitting_potion(health, 90.f, min_perfect, max_perfect, false), 0x12u);
+    //nothing in range, the closest one still wins
+    CHECK_EQ(counts.get_fitting_potion(health, 300.f, min_perfect, max_perfect, false), 0x12u);
+    CHECK_EQ(counts.get_fitting_potion(health, 5.f, min_perfect, max_perfect, false), 0x10u);
+    //same distance on both sides, the bigger one wins
+    CHECK_EQ(counts.get_fitting_potion(health, 75.f, min_perfect, max_perfect, false), 0x12u);
+    //the last dynamic one is skipped, the next closest is taken
+    CHECK_EQ(counts.get_fitting_potion(health, 90.f, min_perfect, max_perfect, true), 0x11u);
+    CHECK_EQ(counts.get_fitting_potion(health + 1, 50.f, min_perfect, max_perfect, false), 0u);
+}
+
+TEST_CASE(item_counts_fitting_potion_follows_delta) {
+    core::item_counts counts;
+    counts.build(make_inventory());
+
+    //the 50 is used up, 25 is closer to 60 than 100
+    counts.apply_delta({ 0x11, -2, health, 50.f, false });
+    CHECK_EQ(counts.get_fitting_potion(health, 60.f, min_perfect, max_perfect, false), 0x10u);
+
+    //a new one that fits
+    counts.apply_delta({ 0x13, 1, health, 65.f, false });
+    CHECK_EQ(counts.get_fitting_potion(health, 60.f, min_perfect, max_perfect, false), 0x13u);
+
+    counts.apply_delta({ 0x10, -3, health, 25.f, false });
+    counts.apply_delta({ 0x12, -1, health, 100.f, true });
+    counts.apply_delta({ 0x13, -1, health, 65.f, false });
+    CHECK_EQ(counts.get_fitting_potion(health, 60.f, min_perfect, max_perfect, false), 0u);
+    CHECK_EQ(counts.get_group_count(health), 0);
+}
@@ -0,0 +1,39 @@
+#include "core/key_code.h"
+#include "core/key_table.h"
+#include "test.h"
+
+using core::input_device;
+
+TEST_CASE(key_code_devices) {
+    CHECK_EQ(core::get_key_id(input_device::keyboard, 0x1C), 0x1Cu);
+    CHECK_EQ(core::get_key_id(input_device::mouse, 0), core::key_mouse_offset);
+    CHECK_EQ(core::get_key_id(input_device::mouse, 9), core::key_mouse_offset + 9);
+    CHECK_EQ(core::get_key_id(input_device::other, 42), 42u);
+}
+
+TEST_CASE(key_code_gamepad) {
+    CHECK_EQ(core::get_key_id(input_device::gamepad, core::gamepad_up), core::key_gamepad_offset);
+    CHECK_EQ(core::get_key_id(input_device::gamepad, core::gamepad_a), core::key_gamepad_offset + 10);
+    CHECK_EQ(core::get_gamepad_index(core::gamepad_y), core::key_gamepad_offset + 13);
+    //the game reports the triggers as 9 and 10, not as a mask
+    CHECK_EQ(core::get_gamepad_index(core::gamepad_left_trigger), core::key_gamepad_offset + 14);
+    CHECK_EQ(core::get_gamepad_index(core::gamepad_right_trigger), core::key_total - 1);
+    CHECK_EQ(core::get_gamepad_index(0x0400), core::key_invalid);
+    CHECK_EQ(core::get_key_id(input_device::gamepad, 0), core::key_invalid);
+}
+
+TEST_CASE(key_code_table) {
+    core::key_table table;
+    const auto key = core::get_key_id(input_device::gamepad, core::gamepad_b);
+    table.add(key, core::key_table::position_button, core::position_type::left);
+    table.add(key, core::key_table::toggle);
+    table.add(core::key_invalid, core::key_table::scroll);
+
+    CHECK_EQ(table.get(key).roles, core::key_table::position_button | core::key_table::toggle);
+    CHECK(table.get(key).position == core::position_type::left);
+    CHECK_EQ(table.get(core::key_invalid).roles, core::key_table::none);
+    CHECK_EQ(table.get(0x1C).roles, core::key_table::none);
+
+    table.clear();
+    CHECK_EQ(table.get(key).roles, core::key_table::none);
+}
@@ -0,0 +1,61 @@
+#include "core/latency_histogram.h"
+#include "test.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+TEST_CASE(latency_histogram_empty) {
+    core::latency_histogram histogram;
+    CHECK_EQ(histogram.get_count(), 0u);
+    CHECK_EQ(histogram.get_percentile(0.5), 0u);
+}
+
+TEST_CASE(latency_histogram_small_values_exact) {
+    core::latency_histogram histogram;
+    for (uint64_t i = 0; i < 16; ++i) {
+        histogram.record(i);
+    }
+    CHECK_EQ(histogram.get_count(), 16u);
+    CHECK_EQ(histogram.get_max(), 15u);
+    CHECK_EQ(histogram.get_percentile(0.0), 0u);
+    CHECK_EQ(histogram.get_percentile(0.5), 7u);
+    CHECK_EQ(histogram.get_percentile(1.0), 15u);
+}
+
+TEST_CASE(latency_histogram_percentiles) {
+    core::latency_histogram histogram;
+    std::vector<uint64_t> values;
+    //spread over a few magnitudes, like microseconds from a frame to a few seconds
+    for (uint64_t i = 1; i <= 5000; ++i) {
+        values.push_back(i * i * 7 % 3000000 + 1);
+    }
+    for (const auto value : values) {
+        histogram.record(value);
+    }
+    std::ranges::sort(values);
+
+    for (const auto percentile : { 0.5, 0.9, 0.99, 0.999 }) {
+        const auto rank = static_cast<size_t>(std::ceil(percentile * static_cast<double>(values.size())));
+        const auto exact = values[rank - 1];
+        const auto reported = histogram.get_percentile(percentile);
+        //the upper end of a bucket that is at most 1/16 of the value wide
+        CHECK(reported >= exact);
+        CHECK(reported <= exact + exact / 16);
+    }
+    CHECK_EQ(histogram.get_percentile(1.0), values.back());
+    CHECK_EQ(histogram.get_max(), values.back());
+}
+
+TEST_CASE(latency_histogram_overflow_and_reset) {
+    core::latency_histogram histogram;
+    histogram.record(1);
+    histogram.record(uint64_t{ 1 } << 50);
+    CHECK_EQ(histogram.get_percentile(1.0), uint64_t{ 1 } << 50);
+    CHECK_EQ(histogram.get_percentile(0.5), 1u);
+
+    histogram.reset();
+    CHECK_EQ(histogram.get_count(), 0u);
+    CHECK_EQ(histogram.get_max(), 0u);
+    histogram.record(100);
+    CHECK_EQ(histogram.get_percentile(0.5), 100u);
+}
@@ -0,0 +1,39 @@
+#include "test.h"
+#include <fmt/format.h>
+
+//runs every test case, or the ones with the argument in their name. exit code 1 if any check failed
+namespace test {
+    static uint32_t failures = 0;
+
+    std::vector<test_case>& get_cases() {
+        static std::vector<test_case> cases;
+        return cases;
+    }
+
+    void report_failure(const std::string_view a_message, const std::string_view a_file, const int a_line) {
+        ++failures;
+        fmt::print("  {}:{}: failed: {}\n", a_file, a_line, a_message);
+    }
+}
+
+int main(const int a_argc, char* a_argv[]) {
+    const std::string_view filter = a_argc > 1 ? a_argv[1] : "";
+
+    uint32_t run = 0;
+    uint32_t failed = 0;
+    for (const auto& [name, function] : test::get_cases()) {
+        if (!filter.empty() && name.find(filter) == std::string_view::npos) {
+            continue;
+        }
+        const auto before = test::failures;
+        function();
+        ++run;
+        if (test::failures != before) {
+            ++failed;
+            fmt::print("{} failed\n", name);
+        }
+    }
+
+    fmt::print("{} of {} test cases passed\n", run - failed, run);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+#include "core/config/page_config.h"
+#include "test.h"
+#include <algorithm>
+
+using core::page_config;
+
+namespace {
+    constexpr std::string_view gapped = "[Page0Position0]\n"
+                                        "uPage = 0\nuPosition = 0\nuType = 0\nsSelectedItemForm = Skyrim.esm|12EB7\n"
+                                        "[Page4Position0]\n"
+                                        "uPage = 4\nuPosition = 0\nuType = 8\n"
+                                        "[Page2Position0]\n"
+                                        "uPage = 2\nuPosition = 0\nuType = 8\n"
+                                        "[Page1Position3]\n"
+                                        "uPage = 1\nuPosition = 3\nuType = 8\n";
+
+    constexpr std::string_view duplicated = "[Page0Position1]\n"
+                                            "uPage = 0\nuPosition = 1\nuType = 8\n"
+                                            "[page0position1]\n"
+                                            "uHandSelection = 0\n"
+                                            "[Other]\n"
+                                            "uPage = 0\nuPosition = 1\nuType = 0\nsSelectedItemForm = Skyrim.esm|1\n";
+
+    page_config read(const std::string_view a_content, const page_config::config_mode a_mode) {
+        core::ini_file file;
+        file.parse(a_content);
+        page_config config(a_mode);
+        config.read(file);
+        config.validate();
+        return config;
+    }
+
+    bool has_issue(const page_config& a_config, const std::string_view a_text) {
+        return std::ranges::any_of(a_config.get_issues(),
+            [&](const page_config::config_issue& a_issue) { return a_issue.message.contains(a_text); });
+    }
+}
+
+TEST_CASE(page_config_elden_normalize) {
+    auto config = read(gapped, page_config::config_mode::elden);
+    CHECK(!config.has_errors());
+    CHECK(has_issue(config, "position 0 is missing page(s) 1, 3"));
+    CHECK(has_issue(config, "position 3 is missing page(s) 0"));
+
+    CHECK_EQ(config.normalize(), 3u);
+    const auto& entries = config.get_entries();
+    CHECK_EQ(entries.size(), 4u);
+    CHECK_EQ(entries[0].section, "Page0Position0");
+    CHECK_EQ(entries[0].form, "Skyrim.esm|12EB7");
+    //the order of the pages stays, the gaps are gone
+    CHECK_EQ(entries[1].section, "Page0Position3");
+    CHECK_EQ(entries[2].section, "Page1Position0");
+    CHECK_EQ(entries[3].section, "Page2Position0");
+    CHECK_EQ(entries[3].line, 6u);
+    CHECK(config.get_page_counts() == std::vector<uint32_t>({ 3, 0, 0, 1 }));
+
+    //what got written reads back without anything to fix
+    auto again = read(config.write(), page_config::config_mode::elden);
+    CHECK(again.get_issues().empty());
+    CHECK_EQ(again.normalize(), 0u);
+}
+
+TEST_CASE(page_config_default_keeps_pages) {
+    auto config = read(gapped, page_config::config_mode::default_mode);
+    CHECK(config.get_issues().empty());
+    CHECK_EQ(config.normalize(), 0u);
+    const auto& entries = config.get_entries();
+    CHECK_EQ(entries.size(), 4u);
+    CHECK_EQ(entries[0].section, "Page0Position0");
+    CHECK_EQ(entries[1].section, "Page1Position3");
+    CHECK_EQ(entries[2].section, "Page2Position0");
+    CHECK_EQ(entries[3].section, "Page4Position0");
+}
+
+TEST_CASE(page_config_duplicates) {
+    auto elden = read(duplicated, page_config::config_mode::elden);
+    CHECK(has_issue(elden, "section page0position1 is already at line 1, they get merged"));
+    CHECK(has_issue(elden, "Other uses page 0, position 1 like Page0Position1, both are kept"));
+    //the merged section took the hand of the second one
+    CHECK_EQ(elden.get_entries().front().hand, 0u);
+    CHECK_EQ(elden.get_entries().size(), 2u);
+    elden.normalize();
+    CHECK_EQ(elden.get_entries().size(), 2u);
+    CHECK_EQ(elden.get_entries()[1].section, "Page1Position1");
+
+    auto mode = read(duplicated, page_config::config_mode::default_mode);
+    CHECK(has_issue(mode, "Other uses page 0, position 1 like Page0Position1, it replaces that one"));
+    CHECK_EQ(mode.normalize(), 2u);
+    //the later one is what the plugin loads
+    CHECK_EQ(mode.get_entries().size(), 1u);
+    CHECK_EQ(mode.get_entries().front().section, "Page0Position1");
+    CHECK_EQ(mode.get_entries().front().form, "Skyrim.esm|1");
+}
+
+TEST_CASE(page_config_errors) {
+    const auto config = read("[Page0Position7]\nuPage = 0\nuPosition = 7\nuType = abc\nsSelectedItemForm = nope\n",
+        page_config::config_mode::elden);
+    CHECK(config.has_errors());
+    CHECK(has_issue(config, "has position 7, there are just 4"));
+    CHECK(has_issue(config, "uType = abc is not a number"));
+    CHECK(has_issue(config, "has form nope, expected plugin|id"));
+}
@@ -0,0 +1,51 @@
+#include "core/page_cycle.h"
+#include "test.h"
+
+using core::position_type;
+
+TEST_CASE(page_cycle_next_page) {
+    core::page_cycle cycle;
+    CHECK_EQ(cycle.get_active_page(), 0u);
+    CHECK_EQ(cycle.get_next_page(4), 1u);
+    cycle.set_active_page(2);
+    CHECK_EQ(cycle.get_next_page(4), 3u);
+    cycle.set_active_page(3);
+    CHECK_EQ(cycle.get_next_page(4), 0u);
+    //the max page count got smaller than the active page
+    cycle.set_active_page(7);
+    CHECK_EQ(cycle.get_next_page(4), 0u);
+}
+
+TEST_CASE(page_cycle_per_position) {
+    core::page_cycle cycle;
+    CHECK_EQ(cycle.get_active_page_position(position_type::left), 0u);
+    //nothing set yet, the next one is the first
+    CHECK_EQ(cycle.get_next_page_position(position_type::left, 4), 0u);
+
+    cycle.set_active_page_position(1, position_type::left);
+    cycle.set_active_page_position(3, position_type::right);
+    CHECK_EQ(cycle.get_active_page_position(position_type::left), 1u);
+    CHECK_EQ(cycle.get_active_page_position(position_type::top), 0u);
+    CHECK_EQ(cycle.get_next_page_position(position_type::left, 4), 2u);
+    CHECK_EQ(cycle.get_next_page_position(position_type::right, 4), 0u);
+
+    //total is no position
+    cycle.set_active_page_position(2, position_type::total);
+    CHECK_EQ(cycle.get_active_page_position(position_type::total), 0u);
+    CHECK_EQ(cycle.get_next_page_position(position_type::total, 4), 0u);
+}
+
+TEST_CASE(page_cycle_next_non_empty) {
+    core::page_cycle cycle;
+    CHECK_EQ(cycle.get_highest_page_position(position_type::bottom), -1);
+    CHECK_EQ(cycle.get_next_non_empty_page_position(position_type::bottom, 4), 0u);
+
+    cycle.set_highest_page_position(1, position_type::bottom);
+    cycle.set_active_page_position(0, position_type::bottom);
+    CHECK_EQ(cycle.get_next_non_empty_page_position(position_type::bottom, 4), 1u);
+    cycle.set_active_page_position(1, position_type::bottom);
+    CHECK_EQ(cycle.get_next_non_empty_page_position(position_type::bottom, 4), 0u);
+
+    cycle.set_highest_page_position(3, position_type::total);
+    CHECK_EQ(cycle.get_highest_page_position(position_type::total), -1);
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <fmt/format.h>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//just enough of a test framework for the core, so the tools need nothing but fmt
+namespace test {
+    struct test_case {
+        std::string_view name;
+        void (*run)() = nullptr;
+    };
+
+    std::vector<test_case>& get_cases();
+    void report_failure(std::string_view a_message, std::string_view a_file, int a_line);
+
+    class registrar {
+    public:
+        registrar(const std::string_view a_name, void (*a_run)()) { get_cases().push_back({ a_name, a_run }); }
+    };
+
+    template <class T>
+    constexpr bool is_number_v = std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>;
+
+    template <class L, class R>
+    void check_equal(const L& a_left,
+        const R& a_right,
+        const std::string_view a_expression,
+        const std::string_view a_file,
+        const int a_line) {
+        //the counts are mixed signed and unsigned, compare the values and not the bits
+        bool equal;
+        if constexpr (is_number_v<L> && is_number_v<R>) {
+            equal = std::cmp_equal(a_left, a_right);
+        } else {
+            equal = a_left == a_right;
+        }
+        if (!equal) {
+            report_failure(fmt::format("{}, got {} and {}", a_expression, a_left, a_right), a_file, a_line);
+        }
+    }
+}
+
+#define TEST_CASE(a_name)                                             \
+    static void a_name();                                             \
+    static const test::registrar a_name##_registrar(#a_name, a_name); \
+    static void a_name()
+
+#define CHECK(a_expression) \
+    ((a_expression) ? void() : test::report_failure(#a_expression, __FILE__, __LINE__))
+
+#define CHECK_EQ(a_left, a_right) test::check_equal((a_left), (a_right), #a_left " == " #a_right, __FILE__, __LINE__)
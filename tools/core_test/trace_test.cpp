@@ -0,0 +1,137 @@
+#include "core/trace.h"
+#include "test.h"
+
+namespace {
+    std::vector<core::trace_event> make_events() {
+        std::vector<core::trace_event> events;
+
+        core::trace_event key;
+        key.type = core::trace_event_type::key;
+        key.time = 10;
+        key.device = core::input_device::gamepad;
+        key.id_code = core::gamepad_a;
+        key.state = core::key_state::up;
+        events.push_back(key);
+
+        core::trace_event potion;
+        potion.type = core::trace_event_type::inventory;
+        potion.time = 1000000;
+        potion.item = { 0xFF000812, -3, 24, 87.5f, true };
+        events.push_back(potion);
+
+        core::trace_event item;
+        item.type = core::trace_event_type::inventory;
+        item.time = 1000000;
+        item.item = { 0x12EB7, 1, core::no_potion_group, 0.f, false };
+        events.push_back(item);
+
+        core::trace_event equip;
+        equip.type = core::trace_event_type::equip;
+        equip.time = 1000250;
+        equip.form = 0x12EB7;
+        equip.equipped = true;
+        events.push_back(equip);
+
+        core::trace_event menu;
+        menu.type = core::trace_event_type::menu;
+        menu.time = 5000000000;
+        menu.menu_name = "InventoryMenu";
+        menu.opening = true;
+        events.push_back(menu);
+
+        core::trace_event binding;
+        binding.type = core::trace_event_type::binding;
+        binding.time = 5000000001;
+        binding.key = core::key_gamepad_offset + 10;
+        binding.roles = 5;
+        binding.position = core::position_type::bottom;
+        events.push_back(binding);
+        return events;
+    }
+
+    std::vector<uint8_t> write(const std::vector<core::trace_event>& a_events) {
+        std::vector<uint8_t> out;
+        core::trace_writer::write_header(out);
+        core::trace_writer writer;
+        for (const auto& event : a_events) {
+            writer.write(event, out);
+        }
+        return out;
+    }
+}
+
+TEST_CASE(trace_round_trip) {
+    const auto events = make_events();
+    const auto data = write(events);
+
+    core::trace_reader reader(data);
+    std::string error;
+    CHECK(reader.read_header(error));
+
+    core::trace_event read;
+    for (const auto& expected : events) {
+        CHECK(reader.next(read));
+        CHECK(read.type == expected.type);
+        CHECK_EQ(read.time, expected.time);
+        switch (expected.type) {
+            case core::trace_event_type::key:
+                CHECK(read.device == expected.device);
+                CHECK_EQ(read.id_code, expected.id_code);
+                CHECK(read.state == expected.state);
+                break;
+            case core::trace_event_type::inventory:
+                CHECK_EQ(read.item.id, expected.item.id);
+                CHECK_EQ(read.item.count, expected.item.count);
+                CHECK_EQ(read.item.potion_group, expected.item.potion_group);
+                CHECK_EQ(read.item.restore_amount, expected.item.restore_amount);
+                CHECK_EQ(read.item.dynamic, expected.item.dynamic);
+                break;
+            case core::trace_event_type::equip:
+                CHECK_EQ(read.form, expected.form);
+                CHECK_EQ(read.equipped, expected.equipped);
+                break;
+            case core::trace_event_type::menu:
+                CHECK_EQ(read.menu_name, expected.menu_name);
+                CHECK_EQ(read.opening, expected.opening);
+                break;
+            case core::trace_event_type::binding:
+                CHECK_EQ(read.key, expected.key);
+                CHECK_EQ(read.roles, expected.roles);
+                CHECK(read.position == expected.position);
+                break;
+        }
+    }
+    CHECK(!reader.next(read));
+    CHECK(!reader.failed());
+}
+
+TEST_CASE(trace_cut_off) {
+    auto data = write(make_events());
+    //the binding is gone and the menu name is cut, everything before it still reads
+    data.resize(data.size() - 8);
+
+    core::trace_reader reader(data);
+    std::string error;
+    CHECK(reader.read_header(error));
+    core::trace_event read;
+    auto count = 0;
+    while (reader.next(read)) {
+        ++count;
+    }
+    CHECK_EQ(count, 4);
+    CHECK(reader.failed());
+}
+
+TEST_CASE(trace_header) {
+    std::string error;
+    const std::vector<uint8_t> garbage = { 'n', 'o', 'p', 'e', 1 };
+    core::trace_reader not_a_trace(garbage);
+    CHECK(!not_a_trace.read_header(error));
+    CHECK_EQ(error, "not a trace file");
+
+    auto data = write({});
+    data.back() = core::trace_writer::version + 1;
+    core::trace_reader newer(data);
+    CHECK(!newer.read_header(error));
+    CHECK_EQ(error, "trace version 2 is not supported");
+}
@@ -0,0 +1,63 @@
+#include "counting_render_target.h"
+#include <cstring>
+
+namespace stand_in {
+    void counting_render_target::draw_slot(const float a_x,
+        const float a_y,
+        const float a_scale_x,
+        const float a_scale_y,
+        const float a_offset_x,
+        const float a_offset_y,
+        const uint32_t a_modify,
+        const uint32_t a_alpha) {
+        ++counts_.slots;
+        if (a_alpha != 0) {
+            counts_.checksum +=
+                a_x + a_offset_x + a_y + a_offset_y + a_scale_x * a_scale_y + static_cast<float>(a_modify);
+        }
+    }
+
+    void counting_render_target::draw_icon(const float a_x,
+        const float a_y,
+        const float a_scale_x,
+        const float a_scale_y,
+        const float a_offset_x,
+        const float a_offset_y,
+        const uint32_t a_icon_type,
+        const uint32_t a_alpha) {
+        ++counts_.icons;
+        if (a_alpha != 0) {
+            counts_.checksum +=
+                a_x + a_offset_x + a_y + a_offset_y + a_scale_x * a_scale_y + static_cast<float>(a_icon_type);
+        }
+    }
+
+    void counting_render_target::draw_text(const float a_x,
+        const float a_y,
+        const float a_offset_x,
+        const float a_offset_y,
+        const float a_offset_extra_x,
+        const float a_offset_extra_y,
+        const char* a_text,
+        const uint32_t a_alpha,
+        const uint32_t a_red,
+        const uint32_t a_green,
+        const uint32_t a_blue,
+        const float a_font_size,
+        const bool a_center_text,
+        const bool a_deduct_text_x,
+        const bool a_deduct_text_y,
+        const bool a_add_text_x,
+        const bool a_add_text_y) {
+        ++counts_.texts;
+        if (!a_text || a_alpha == 0) {
+            return;
+        }
+        counts_.text_bytes += std::strlen(a_text);
+        const auto flags = static_cast<uint32_t>(a_center_text) + static_cast<uint32_t>(a_deduct_text_x) +
+                           static_cast<uint32_t>(a_deduct_text_y) + static_cast<uint32_t>(a_add_text_x) +
+                           static_cast<uint32_t>(a_add_text_y);
+        counts_.checksum += a_x + a_offset_x + a_offset_extra_x + a_y + a_offset_y + a_offset_extra_y + a_font_size +
+                            static_cast<float>(a_red + a_green + a_blue + flags);
+    }
+}
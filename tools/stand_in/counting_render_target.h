@@ -0,0 +1,57 @@
+#pragma once
+#include "core/render_target.h"
+#include <cstddef>
+
+namespace stand_in {
+    //draws nothing, counts the calls and what would have gone to the gpu so the work can not be optimized away
+    class counting_render_target final : public core::render_target {
+    public:
+        struct draw_counts {
+            size_t slots = 0;
+            size_t icons = 0;
+            size_t texts = 0;
+            size_t text_bytes = 0;
+            float checksum = 0.f;
+        };
+
+        [[nodiscard]] const draw_counts& get_counts() const { return counts_; }
+        void reset() { counts_ = {}; }
+
+        void draw_slot(float a_x,
+            float a_y,
+            float a_scale_x,
+            float a_scale_y,
+            float a_offset_x,
+            float a_offset_y,
+            uint32_t a_modify,
+            uint32_t a_alpha) override;
+        void draw_icon(float a_x,
+            float a_y,
+            float a_scale_x,
+            float a_scale_y,
+            float a_offset_x,
+            float a_offset_y,
+            uint32_t a_icon_type,
+            uint32_t a_alpha) override;
+        void draw_text(float a_x,
+            float a_y,
+            float a_offset_x,
+            float a_offset_y,
+            float a_offset_extra_x,
+            float a_offset_extra_y,
+            const char* a_text,
+            uint32_t a_alpha,
+            uint32_t a_red,
+            uint32_t a_green,
+            uint32_t a_blue,
+            float a_font_size,
+            bool a_center_text,
+            bool a_deduct_text_x,
+            bool a_deduct_text_y,
+            bool a_add_text_x,
+            bool a_add_text_y) override;
+
+    private:
+        draw_counts counts_;
+    };
+}
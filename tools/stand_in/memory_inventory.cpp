@@ -0,0 +1,30 @@
+#include "memory_inventory.h"
+#include <algorithm>
+
+namespace stand_in {
+    void memory_inventory::add(const core::item_record& a_item) {
+        if (const auto it = std::ranges::find(items_, a_item.id, &core::item_record::id); it != items_.end()) {
+            it->count += a_item.count;
+            return;
+        }
+        items_.push_back(a_item);
+    }
+
+    int32_t memory_inventory::change(const core::form_id a_form, const int32_t a_count) {
+        const auto it = std::ranges::find(items_, a_form, &core::item_record::id);
+        if (it == items_.end()) {
+            return 0;
+        }
+        const auto before = it->count;
+        it->count = std::max(it->count + a_count, 0);
+        return it->count - before;
+    }
+
+    void memory_inventory::for_each_item(const std::function<void(const core::item_record&)>& a_visit) const {
+        for (const auto& item : items_) {
+            if (item.count > 0) {
+                a_visit(item);
+            }
+        }
+    }
+}
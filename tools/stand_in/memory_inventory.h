@@ -0,0 +1,20 @@
+#pragma once
+#include "core/inventory_source.h"
+#include <vector>
+
+namespace stand_in {
+    //an inventory that is just a list, for running the core without the game
+    class memory_inventory final : public core::inventory_source {
+    public:
+        void add(const core::item_record& a_item);
+        //changes the count of an item that is there already, returns the change that really happened
+        int32_t change(core::form_id a_form, int32_t a_count);
+        void clear() { items_.clear(); }
+        [[nodiscard]] const std::vector<core::item_record>& get_items() const { return items_; }
+
+        void for_each_item(const std::function<void(const core::item_record&)>& a_visit) const override;
+
+    private:
+        std::vector<core::item_record> items_;
+    };
+}
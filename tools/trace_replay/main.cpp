@@ -0,0 +1,287 @@
+#include "core/item_counts.h"
+#include "core/key_table.h"
+#include "core/page_cycle.h"
+#include "core/trace.h"
+#include "memory_inventory.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <new>
+#include <unordered_set>
+
+//every allocation of the process goes through here, so the replay can tell what an event costs on the heap
+static std::atomic<size_t> allocation_count = 0;
+static std::atomic<size_t> allocation_bytes = 0;
+
+void* operator new(const std::size_t a_size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(a_size, std::memory_order_relaxed);
+    if (auto* memory = std::malloc(a_size ? a_size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* a_memory) noexcept { std::free(a_memory); }
+void operator delete(void* a_memory, std::size_t) noexcept { std::free(a_memory); }
+
+//reads a trace and feeds it to the core the way the plugin would have, then reports how long each kind of event
+//took and how much it allocated. the game side, equipping and drawing, is not part of it
+namespace tool {
+    using clock = std::chrono::steady_clock;
+    using core::trace_event;
+    using core::trace_event_type;
+
+    enum class exit_code : int { ok = 0, errors = 2, usage = 3 };
+
+    //the key manager leaves input alone while one of those is open
+    constexpr std::array<std::string_view, 4> relevant_menus = { "InventoryMenu",
+        "MagicMenu",
+        "FavoritesMenu",
+        "Console" };
+
+    struct options {
+        std::filesystem::path input;
+        uint32_t page_count = 3;
+        bool elden = true;
+    };
+
+    struct event_stats {
+        std::vector<uint64_t> durations;
+        size_t allocations = 0;
+        size_t allocated_bytes = 0;
+    };
+
+    struct replay_state {
+        core::key_table table;
+        core::page_cycle cycle;
+        core::item_counts counts;
+        std::unordered_set<std::string> open_menus;
+        std::unordered_set<core::form_id> equipped;
+        bool last_was_binding = false;
+        size_t keys_handled = 0;
+        size_t keys_in_menu = 0;
+        size_t page_changes = 0;
+    };
+
+    static void print_usage() {
+        fmt::print(
+            "usage: trace_replay [--pages <n>] [--default] <trace file>\n"
+            "  replays LamasTinyHUD.trace through the core and reports the cost per event type\n"
+            "  --pages <n>  pages set per position, 3 if not given\n"
+            "  --default    cycle pages like the default mode, the toggle key moves all positions\n"
+            "exit code 0 if the trace was read completely, 2 if it is broken, 3 for wrong usage\n");
+    }
+
+    static bool parse_options(const int a_argc, char* a_argv[], options& a_options) {
+        for (auto i = 1; i < a_argc; ++i) {
+            const std::string_view arg = a_argv[i];
+            if (arg == "--pages" && i + 1 < a_argc) {
+                a_options.page_count = static_cast<uint32_t>(std::max(1, std::atoi(a_argv[++i])));
+            } else if (arg == "--default") {
+                a_options.elden = false;
+            } else if (arg.starts_with("--") || !a_options.input.empty()) {
+                return false;
+            } else {
+                a_options.input = arg;
+            }
+        }
+        return !a_options.input.empty();
+    }
+
+    static std::string_view get_name(const trace_event_type a_type) {
+        switch (a_type) {
+            case trace_event_type::key:
+                return "key";
+            case trace_event_type::inventory:
+                return "inventory";
+            case trace_event_type::equip:
+                return "equip";
+            case trace_event_type::menu:
+                return "menu";
+            case trace_event_type::binding:
+                return "binding";
+        }
+        return "unknown";
+    }
+
+    static void handle_key(const trace_event& a_event, const options& a_options, replay_state& a_state) {
+        if (std::ranges::any_of(relevant_menus, [&a_state](const std::string_view a_menu) {
+                return a_state.open_menus.contains(std::string(a_menu));
+            })) {
+            ++a_state.keys_in_menu;
+            return;
+        }
+
+        const auto key = core::get_key_id(a_event.device, a_event.id_code);
+        const auto& dispatch = a_state.table.get(key);
+        if (dispatch.roles == core::key_table::none || a_event.state != core::key_state::down) {
+            return;
+        }
+        ++a_state.keys_handled;
+
+        auto& cycle = a_state.cycle;
+        if (a_options.elden && (dispatch.roles & core::key_table::position_button) != 0) {
+            cycle.set_active_page_position(
+                cycle.get_next_non_empty_page_position(dispatch.position, a_options.page_count),
+                dispatch.position);
+            ++a_state.page_changes;
+        } else if (!a_options.elden && (dispatch.roles & core::key_table::toggle) != 0) {
+            cycle.set_active_page(cycle.get_next_page(a_options.page_count));
+            ++a_state.page_changes;
+        }
+    }
+
+    static void handle_event(const trace_event& a_event, const options& a_options, replay_state& a_state) {
+        const auto is_binding = a_event.type == trace_event_type::binding;
+        //a binding after anything else starts a new table, the plugin writes it whole each time it is built
+        if (is_binding && !a_state.last_was_binding) {
+            a_state.table.clear();
+        }
+        a_state.last_was_binding = is_binding;
+
+        switch (a_event.type) {
+            case trace_event_type::key:
+                handle_key(a_event, a_options, a_state);
+                break;
+            case trace_event_type::inventory:
+                a_state.counts.apply_delta(a_event.item);
+                if (a_event.item.potion_group != core::no_potion_group) {
+                    //a slot with the group shows the sum and the potion it would take
+                    static_cast<void>(a_state.counts.get_group_count(a_event.item.potion_group));
+                    static_cast<void>(
+                        a_state.counts.get_fitting_potion(a_event.item.potion_group, 100.f, 0.f, 0.f, false));
+                }
+                break;
+            case trace_event_type::equip:
+                if (a_event.equipped) {
+                    a_state.equipped.insert(a_event.form);
+                } else {
+                    a_state.equipped.erase(a_event.form);
+                }
+                break;
+            case trace_event_type::menu:
+                if (a_event.opening) {
+                    a_state.open_menus.insert(a_event.menu_name);
+                } else {
+                    a_state.open_menus.erase(a_event.menu_name);
+                }
+                break;
+            case trace_event_type::binding:
+                a_state.table.add(a_event.key, a_event.roles, a_event.position);
+                break;
+        }
+    }
+
+    static uint64_t get_percentile(const std::vector<uint64_t>& a_sorted, const double a_percentile) {
+        if (a_sorted.empty()) {
+            return 0;
+        }
+        const auto index = static_cast<size_t>(a_percentile * static_cast<double>(a_sorted.size() - 1));
+        return a_sorted[index];
+    }
+
+    static exit_code run(const options& a_options) {
+        std::ifstream file(a_options.input, std::ios::binary);
+        if (!file) {
+            fmt::print("error: can not open {}\n", a_options.input.string());
+            return exit_code::errors;
+        }
+        const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        core::trace_reader reader(data);
+        if (std::string error; !reader.read_header(error)) {
+            fmt::print("error: {}\n", error);
+            return exit_code::errors;
+        }
+
+        //read it all first, so the replay measures the core and not the parsing
+        std::vector<trace_event> events;
+        for (trace_event event; reader.next(event);) {
+            events.push_back(event);
+        }
+        if (reader.failed()) {
+            fmt::print("warning: the trace is cut off after {} events\n", events.size());
+        }
+
+        replay_state state;
+        for (auto position = 0; position < static_cast<int>(core::position_count); ++position) {
+            state.cycle.set_highest_page_position(static_cast<int>(a_options.page_count) - 1,
+                static_cast<core::position_type>(position));
+        }
+        //there is no inventory in the trace, only the changes to it, so the counts start empty
+        state.counts.build(stand_in::memory_inventory());
+
+        std::array<event_stats, 5> stats;
+        for (auto& stat : stats) {
+            stat.durations.reserve(events.size());
+        }
+
+        const auto start = clock::now();
+        for (const auto& event : events) {
+            auto& stat = stats[static_cast<size_t>(event.type)];
+            const auto allocations = allocation_count.load(std::memory_order_relaxed);
+            const auto bytes = allocation_bytes.load(std::memory_order_relaxed);
+            const auto event_start = clock::now();
+            handle_event(event, a_options, state);
+            const auto event_end = clock::now();
+            stat.durations.push_back(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(event_end - event_start).count()));
+            stat.allocations += allocation_count.load(std::memory_order_relaxed) - allocations;
+            stat.allocated_bytes += allocation_bytes.load(std::memory_order_relaxed) - bytes;
+        }
+        const auto replay_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        const auto recorded_s = events.empty() ? 0.0 : static_cast<double>(events.back().time) / 1000000.0;
+        fmt::print("{}: {} events, {} bytes, {:.1f}s recorded, replayed in {:.2f}ms\n",
+            a_options.input.string(),
+            events.size(),
+            data.size(),
+            recorded_s,
+            replay_ms);
+        fmt::print("{:<10} {:>8} {:>10} {:>10} {:>10} {:>8} {:>10}\n",
+            "event",
+            "count",
+            "p50 ns",
+            "p99 ns",
+            "max ns",
+            "allocs",
+            "bytes");
+        for (size_t i = 0; i < stats.size(); ++i) {
+            auto& [durations, allocations, allocated_bytes] = stats[i];
+            if (durations.empty()) {
+                continue;
+            }
+            std::ranges::sort(durations);
+            fmt::print("{:<10} {:>8} {:>10} {:>10} {:>10} {:>8} {:>10}\n",
+                get_name(static_cast<trace_event_type>(i)),
+                durations.size(),
+                get_percentile(durations, 0.5),
+                get_percentile(durations, 0.99),
+                durations.back(),
+                allocations,
+                allocated_bytes);
+        }
+        fmt::print("keys handled {}, ignored in menus {}, page changes {}, tracked forms {}, equipped at the end {}\n",
+            state.keys_handled,
+            state.keys_in_menu,
+            state.page_changes,
+            state.counts.get_tracked_form_count(),
+            state.equipped.size());
+
+        return reader.failed() ? exit_code::errors : exit_code::ok;
+    }
+}
+
+int main(const int a_argc, char* a_argv[]) {
+    tool::options options;
+    if (!tool::parse_options(a_argc, a_argv, options)) {
+        tool::print_usage();
+        return static_cast<int>(tool::exit_code::usage);
+    }
+    return static_cast<int>(tool::run(options));
+}